@@ -1444,6 +1444,26 @@ RLM_API realm_object_t* realm_object_create_with_primary_key(realm_t*, realm_cla
 RLM_API realm_object_t* realm_object_get_or_create_with_primary_key(realm_t*, realm_class_key_t, realm_value_t pk,
                                                                     bool* did_create);
 
+/**
+ * Create or update many objects in a class with a primary key.
+ *
+ * The values of object `i` are `values[i * num_properties]` to
+ * `values[(i + 1) * num_properties - 1]`, in the order of @a properties. One
+ * of the properties must be the primary key, and none of them may be a
+ * collection. Objects which don't exist are created. If @a update is true,
+ * existing objects are updated, and only values which differ from the stored
+ * values are written. If @a update is false, nothing is written if an object
+ * with one of the primary keys already exists or a primary key is given more
+ * than once.
+ *
+ * @param out_objects If non-NULL, an array of length @a num_objects which
+ *                    receives the objects. Each must be freed with realm_release().
+ * @return True if no exception occurred.
+ */
+RLM_API bool realm_object_create_many(realm_t*, realm_class_key_t, size_t num_objects,
+                                      const realm_property_key_t* properties, size_t num_properties,
+                                      const realm_value_t* values, bool update, realm_object_t** out_objects);
+
 /**
  * Delete a realm object.
  *
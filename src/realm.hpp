@@ -22,11 +22,14 @@
 #include <realm/history.hpp>
 #include <realm/transaction.hpp>
 #include <realm/obj.hpp>
+#include <realm/blob.hpp>
 #include <realm/list.hpp>
 #include <realm/set.hpp>
 #include <realm/dictionary.hpp>
 #include <realm/table_view.hpp>
 #include <realm/query.hpp>
+#include <realm/group_by.hpp>
+#include <realm/query_cache.hpp>
 #include <realm/query_engine.hpp>
 #include <realm/query_expression.hpp>
 
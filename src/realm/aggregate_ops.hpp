@@ -134,6 +134,12 @@ public:
 };
 
 
+// Decimal values are summed through Decimal128::Accumulator, which avoids
+// calling into the decimal library for every value
+template <typename T>
+using SumAccumulatorType =
+    typename std::conditional<std::is_same_v<T, Decimal128>, Decimal128::Accumulator, ColumnSumType<T>>::type;
+
 template <typename T>
 class Sum {
 public:
@@ -152,6 +158,13 @@ public:
             ++m_count;
             return true;
         }
+        else if constexpr (std::is_same_v<T, Decimal128>) {
+            if (valid_for_agg(value)) {
+                m_result.add(value);
+                ++m_count;
+                return true;
+            }
+        }
         else {
             if (valid_for_agg(value)) {
                 m_result += value;
@@ -184,7 +197,12 @@ public:
     }
     ResultType result() const
     {
-        return m_result;
+        if constexpr (std::is_same_v<T, Decimal128>) {
+            return m_result.result();
+        }
+        else {
+            return m_result;
+        }
     }
     size_t items_counted() const
     {
@@ -196,7 +214,7 @@ public:
     }
 
 private:
-    ResultType m_result = {};
+    SumAccumulatorType<T> m_result = {};
     size_t m_count = 0;
 };
 
@@ -213,6 +231,13 @@ public:
                 return true;
             }
         }
+        else if constexpr (std::is_same_v<T, Decimal128>) {
+            if (valid_for_agg(value)) {
+                m_count++;
+                m_result.add(value);
+                return true;
+            }
+        }
         else {
             if (valid_for_agg(value)) {
                 m_count++;
@@ -246,7 +271,12 @@ public:
     ResultType result() const
     {
         REALM_ASSERT_EX(m_count > 0, m_count);
-        return m_result / m_count;
+        if constexpr (std::is_same_v<T, Decimal128>) {
+            return m_result.result() / m_count;
+        }
+        else {
+            return m_result / m_count;
+        }
     }
     static const char* description()
     {
@@ -259,7 +289,7 @@ public:
 
 private:
     size_t m_count = 0;
-    ResultType m_result = {};
+    typename std::conditional<std::is_same_v<T, Decimal128>, Decimal128::Accumulator, ResultType>::type m_result = {};
 };
 
 } // namespace realm::aggregate_operations
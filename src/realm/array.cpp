@@ -24,6 +24,7 @@
 #include <realm/query_conditions.hpp>
 #include <realm/array_integer.hpp>
 #include <realm/array_key.hpp>
+#include <realm/obj_key_set.hpp>
 #include <realm/impl/array_writer.hpp>
 
 #include <array>
@@ -1332,6 +1333,26 @@ bool QueryStateFindAll<std::vector<ObjKey>>::match(size_t index) noexcept
     return (m_limit > m_match_count);
 }
 
+template <>
+bool QueryStateFindAll<ObjKeySet>::match(size_t index, Mixed) noexcept
+{
+    ++m_match_count;
+    int64_t key_value = (m_key_values ? m_key_values->get(index) : index) + m_key_offset;
+    m_keys.add(ObjKey(key_value));
+
+    return (m_limit > m_match_count);
+}
+
+template <>
+bool QueryStateFindAll<ObjKeySet>::match(size_t index) noexcept
+{
+    ++m_match_count;
+    int64_t key_value = (m_key_values ? m_key_values->get(index) : index) + m_key_offset;
+    m_keys.add(ObjKey(key_value));
+
+    return (m_limit > m_match_count);
+}
+
 template <>
 bool QueryStateFindAll<IntegerColumn>::match(size_t index, Mixed) noexcept
 {
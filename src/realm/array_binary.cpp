@@ -91,6 +91,29 @@ void ArrayBinary::set(size_t ndx, BinaryData value)
     }
 }
 
+void ArrayBinary::replace(size_t ndx, size_t begin, size_t end, BinaryData value)
+{
+    BinaryData old_value = get(ndx);
+    REALM_ASSERT_3(begin, <=, end);
+    REALM_ASSERT_3(end, <=, old_value.size());
+    size_t new_size = old_value.size() - (end - begin) + value.size();
+    if (!old_value.is_null() && upgrade_leaf(new_size)) {
+        static_cast<ArrayBigBlobs*>(m_arr)->replace(ndx, begin, end, value);
+        return;
+    }
+
+    // Small and null values are simply rebuilt
+    std::string new_value;
+    new_value.reserve(new_size);
+    if (!old_value.is_null())
+        new_value.append(old_value.data(), begin);
+    if (value.size())
+        new_value.append(value.data(), value.size());
+    if (!old_value.is_null())
+        new_value.append(old_value.data() + end, old_value.size() - end);
+    set(ndx, BinaryData(new_value.data(), new_value.size()));
+}
+
 void ArrayBinary::insert(size_t ndx, BinaryData value)
 {
     bool is_big = upgrade_leaf(value.size());
@@ -63,6 +63,9 @@ public:
 
     void add(BinaryData value);
     void set(size_t ndx, BinaryData value);
+    /// Replace the bytes [begin, end) of the value at `ndx` with `value`. For
+    /// large values only the affected part of the value is written.
+    void replace(size_t ndx, size_t begin, size_t end, BinaryData value);
     void set_null(size_t ndx)
     {
         set(ndx, BinaryData{});
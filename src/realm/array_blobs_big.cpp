@@ -102,6 +102,40 @@ void ArrayBigBlobs::set(size_t ndx, BinaryData value, bool add_zero_term)
 }
 
 
+void ArrayBigBlobs::replace(size_t ndx, size_t begin, size_t end, BinaryData value)
+{
+    REALM_ASSERT_3(ndx, <, size());
+    REALM_ASSERT_7(value.size(), ==, 0, ||, value.data(), !=, 0);
+
+    ref_type ref = get_as_ref(ndx);
+    if (ref == 0) {
+        REALM_ASSERT(begin == 0 && end == 0);
+        set(ndx, value.data() ? value : BinaryData("", 0));
+        return;
+    }
+
+    char* header = m_alloc.translate(ref);
+    if (Array::get_context_flag_from_header(header)) {
+        // Split blobs only support appending
+        Array arr(m_alloc);
+        arr.init_from_mem(MemRef(header, ref, m_alloc));
+        arr.set_parent(this, ndx);
+        REALM_ASSERT(begin == end && end == arr.blob_size());
+        ref_type new_ref = arr.blob_replace(begin, end, value.data(), value.size(), false); // Throws
+        if (new_ref != ref)
+            Array::set_as_ref(ndx, new_ref);
+        return;
+    }
+
+    ArrayBlob blob(m_alloc);
+    blob.init_from_mem(MemRef(header, ref, m_alloc));
+    blob.set_parent(this, ndx);
+    ref_type new_ref = blob.replace(begin, end, value.data(), value.size()); // Throws
+    if (new_ref != ref)
+        Array::set_as_ref(ndx, new_ref);
+}
+
+
 void ArrayBigBlobs::insert(size_t ndx, BinaryData value, bool add_zero_term)
 {
     REALM_ASSERT_3(ndx, <=, size());
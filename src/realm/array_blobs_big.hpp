@@ -38,6 +38,9 @@ public:
     bool is_null(size_t ndx) const;
     BinaryData get_at(size_t ndx, size_t& pos) const noexcept;
     void set(size_t ndx, BinaryData value, bool add_zero_term = false);
+    /// Replace the bytes [begin, end) of the blob at `ndx` with `value`
+    /// without rewriting the rest of the blob.
+    void replace(size_t ndx, size_t begin, size_t end, BinaryData value);
     void add(BinaryData value, bool add_zero_term = false);
     void insert(size_t ndx, BinaryData value, bool add_zero_term = false);
     void erase(size_t ndx);
@@ -18,6 +18,8 @@
 
 #include <realm/array_mixed.hpp>
 #include <realm/array_basic.hpp>
+#include <realm/array_direct.hpp>
+#include <realm/query_conditions.hpp>
 
 using namespace realm;
 
@@ -272,17 +274,79 @@ size_t ArrayMixed::find_first(Mixed value, size_t begin, size_t end) const noexc
     if (value.is_null()) {
         return m_composite.find_first(0, begin, end);
     }
-    DataType type = value.get_type();
+    return find_first<Equal>(value, begin, end);
+}
+
+template <class Cond>
+size_t ArrayMixed::find_first(Mixed target, size_t begin, size_t end) const noexcept
+{
     if (end == realm::npos)
         end = size();
+    if (begin >= end)
+        return realm::npos;
+
+    // Decide once per type tag what to do with the elements carrying it. Values of a type that is not
+    // comparable with the target never match, except for NotEqual where they always do.
+    constexpr bool incomparable_matches = std::is_same_v<Cond, NotEqual>;
+    TagAction actions[s_data_type_mask + 1];
+    actions[0] = Cond()(QueryValue(Mixed()), QueryValue(target)) ? tag_accept : tag_reject;
+    for (int64_t tag = 1; tag <= s_data_type_mask; tag++) {
+        DataType type = DataType(tag - 1);
+        if (target.is_null() || !Mixed::data_types_are_comparable(type, target.get_type())) {
+            actions[tag] = incomparable_matches ? tag_accept : tag_reject;
+        }
+        else if (type == type_Int && target.is_type(type_Int)) {
+            actions[tag] = tag_compare_int;
+        }
+        else {
+            actions[tag] = tag_evaluate;
+        }
+    }
+
+    size_t res = realm::npos;
+    REALM_TEMPEX2(res = find_first_by_type, Cond, m_composite.get_width(), (actions, target, begin, end));
+    return res;
+}
+
+template <class Cond, size_t w>
+size_t ArrayMixed::find_first_by_type(const TagAction* actions, Mixed target, size_t begin,
+                                      size_t end) const noexcept
+{
+    Cond cond;
+    const int64_t target_int = target.is_type(type_Int) ? target.get_int() : 0;
     for (size_t i = begin; i < end; i++) {
-        if (Mixed::data_types_are_comparable(this->get_type(i), type) && get(i) == value) {
-            return i;
+        int64_t val = m_composite.get<w>(i);
+        switch (actions[val & s_data_type_mask]) {
+            case tag_reject:
+                break;
+            case tag_accept:
+                return i;
+            case tag_compare_int: {
+                int64_t int_val = val >> s_data_shift;
+                if (val & s_payload_idx_mask) {
+                    ensure_int_array();
+                    int_val = m_ints.get(size_t(int_val));
+                }
+                if (cond(int_val, target_int))
+                    return i;
+                break;
+            }
+            case tag_evaluate:
+                if (cond(QueryValue(get(i)), QueryValue(target)))
+                    return i;
+                break;
         }
     }
     return realm::npos;
 }
 
+template size_t ArrayMixed::find_first<Equal>(Mixed, size_t, size_t) const noexcept;
+template size_t ArrayMixed::find_first<NotEqual>(Mixed, size_t, size_t) const noexcept;
+template size_t ArrayMixed::find_first<Greater>(Mixed, size_t, size_t) const noexcept;
+template size_t ArrayMixed::find_first<GreaterEqual>(Mixed, size_t, size_t) const noexcept;
+template size_t ArrayMixed::find_first<Less>(Mixed, size_t, size_t) const noexcept;
+template size_t ArrayMixed::find_first<LessEqual>(Mixed, size_t, size_t) const noexcept;
+
 bool ArrayMixed::ensure_keys()
 {
     if (Array::size() < payload_idx_key + 1 || Array::get(payload_idx_key) == 0) {
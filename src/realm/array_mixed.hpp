@@ -94,6 +94,12 @@ public:
     void move(ArrayMixed& dst, size_t ndx);
 
     size_t find_first(Mixed value, size_t begin = 0, size_t end = realm::npos) const noexcept;
+    /// Find the first value in [begin, end) for which 'Cond()(value, target)' holds. The type tags are
+    /// scanned first so that only values of a type comparable to 'target' are decoded, and integers stored
+    /// inline in the type array are compared without materializing a Mixed. Only the comparison conditions
+    /// (Equal, NotEqual, Greater, GreaterEqual, Less and LessEqual) are supported.
+    template <class Cond>
+    size_t find_first(Mixed target, size_t begin = 0, size_t end = realm::npos) const noexcept;
     bool ensure_keys();
     size_t find_key(int64_t) const noexcept;
     void set_key(size_t ndx, int64_t key);
@@ -117,6 +123,9 @@ private:
     static constexpr int64_t s_payload_idx_shift = 5;
     static constexpr int64_t s_data_shift = 8;
 
+    // What to do with an element of a given type tag when searching
+    enum TagAction : uint8_t { tag_reject, tag_accept, tag_compare_int, tag_evaluate };
+
     // This primary array contains an aggregation of the actual value - which can be
     // either the value itself or an index into one of the payload arrays - the index
     // of the payload array and the data_type.
@@ -147,6 +156,8 @@ private:
     void ensure_ref_array() const;
     void replace_index(size_t old_ndx, size_t new_ndx, size_t payload_index);
     void erase_linked_payload(size_t ndx, bool free_linked_arrays);
+    template <class Cond, size_t w>
+    size_t find_first_by_type(const TagAction* actions, Mixed target, size_t begin, size_t end) const noexcept;
 };
 } // namespace realm
 
@@ -18,6 +18,10 @@
 
 #include <realm/array_timestamp.hpp>
 #include <realm/array_integer_tpl.hpp>
+#include <realm/util/safe_int_ops.hpp>
+
+#include <limits>
+#include <vector>
 
 using namespace realm;
 
@@ -32,6 +36,46 @@ ArrayTimestamp::ArrayTimestamp(Allocator& a)
 
 void ArrayTimestamp::create()
 {
+    Array::create(Array::type_Normal); // Throws
+    m_is_compact = true;
+}
+
+void ArrayTimestamp::init_from_mem(MemRef mem) noexcept
+{
+    Array::init_from_mem(mem);
+    m_is_compact = !Array::has_refs();
+    if (!m_is_compact) {
+        m_seconds.init_from_parent();
+        m_nanoseconds.init_from_parent();
+    }
+}
+
+int ArrayTimestamp::to_compact(Timestamp value, int64_t& compact) noexcept
+{
+    REALM_ASSERT_DEBUG(!value.is_null());
+    int64_t seconds = value.get_seconds();
+    int32_t nanoseconds = value.get_nanoseconds();
+    int64_t v = seconds;
+    if (util::int_multiply_with_overflow_detect(v, Timestamp::nanoseconds_per_second))
+        return seconds < 0 ? -1 : 1;
+    if (util::int_add_with_overflow_detect(v, nanoseconds))
+        return nanoseconds < 0 ? -1 : 1;
+    if (v == s_compact_null)
+        return -1;
+    compact = v;
+    return 0;
+}
+
+void ArrayTimestamp::convert_to_split()
+{
+    REALM_ASSERT(m_is_compact);
+    size_t sz = Array::size();
+    std::vector<Timestamp> values;
+    values.reserve(sz);
+    for (size_t i = 0; i < sz; ++i)
+        values.push_back(from_compact(Array::get(i)));
+
+    Array::destroy();
     Array::create(Array::type_HasRefs, false /* context_flag */, 2);
 
     MemRef seconds = ArrayIntNull::create_array(Array::type_Normal, false, 0, m_alloc);
@@ -41,13 +85,11 @@ void ArrayTimestamp::create()
 
     m_seconds.init_from_parent();
     m_nanoseconds.init_from_parent();
-}
+    m_is_compact = false;
 
-void ArrayTimestamp::init_from_mem(MemRef mem) noexcept
-{
-    Array::init_from_mem(mem);
-    m_seconds.init_from_parent();
-    m_nanoseconds.init_from_parent();
+    for (size_t i = 0; i < sz; ++i)
+        do_split_insert(i, values[i]); // Throws
+    Array::update_parent();
 }
 
 void ArrayTimestamp::set(size_t ndx, Timestamp value)
@@ -56,6 +98,51 @@ void ArrayTimestamp::set(size_t ndx, Timestamp value)
         return set_null(ndx);
     }
 
+    if (m_is_compact) {
+        int64_t v;
+        if (to_compact(value, v) == 0) {
+            Array::set(ndx, v); // Throws
+            return;
+        }
+        convert_to_split(); // Throws
+    }
+    do_split_set(ndx, value);
+}
+
+void ArrayTimestamp::insert(size_t ndx, Timestamp value)
+{
+    if (m_is_compact) {
+        int64_t v = s_compact_null;
+        if (value.is_null() || to_compact(value, v) == 0) {
+            Array::insert(ndx, v); // Throws
+            return;
+        }
+        convert_to_split(); // Throws
+    }
+    do_split_insert(ndx, value);
+}
+
+void ArrayTimestamp::move(ArrayTimestamp& dst, size_t ndx)
+{
+    if (m_is_compact && dst.m_is_compact) {
+        Array::move(dst, ndx);
+        return;
+    }
+    if (m_is_compact) {
+        size_t sz = Array::size();
+        for (size_t i = ndx; i < sz; ++i)
+            dst.add(from_compact(Array::get(i))); // Throws
+        Array::truncate(ndx);
+        return;
+    }
+    if (dst.m_is_compact)
+        dst.convert_to_split(); // Throws
+    m_seconds.move(dst.m_seconds, ndx);
+    m_nanoseconds.move(dst.m_nanoseconds, ndx);
+}
+
+void ArrayTimestamp::do_split_set(size_t ndx, Timestamp value)
+{
     util::Optional<int64_t> seconds = util::make_optional(value.get_seconds());
     int32_t nanoseconds = value.get_nanoseconds();
 
@@ -63,7 +150,7 @@ void ArrayTimestamp::set(size_t ndx, Timestamp value)
     m_nanoseconds.set(ndx, nanoseconds); // Throws
 }
 
-void ArrayTimestamp::insert(size_t ndx, Timestamp value)
+void ArrayTimestamp::do_split_insert(size_t ndx, Timestamp value)
 {
     if (value.is_null()) {
         m_seconds.insert(ndx, util::none);
@@ -78,11 +165,80 @@ void ArrayTimestamp::insert(size_t ndx, Timestamp value)
     }
 }
 
+size_t ArrayTimestamp::find_first_non_null(size_t begin, size_t end) const noexcept
+{
+    return Array::find_first<NotEqual>(s_compact_null, begin, end);
+}
+
+template <class Condition>
+size_t ArrayTimestamp::find_first_compact(Timestamp value, size_t begin, size_t end) const noexcept
+{
+    constexpr bool is_greater = std::is_same_v<Condition, Greater> || std::is_same_v<Condition, GreaterEqual>;
+    constexpr bool is_less = std::is_same_v<Condition, Less> || std::is_same_v<Condition, LessEqual>;
+
+    if (value.is_null()) {
+        if constexpr (is_greater || is_less) {
+            if constexpr (std::is_same_v<Condition, Greater> || std::is_same_v<Condition, Less>) {
+                return not_found;
+            }
+            return Array::find_first<Equal>(s_compact_null, begin, end);
+        }
+        else {
+            return Array::find_first<Condition>(s_compact_null, begin, end);
+        }
+    }
+
+    int64_t v;
+    int dir = to_compact(value, v);
+    if (dir != 0) {
+        // The value is outside the range of a compact leaf
+        if constexpr (std::is_same_v<Condition, Equal>) {
+            return not_found;
+        }
+        else if constexpr (std::is_same_v<Condition, NotEqual>) {
+            return begin < end ? begin : not_found;
+        }
+        else {
+            bool all_match = is_greater ? dir < 0 : dir > 0;
+            return all_match ? find_first_non_null(begin, end) : not_found;
+        }
+    }
+
+    if constexpr (std::is_same_v<Condition, Equal> || std::is_same_v<Condition, NotEqual> ||
+                  std::is_same_v<Condition, Greater>) {
+        return Array::find_first<Condition>(v, begin, end);
+    }
+    else if constexpr (std::is_same_v<Condition, GreaterEqual>) {
+        // The smallest compact value is s_compact_null + 1
+        if (v == s_compact_null + 1)
+            return find_first_non_null(begin, end);
+        return Array::find_first<Greater>(v - 1, begin, end);
+    }
+    else {
+        if constexpr (std::is_same_v<Condition, LessEqual>) {
+            if (v == std::numeric_limits<int64_t>::max())
+                return find_first_non_null(begin, end);
+            ++v;
+        }
+        // Nulls are stored as the smallest integer, so they have to be skipped
+        while (begin < end) {
+            size_t ret = Array::find_first<Less>(v, begin, end);
+            if (ret == not_found || Array::get(ret) != s_compact_null)
+                return ret;
+            begin = ret + 1;
+        }
+        return not_found;
+    }
+}
+
 namespace realm {
 
 template <>
 size_t ArrayTimestamp::find_first<Greater>(Timestamp value, size_t begin, size_t end) const noexcept
 {
+    if (m_is_compact) {
+        return find_first_compact<Greater>(value, begin, end);
+    }
     if (value.is_null()) {
         return not_found;
     }
@@ -112,6 +268,9 @@ size_t ArrayTimestamp::find_first<Greater>(Timestamp value, size_t begin, size_t
 template <>
 size_t ArrayTimestamp::find_first<Less>(Timestamp value, size_t begin, size_t end) const noexcept
 {
+    if (m_is_compact) {
+        return find_first_compact<Less>(value, begin, end);
+    }
     if (value.is_null()) {
         return not_found;
     }
@@ -141,6 +300,9 @@ size_t ArrayTimestamp::find_first<Less>(Timestamp value, size_t begin, size_t en
 template <>
 size_t ArrayTimestamp::find_first<GreaterEqual>(Timestamp value, size_t begin, size_t end) const noexcept
 {
+    if (m_is_compact) {
+        return find_first_compact<GreaterEqual>(value, begin, end);
+    }
     if (value.is_null()) {
         return m_seconds.find_first<Equal>(util::none, begin, end);
     }
@@ -170,6 +332,9 @@ size_t ArrayTimestamp::find_first<GreaterEqual>(Timestamp value, size_t begin, s
 template <>
 size_t ArrayTimestamp::find_first<LessEqual>(Timestamp value, size_t begin, size_t end) const noexcept
 {
+    if (m_is_compact) {
+        return find_first_compact<LessEqual>(value, begin, end);
+    }
     if (value.is_null()) {
         return m_seconds.find_first<Equal>(util::none, begin, end);
     }
@@ -199,6 +364,9 @@ size_t ArrayTimestamp::find_first<LessEqual>(Timestamp value, size_t begin, size
 template <>
 size_t ArrayTimestamp::find_first<Equal>(Timestamp value, size_t begin, size_t end) const noexcept
 {
+    if (m_is_compact) {
+        return find_first_compact<Equal>(value, begin, end);
+    }
     if (value.is_null()) {
         return m_seconds.find_first<Equal>(util::none, begin, end);
     }
@@ -216,6 +384,9 @@ size_t ArrayTimestamp::find_first<Equal>(Timestamp value, size_t begin, size_t e
 template <>
 size_t ArrayTimestamp::find_first<NotEqual>(Timestamp value, size_t begin, size_t end) const noexcept
 {
+    if (m_is_compact) {
+        return find_first_compact<NotEqual>(value, begin, end);
+    }
     if (value.is_null()) {
         return m_seconds.find_first<NotEqual>(util::none, begin, end);
     }
@@ -238,6 +409,22 @@ size_t ArrayTimestamp::find_first<NotEqual>(Timestamp value, size_t begin, size_
 
 size_t ArrayTimestamp::find_first_in_range(Timestamp from, Timestamp to, size_t start, size_t end) const
 {
+    if (m_is_compact) {
+        if (from.is_null() || to.is_null())
+            return not_found;
+        int64_t lo = s_compact_null + 1;
+        int64_t hi = std::numeric_limits<int64_t>::max();
+        int dir_from = to_compact(from, lo);
+        int dir_to = to_compact(to, hi);
+        if (dir_from > 0 || dir_to < 0)
+            return not_found;
+        for (; start < end; ++start) {
+            int64_t v = Array::get(start);
+            if (v >= lo && v <= hi)
+                return start;
+        }
+        return not_found;
+    }
     while (start < end) {
         start = m_seconds.find_first_in_range(from.get_seconds(), to.get_seconds(), start, end);
         if (start != realm::not_found) {
@@ -256,6 +443,11 @@ size_t ArrayTimestamp::find_first_in_range(Timestamp from, Timestamp to, size_t
 void ArrayTimestamp::verify() const
 {
 #ifdef REALM_DEBUG
+    if (m_is_compact) {
+        Array::verify();
+        REALM_ASSERT(!Array::has_refs());
+        return;
+    }
     m_seconds.verify();
     m_nanoseconds.verify();
     REALM_ASSERT(m_seconds.size() == m_nanoseconds.size());
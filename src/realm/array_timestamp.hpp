@@ -59,22 +59,29 @@ public:
 
     size_t size() const
     {
-        return m_seconds.size();
+        return m_is_compact ? Array::size() : m_seconds.size();
     }
 
     void add(Timestamp value)
     {
-        insert(m_seconds.size(), value);
+        insert(size(), value);
     }
     void set(size_t ndx, Timestamp value);
     void set_null(size_t ndx)
     {
+        if (m_is_compact) {
+            Array::set(ndx, s_compact_null); // Throws
+            return;
+        }
         // Value in m_nanoseconds is irrelevant if m_seconds is null
         m_seconds.set_null(ndx); // Throws
     }
     void insert(size_t ndx, Timestamp value);
     Timestamp get(size_t ndx) const
     {
+        if (m_is_compact) {
+            return from_compact(Array::get(ndx));
+        }
         util::Optional<int64_t> seconds = m_seconds.get(ndx);
         return seconds ? Timestamp(*seconds, int32_t(m_nanoseconds.get(ndx))) : Timestamp{};
     }
@@ -84,24 +91,35 @@ public:
     }
     bool is_null(size_t ndx) const
     {
-        return m_seconds.is_null(ndx);
+        return m_is_compact ? Array::get(ndx) == s_compact_null : m_seconds.is_null(ndx);
     }
     void erase(size_t ndx)
     {
+        if (m_is_compact) {
+            Array::erase(ndx);
+            return;
+        }
         m_seconds.erase(ndx);
         m_nanoseconds.erase(ndx);
     }
-    void move(ArrayTimestamp& dst, size_t ndx)
-    {
-        m_seconds.move(dst.m_seconds, ndx);
-        m_nanoseconds.move(dst.m_nanoseconds, ndx);
-    }
+    void move(ArrayTimestamp& dst, size_t ndx);
     void clear()
     {
+        if (m_is_compact) {
+            Array::clear();
+            return;
+        }
         m_seconds.clear();
         m_nanoseconds.clear();
     }
 
+    // True if values are stored as a single integer (nanoseconds since the
+    // UNIX epoch) rather than as separate seconds and nanoseconds.
+    bool is_compact() const noexcept
+    {
+        return m_is_compact;
+    }
+
     template <class Condition>
     size_t find_first(Timestamp value, size_t begin, size_t end) const noexcept;
 
@@ -111,8 +129,39 @@ public:
     void verify() const;
 
 private:
+    // A leaf is either compact or split. A compact leaf is a plain integer
+    // array holding the number of nanoseconds since the UNIX epoch, which
+    // covers the years 1677 to 2262, with INT64_MIN representing null. It
+    // can use the integer search directly. A split leaf has two subarrays
+    // holding seconds and nanoseconds. New leaves are created compact, and
+    // are converted to split the first time they need to hold a value
+    // outside the compact range.
+    static constexpr int64_t s_compact_null = std::numeric_limits<int64_t>::min();
+
     ArrayIntNull m_seconds;
     ArrayInteger m_nanoseconds;
+    bool m_is_compact = false;
+
+    // Returns 0 and sets 'compact' if 'value' can be stored in a compact
+    // leaf. Otherwise returns -1 if the value is smaller than all compact
+    // values, or 1 if it is larger.
+    static int to_compact(Timestamp value, int64_t& compact) noexcept;
+    static Timestamp from_compact(int64_t value) noexcept
+    {
+        if (value == s_compact_null)
+            return Timestamp{};
+        // Division truncates towards zero, which gives the seconds and
+        // nanoseconds the same sign as required by Timestamp
+        return Timestamp(value / Timestamp::nanoseconds_per_second,
+                         int32_t(value % Timestamp::nanoseconds_per_second));
+    }
+
+    void convert_to_split();
+    void do_split_set(size_t ndx, Timestamp value);
+    void do_split_insert(size_t ndx, Timestamp value);
+    size_t find_first_non_null(size_t begin, size_t end) const noexcept;
+    template <class Condition>
+    size_t find_first_compact(Timestamp value, size_t begin, size_t end) const noexcept;
 };
 
 template <>
@@ -34,13 +34,14 @@ using VersionList = BackupHandler::VersionList;
 using VersionTimeList = BackupHandler::VersionTimeList;
 
 // Note: accepted versions should have new versions added at front
-const VersionList BackupHandler::accepted_versions_ = {24, 23, 22, 21, 20, 11, 10};
+const VersionList BackupHandler::accepted_versions_ = {25, 24, 23, 22, 21, 20, 11, 10};
 
 // the pair is <version, age-in-seconds>
 // we keep backup files in 3 months.
 static constexpr int three_months = 3 * 31 * 24 * 60 * 60;
-const VersionTimeList BackupHandler::delete_versions_{{23, three_months}, {22, three_months}, {21, three_months},
-                                                      {20, three_months}, {11, three_months}, {10, three_months}};
+const VersionTimeList BackupHandler::delete_versions_{{24, three_months}, {23, three_months}, {22, three_months},
+                                                      {21, three_months}, {20, three_months}, {11, three_months},
+                                                      {10, three_months}};
 
 
 // helper functions
@@ -0,0 +1,80 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+
+#include <realm/blob.hpp>
+#include <realm/table.hpp>
+
+#include <algorithm>
+
+using namespace realm;
+
+Blob::Blob(const Obj& obj, ColKey col_key)
+    : m_obj(obj)
+    , m_col_key(col_key)
+{
+    m_obj.get_table()->check_column(col_key);
+    if (col_key.get_type() != col_type_Binary || col_key.is_collection())
+        throw InvalidArgument(ErrorCodes::TypeMismatch, "Property not a binary");
+}
+
+BinaryData Blob::get() const
+{
+    return m_obj.get<BinaryData>(m_col_key);
+}
+
+bool Blob::is_null() const
+{
+    return get().is_null();
+}
+
+size_t Blob::size() const
+{
+    return get().size();
+}
+
+BinaryData Blob::read(size_t offset, size_t size) const
+{
+    BinaryData value = get();
+    if (offset > value.size())
+        throw OutOfBounds("Blob::read()", offset, value.size());
+    return BinaryData(value.data() + offset, std::min(size, value.size() - offset));
+}
+
+void Blob::write(size_t offset, BinaryData data)
+{
+    size_t old_size = size();
+    if (offset > old_size)
+        throw OutOfBounds("Blob::write()", offset, old_size);
+    m_obj.replace_binary(m_col_key, offset, std::min(offset + data.size(), old_size), data);
+}
+
+void Blob::append(BinaryData data)
+{
+    size_t old_size = size();
+    m_obj.replace_binary(m_col_key, old_size, old_size, data);
+}
+
+void Blob::truncate(size_t new_size)
+{
+    size_t old_size = size();
+    if (new_size > old_size)
+        throw OutOfBounds("Blob::truncate()", new_size, old_size);
+    if (new_size < old_size)
+        m_obj.replace_binary(m_col_key, new_size, old_size, BinaryData("", 0));
+}
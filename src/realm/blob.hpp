@@ -0,0 +1,60 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+
+#ifndef REALM_BLOB_HPP
+#define REALM_BLOB_HPP
+
+#include <realm/binary_data.hpp>
+#include <realm/obj.hpp>
+
+namespace realm {
+
+// Byte range access to the value of a binary property, as returned by
+// Obj::open_blob(). Reads return a view of the stored bytes without
+// materializing the rest of the value, and writes only touch the given range of
+// the stored value. A null value reads as empty, and writing to it makes it
+// non-null.
+//
+// The handle follows the object through transactions like any other Obj
+// accessor. Views returned by read() are valid until the value is modified or
+// the transaction advances.
+class Blob {
+public:
+    Blob(const Obj& obj, ColKey col_key);
+
+    bool is_null() const;
+    size_t size() const;
+
+    // Returns a view of up to `size` bytes starting at `offset`
+    BinaryData read(size_t offset, size_t size) const;
+    // Overwrite the bytes starting at `offset`, extending the value if needed
+    void write(size_t offset, BinaryData data);
+    void append(BinaryData data);
+    void truncate(size_t new_size);
+
+private:
+    Obj m_obj;
+    ColKey m_col_key;
+
+    BinaryData get() const;
+};
+
+} // namespace realm
+
+#endif // REALM_BLOB_HPP
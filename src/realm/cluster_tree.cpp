@@ -71,7 +71,8 @@ public:
         return m_sub_tree_depth;
     }
 
-    bool traverse(ClusterTree::TraverseFunction func, int64_t) const;
+    bool traverse(ClusterTree::TraverseFunction func, int64_t key_offset,
+                  int64_t first_key = std::numeric_limits<int64_t>::min()) const;
     void update(ClusterTree::UpdateFunction func, int64_t);
 
     size_t node_size() const override
@@ -680,16 +681,25 @@ size_t ClusterNodeInner::update_sub_tree_size()
     return sub_tree_size;
 }
 
-bool ClusterNodeInner::traverse(ClusterTree::TraverseFunction func, int64_t key_offset) const
+bool ClusterNodeInner::traverse(ClusterTree::TraverseFunction func, int64_t key_offset, int64_t first_key) const
 {
     auto sz = node_size();
+    auto child_offset = [&](unsigned i) -> int64_t {
+        return int64_t(m_keys.is_attached() ? m_keys.get(i) : i << m_shift_factor) + key_offset;
+    };
 
-    for (unsigned i = 0; i < sz; i++) {
+    // Keys are inserted into the last child with an offset not above the
+    // key, so all keys in a child are below the offset of the next child.
+    unsigned first = 0;
+    while (first + 1 < sz && child_offset(first + 1) <= first_key)
+        ++first;
+
+    for (unsigned i = first; i < sz; i++) {
         ref_type ref = _get_child_ref(i);
         char* header = m_alloc.translate(ref);
         bool child_is_leaf = !Array::get_is_inner_bptree_node_from_header(header);
         MemRef mem(header, ref, m_alloc);
-        int64_t offs = (m_keys.is_attached() ? m_keys.get(i) : i << m_shift_factor) + key_offset;
+        int64_t offs = child_offset(i);
         if (child_is_leaf) {
             Cluster leaf(offs, m_alloc, m_tree_top);
             leaf.init(mem);
@@ -700,7 +710,7 @@ bool ClusterNodeInner::traverse(ClusterTree::TraverseFunction func, int64_t key_
         else {
             ClusterNodeInner node(m_alloc, m_tree_top);
             node.init(mem);
-            if (node.traverse(func, offs)) {
+            if (node.traverse(func, offs, first_key)) {
                 return true;
             }
         }
@@ -816,6 +826,7 @@ std::unique_ptr<ClusterNode> ClusterTree::get_node(ArrayParent* parent, size_t n
 void ClusterTree::clear(CascadeState& state)
 {
     m_owner->clear_indexes();
+    m_owner->note_in_place_change();
 
     if (state.m_group) {
         remove_all_links(state); // This will also delete objects loosing their last strong link
@@ -932,8 +943,12 @@ Obj ClusterTree::insert(ObjKey k, const FieldValues& init_values)
 {
     ClusterNode::State state;
 
+    // Tombstones are never part of query results, so creating one is
+    // treated like any other change to the table
+    bool at_end = !k.is_unresolved() && (m_size == 0 || k.value > get_last_key_value());
     insert_fast(k, init_values, state);
     m_owner->update_indexes(k, init_values);
+    m_owner->note_object_created(k, at_end);
 
     bump_content_version();
     bump_storage_version();
@@ -992,6 +1007,7 @@ void ClusterTree::erase(ObjKey k, CascadeState& state)
         }
     }
     m_owner->erase_from_search_indexes(k);
+    m_owner->note_object_changed(k);
 
     size_t root_size = m_root->erase(ClusterNode::RowKey(k), state);
 
@@ -1029,6 +1045,43 @@ bool ClusterTree::get_leaf(ObjKey key, ClusterNode::IteratorState& state) const
     }
 }
 
+void ClusterTree::resolve(const ObjKey* keys, size_t num_keys, ResolveFunction func) const
+{
+    // Null and unresolved keys never refer to an object in this tree
+    std::vector<size_t> order;
+    order.reserve(num_keys);
+    for (size_t i = 0; i < num_keys; i++) {
+        if (keys[i].value >= 0)
+            order.push_back(i);
+    }
+    auto key_less = [keys](size_t a, size_t b) {
+        return keys[a] < keys[b];
+    };
+    if (!std::is_sorted(order.begin(), order.end(), key_less))
+        std::stable_sort(order.begin(), order.end(), key_less);
+
+    Cluster leaf(0, m_alloc, *this);
+    ClusterNode::IteratorState state(leaf);
+    int64_t first_in_leaf = 0;
+    int64_t last_in_leaf = -1;
+    for (size_t i : order) {
+        int64_t key_value = keys[i].value;
+        if (key_value > last_in_leaf) {
+            // Find the leaf holding the key, or the first key above it
+            if (!get_leaf(keys[i], state))
+                return;
+            first_in_leaf = leaf.get_real_key(0).value;
+            last_in_leaf = leaf.get_real_key(leaf.node_size() - 1).value;
+        }
+        if (key_value < first_in_leaf)
+            continue;
+        ClusterNode::RowKey row_key(key_value - state.m_key_offset);
+        size_t ndx = leaf.lower_bound_key(row_key);
+        if (ndx < leaf.node_size() && leaf.get_key_value(ndx) == int64_t(row_key.value))
+            func(i, &leaf, ndx);
+    }
+}
+
 bool ClusterTree::traverse(TraverseFunction func) const
 {
     if (m_root->is_leaf()) {
@@ -1039,8 +1092,20 @@ bool ClusterTree::traverse(TraverseFunction func) const
     }
 }
 
+bool ClusterTree::traverse(TraverseFunction func, ObjKey first) const
+{
+    if (m_root->is_leaf()) {
+        return func(static_cast<Cluster*>(m_root.get())) == IteratorControl::Stop;
+    }
+    else {
+        return static_cast<ClusterNodeInner*>(m_root.get())->traverse(func, 0, first.value);
+    }
+}
+
 void ClusterTree::update(UpdateFunction func)
 {
+    if (m_owner)
+        m_owner->note_in_place_change();
     if (m_root->is_leaf()) {
         func(static_cast<Cluster*>(m_root.get()));
     }
@@ -33,6 +33,7 @@ public:
     using TraverseFunction = util::FunctionRef<IteratorControl(const Cluster*)>;
     using UpdateFunction = util::FunctionRef<void(Cluster*)>;
     using ColIterateFunction = util::FunctionRef<IteratorControl(ColKey)>;
+    using ResolveFunction = util::FunctionRef<void(size_t, const Cluster*, size_t)>;
 
     ClusterTree(Table* owner, Allocator& alloc, size_t top_position_for_cluster_tree);
     virtual ~ClusterTree();
@@ -174,9 +175,15 @@ public:
     size_t get_ndx(ObjKey k) const noexcept;
     // Find the leaf containing the requested object
     bool get_leaf(ObjKey key, ClusterNode::IteratorState& state) const noexcept;
+    // Look up a batch of objects. The keys are probed in ascending order, so the tree is only descended once for
+    // every leaf holding any of them. 'func' is called in key order for every key of an existing object with the
+    // position of the key in 'keys', the leaf and the index within the leaf.
+    void resolve(const ObjKey* keys, size_t num_keys, ResolveFunction func) const;
     // Visit all leaves and call the supplied function. Stop when function returns IteratorControl::Stop.
     // Not allowed to modify the tree
     bool traverse(TraverseFunction func) const;
+    // Same, but skip the leaves which only hold keys below 'first'
+    bool traverse(TraverseFunction func, ObjKey first) const;
     // Visit all leaves and call the supplied function. The function can modify the leaf.
     void update(UpdateFunction func);
 
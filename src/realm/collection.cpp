@@ -22,6 +22,7 @@
 #include <realm/array_key.hpp>
 #include <realm/array_string.hpp>
 #include <realm/array_mixed.hpp>
+#include <realm/index_string.hpp>
 
 namespace realm {
 
@@ -254,6 +255,24 @@ UpdateStatus CollectionBase::do_init_from_parent(BPlusTreeBase* tree, ref_type r
     return UpdateStatus::Updated;
 }
 
+void CollectionBase::index_insert(StringIndex& index, Mixed value) const
+{
+    // Inserting a value already present is idempotent
+    index.insert(get_owner_key(), value);
+}
+
+void CollectionBase::index_erase(StringIndex& index, Mixed value) const
+{
+    CollectionElementBuffer buffer;
+    StringConversionBuffer data_buffer;
+    index.erase_string(get_owner_key(), StringIndex::collection_element(value, buffer).get_index_data(data_buffer));
+}
+
+void CollectionBase::index_clear(StringIndex& index) const
+{
+    index.erase_collection(get_owner_key(), *this);
+}
+
 void CollectionBase::out_of_bounds(const char* msg, size_t index, size_t size) const
 {
     auto path = get_short_path();
@@ -269,6 +269,12 @@ protected:
     }
     void out_of_bounds(const char* msg, size_t index, size_t size) const;
     static UpdateStatus do_init_from_parent(BPlusTreeBase* tree, ref_type ref, bool allow_create);
+
+    // Maintenance of the search index of an indexed list or set. The owning object is present in the index once
+    // for every distinct value in the collection, so a value must only be erased with its last occurrence.
+    void index_insert(StringIndex& index, Mixed value) const;
+    void index_erase(StringIndex& index, Mixed value) const;
+    void index_clear(StringIndex& index) const;
 };
 
 inline std::string_view collection_type_name(CollectionType col_type, bool uppercase = false)
@@ -688,6 +694,7 @@ protected:
     void bump_content_version() noexcept
     {
         REALM_ASSERT(m_alloc);
+        note_object_changed();
         m_content_version = m_alloc->bump_content_version();
         m_parent->update_content_version();
     }
@@ -701,11 +708,19 @@ protected:
     void bump_both_versions()
     {
         REALM_ASSERT(m_alloc);
+        note_object_changed();
         m_alloc->bump_content_version();
         m_alloc->bump_storage_version();
         m_parent->update_content_version();
     }
 
+    void note_object_changed() noexcept
+    {
+        const Obj& obj = m_obj_mem;
+        if (auto table = obj.get_table().unchecked_ptr())
+            table->note_object_changed(obj.get_key());
+    }
+
     Replication* get_replication() const
     {
         check_parent();
@@ -720,6 +735,11 @@ protected:
         return t.unchecked_ptr();
     }
 
+    StringIndex* get_search_index() const
+    {
+        return get_table_unchecked()->get_string_index(m_col_key);
+    }
+
     Allocator& get_alloc() const
     {
         check_alloc();
@@ -133,7 +133,7 @@ static_assert(!col_type_OldStringEnum.is_valid());
 static_assert(!col_type_OldTable.is_valid());
 static_assert(!col_type_OldDateTime.is_valid());
 
-enum class IndexType { None, General, Fulltext };
+enum class IndexType { None, General, Fulltext, Trigram, Vector };
 
 inline std::ostream& operator<<(std::ostream& ostr, IndexType type)
 {
@@ -147,6 +147,34 @@ inline std::ostream& operator<<(std::ostream& ostr, IndexType type)
         case IndexType::Fulltext:
             ostr << "fulltext index";
             break;
+        case IndexType::Trigram:
+            ostr << "trigram index";
+            break;
+        case IndexType::Vector:
+            ostr << "vector index";
+            break;
+    }
+    return ostr;
+}
+
+// How the distance between two vectors is measured by nearest neighbour
+// searches. For all metrics a smaller distance means closer vectors: L2 is the
+// squared euclidean distance, Cosine is one minus the cosine similarity and
+// Dot is the negated inner product.
+enum class VectorMetric { L2, Cosine, Dot };
+
+inline std::ostream& operator<<(std::ostream& ostr, VectorMetric metric)
+{
+    switch (metric) {
+        case VectorMetric::L2:
+            ostr << "L2";
+            break;
+        case VectorMetric::Cosine:
+            ostr << "cosine";
+            break;
+        case VectorMetric::Dot:
+            ostr << "dot";
+            break;
     }
     return ostr;
 }
@@ -182,6 +210,14 @@ enum ColumnAttr {
     /// Specifies that elements in the column are full-text indexed
     col_attr_FullText_Indexed = 256,
 
+    /// Specifies that elements in the column are indexed by the sequences of
+    /// three bytes they contain
+    col_attr_Trigram_Indexed = 512,
+
+    /// Specifies that the vectors of floats stored in the column are indexed
+    /// for nearest neighbour searches
+    col_attr_Vector_Indexed = 1024,
+
     /// Either list, dictionary, or set
     col_attr_Collection = 128 + 64 + 32
 };
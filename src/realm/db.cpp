@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <atomic>
 #include <cerrno>
+#include <climits>
 #include <fcntl.h>
 #include <iostream>
 #include <mutex>
@@ -34,6 +35,7 @@
 
 #include <realm/disable_sync_to_disk.hpp>
 #include <realm/group_writer.hpp>
+#include <realm/query_cache.hpp>
 #include <realm/impl/simulated_failure.hpp>
 #include <realm/replication.hpp>
 #include <realm/util/errno.hpp>
@@ -53,6 +55,11 @@
 #include <process.h>
 #endif
 
+#if REALM_LINUX || REALM_ANDROID
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
+
 // #define REALM_ENABLE_LOGFILE
 
 
@@ -80,7 +87,63 @@ namespace {
 //         with a lock.
 // 13      New impl of VersionList and added mutex for it (former RingBuffer)
 // 14      Added field for tracking ongoing encrypted writes
-const uint_fast16_t g_shared_info_version = 14;
+// 15      Added `change_counter` and `change_waiters` for futex based
+//         notification of commits
+const uint_fast16_t g_shared_info_version = 15;
+
+#if REALM_LINUX || REALM_ANDROID
+constexpr bool g_have_futex = true;
+#else
+constexpr bool g_have_futex = false;
+#endif
+
+// The futex word is accessed through a std::atomic<uint32_t>, which must then be
+// a plain 32 bit integer
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t) && ATOMIC_INT_LOCK_FREE == 2);
+
+// Sleep until `word` no longer holds `expected`. May return spuriously.
+void futex_wait(std::atomic<uint32_t>& word, uint32_t expected) noexcept
+{
+#if REALM_LINUX || REALM_ANDROID
+    // Not using FUTEX_PRIVATE_FLAG as the word is shared between processes
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT, expected, nullptr, nullptr, 0);
+#else
+    static_cast<void>(word);
+    static_cast<void>(expected);
+    REALM_UNREACHABLE();
+#endif
+}
+
+void futex_wake_all(std::atomic<uint32_t>& word) noexcept
+{
+#if REALM_LINUX || REALM_ANDROID
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#else
+    static_cast<void>(word);
+    REALM_UNREACHABLE();
+#endif
+}
+
+// Waiters register themselves in `num_waiters` before checking the counter,
+// and notifiers check `num_waiters` after incrementing it. As both use
+// sequentially consistent operations, either the waiter observes the new value
+// or the notifier observes the waiter, so no wake-up can be lost while no
+// system call is made when nobody is waiting.
+void wait_for_change_counter(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& num_waiters,
+                             uint32_t last_seen) noexcept
+{
+    num_waiters.fetch_add(1);
+    while (counter.load() == last_seen)
+        futex_wait(counter, last_seen);
+    num_waiters.fetch_sub(1);
+}
+
+void notify_change_counter(std::atomic<uint32_t>& counter, std::atomic<uint32_t>& num_waiters) noexcept
+{
+    counter.fetch_add(1);
+    if (num_waiters.load() != 0)
+        futex_wake_all(counter);
+}
 
 
 struct VersionList {
@@ -439,6 +502,13 @@ struct alignas(8) DB::SharedInfo {
     std::atomic<uint64_t> writing_page_offset;
     std::atomic<uint64_t> write_counter;
 
+    /// Incremented after every commit and whenever waiters must otherwise be
+    /// woken up. Used as a futex word where supported.
+    std::atomic<uint32_t> change_counter = 0;
+    /// The number of threads blocked on `change_counter`. A process dying while
+    /// waiting leaves this too high, which only costs unnecessary wake-ups.
+    std::atomic<uint32_t> change_waiters = 0;
+
     // IMPORTANT: The VersionList MUST be the last field in SharedInfo - see above.
     VersionList readers;
 
@@ -1741,6 +1811,334 @@ void DB::write_copy(std::string_view path, const char* output_encryption_key)
     }
 }
 
+namespace {
+
+// A node in the Realm file
+struct BackupNode {
+    ref_type ref;
+    size_t size;
+};
+
+// Visits the nodes reachable from `top_ref`. `visit(ref, size)` returns
+// whether the children of the node should be visited too.
+template <class F>
+void for_each_reachable_node(Allocator& alloc, ref_type top_ref, F&& visit)
+{
+    if (top_ref == 0)
+        return;
+    std::vector<ref_type> pending = {top_ref};
+    Array node(alloc);
+    while (!pending.empty()) {
+        ref_type ref = pending.back();
+        pending.pop_back();
+        char* header = alloc.translate(ref);
+        if (!visit(ref, NodeHeader::get_byte_size_from_header(header)))
+            continue;
+        if (!NodeHeader::get_hasrefs_from_header(header))
+            continue;
+        node.init_from_mem(MemRef(header, ref, alloc));
+        for (size_t i = 0, n = node.size(); i < n; ++i) {
+            // Skip null refs and tagged integers
+            int64_t value = node.get(i);
+            if (value != 0 && (value & 1) == 0)
+                pending.push_back(to_ref(value));
+        }
+    }
+}
+
+// The delta file consists of this header followed by `num_nodes` records, each
+// being the ref and size of a node (as two 64-bit integers) followed by the
+// contents of the node.
+struct BackupDeltaHeader {
+    char mnemonic[8];
+    uint64_t format_version;
+    uint64_t from_version;
+    uint64_t to_version;
+    uint64_t from_top_ref;
+    uint64_t to_top_ref;
+    uint64_t to_file_size;
+    uint64_t num_nodes;
+    uint64_t file_format;
+};
+
+constexpr char backup_delta_mnemonic[8] = {'R', 'L', 'M', '-', 'D', 'E', 'L', 'T'};
+constexpr uint64_t backup_delta_format_version = 1;
+
+} // anonymous namespace
+
+void DB::check_backup_transaction(const Transaction& tr) const
+{
+    if (tr.get_db().get() != this)
+        throw InvalidArgument("Transaction does not belong to this Realm");
+    auto stage = tr.get_transact_stage();
+    if (stage != transact_Reading && stage != transact_Frozen)
+        throw WrongTransactionState("Backups can only be written from a read or frozen transaction");
+}
+
+void DB::write_backup_header(File& file, ref_type top_ref, int file_format_version)
+{
+    using storage_type = std::remove_reference<decltype(SlabAlloc::Header::m_file_format[0])>::type;
+    SlabAlloc::Header header = {
+        {top_ref, 0},
+        {'T', '-', 'D', 'B'},
+        {storage_type(file_format_version), storage_type(file_format_version)},
+        0, // reserved
+        0  // flags (lsb is select bit)
+    };
+    file.write(0, reinterpret_cast<const char*>(&header), sizeof header);
+}
+
+void DB::write_backup(const Transaction& tr, std::string_view path, size_t num_threads)
+{
+    check_backup_transaction(tr);
+
+    auto t1 = std::chrono::steady_clock::now();
+    const Group& group = tr;
+    Allocator& alloc = group.m_alloc;
+    ref_type top_ref = group.m_top.is_attached() ? group.m_top.get_ref() : 0;
+    size_t file_size = top_ref ? group.get_logical_file_size() : sizeof(SlabAlloc::Header);
+
+    std::vector<BackupNode> nodes;
+    size_t total_size = 0;
+    for_each_reachable_node(alloc, top_ref, [&](ref_type ref, size_t size) {
+        nodes.push_back({ref, size});
+        total_size += size;
+        return true;
+    });
+    std::sort(nodes.begin(), nodes.end(), [](const BackupNode& a, const BackupNode& b) {
+        return a.ref < b.ref;
+    });
+
+    {
+        File file;
+        file.open(path, File::access_ReadWrite, File::create_Must, 0);
+        file.resize(file_size);
+        write_backup_header(file, top_ref, group.get_file_format_version());
+    }
+
+    // Each thread writes a contiguous range of nodes, coalescing adjacent
+    // nodes into larger writes
+    auto write_range = [&](size_t begin, size_t end) {
+        File file;
+        file.open(path, File::access_ReadWrite, File::create_Never, 0);
+        constexpr size_t max_buffer_size = 1024 * 1024;
+        std::vector<char> buffer;
+        ref_type buffer_ref = 0;
+        for (size_t i = begin; i < end; ++i) {
+            auto& node = nodes[i];
+            if (!buffer.empty() && (buffer_ref + buffer.size() != node.ref || buffer.size() >= max_buffer_size)) {
+                file.write(buffer_ref, buffer.data(), buffer.size());
+                buffer.clear();
+            }
+            if (buffer.empty())
+                buffer_ref = node.ref;
+            const char* data = alloc.translate(node.ref);
+            buffer.insert(buffer.end(), data, data + node.size);
+        }
+        if (!buffer.empty())
+            file.write(buffer_ref, buffer.data(), buffer.size());
+    };
+
+    num_threads = std::max<size_t>(1, std::min(num_threads, nodes.size()));
+    if (num_threads == 1) {
+        write_range(0, nodes.size());
+    }
+    else {
+        std::vector<std::thread> threads;
+        std::vector<std::exception_ptr> errors(num_threads);
+        size_t begin = 0, written = 0;
+        for (size_t t = 0; t < num_threads; ++t) {
+            // Split at roughly equal amounts of data
+            size_t end = begin;
+            size_t target = total_size / num_threads * (t + 1);
+            while (end < nodes.size() && (written < target || t + 1 == num_threads))
+                written += nodes[end++].size;
+            threads.emplace_back([&, t, begin, end] {
+                try {
+                    write_range(begin, end);
+                }
+                catch (...) {
+                    errors[t] = std::current_exception();
+                }
+            });
+            begin = end;
+        }
+        for (auto& thread : threads)
+            thread.join();
+        for (auto& error : errors) {
+            if (error)
+                std::rethrow_exception(error);
+        }
+    }
+
+    File file;
+    file.open(path, File::access_ReadWrite, File::create_Never, 0);
+    file.sync();
+    if (m_logger) {
+        auto t2 = std::chrono::steady_clock::now();
+        m_logger->log(util::Logger::Level::info, "Backup of version %1 (%2 bytes) written to '%3' in %4 us",
+                      tr.get_version(), total_size, path,
+                      std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count());
+    }
+}
+
+void DB::write_backup_delta(const Transaction& from, const Transaction& to, std::string_view path)
+{
+    check_backup_transaction(from);
+    check_backup_transaction(to);
+    if (from.get_version() > to.get_version())
+        throw InvalidArgument("Backup delta must be written from an older to a newer version");
+
+    auto t1 = std::chrono::steady_clock::now();
+    const Group& from_group = from;
+    const Group& to_group = to;
+    Allocator& alloc = to_group.m_alloc;
+
+    // As the version of `from` is still alive, none of its nodes can have been
+    // freed and overwritten since, and every node which was written after it
+    // must have been placed in space which was free in that version (or beyond
+    // its end). So rather than finding all nodes reachable from `from` we can
+    // use its free-lists to identify the new nodes, and need only descend into
+    // those.
+    std::vector<std::pair<ref_type, ref_type>> free_space;
+    ref_type from_top_ref = 0;
+    size_t from_file_size = sizeof(SlabAlloc::Header);
+    if (from_group.m_top.is_attached()) {
+        const Array& top = from_group.m_top;
+        from_top_ref = top.get_ref();
+        from_file_size = from_group.get_logical_file_size();
+        if (top.size() > Group::s_free_size_ndx) {
+            Array positions(alloc), lengths(alloc);
+            positions.init_from_ref(top.get_as_ref(Group::s_free_pos_ndx));
+            lengths.init_from_ref(top.get_as_ref(Group::s_free_size_ndx));
+            free_space.reserve(positions.size());
+            for (size_t i = 0; i < positions.size(); ++i) {
+                ref_type pos = to_ref(positions.get(i));
+                free_space.emplace_back(pos, pos + to_ref(lengths.get(i)));
+            }
+            std::sort(free_space.begin(), free_space.end());
+        }
+    }
+    auto is_new = [&](ref_type ref) {
+        if (ref >= from_file_size)
+            return true;
+        auto it = std::upper_bound(free_space.begin(), free_space.end(), std::make_pair(ref, ref_type(-1)));
+        return it != free_space.begin() && ref < std::prev(it)->second;
+    };
+
+    BackupDeltaHeader header = {};
+    std::copy(std::begin(backup_delta_mnemonic), std::end(backup_delta_mnemonic), header.mnemonic);
+    header.format_version = backup_delta_format_version;
+    header.from_version = from.get_version();
+    header.to_version = to.get_version();
+    header.from_top_ref = from_top_ref;
+    header.to_top_ref = to_group.m_top.is_attached() ? to_group.m_top.get_ref() : 0;
+    header.to_file_size = header.to_top_ref ? to_group.get_logical_file_size() : sizeof(SlabAlloc::Header);
+    header.file_format = uint64_t(to_group.get_file_format_version());
+
+    File file;
+    file.open(path, File::access_ReadWrite, File::create_Must, 0);
+    size_t total_size = 0;
+    {
+        File::Streambuf streambuf(&file, 1024 * 1024);
+        std::ostream out(&streambuf);
+        out.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+        out.write(reinterpret_cast<const char*>(&header), sizeof header);
+        for_each_reachable_node(alloc, header.to_top_ref, [&](ref_type ref, size_t size) {
+            if (!is_new(ref))
+                return false;
+            uint64_t record[2] = {uint64_t(ref), uint64_t(size)};
+            out.write(reinterpret_cast<const char*>(record), sizeof record);
+            out.write(alloc.translate(ref), size);
+            ++header.num_nodes;
+            total_size += size;
+            return true;
+        });
+        int sync_status = streambuf.pubsync();
+        REALM_ASSERT(sync_status == 0);
+    }
+    file.write(0, reinterpret_cast<const char*>(&header), sizeof header);
+    file.sync();
+
+    if (m_logger) {
+        auto t2 = std::chrono::steady_clock::now();
+        m_logger->log(util::Logger::Level::info,
+                      "Backup delta from version %1 to %2 (%3 nodes, %4 bytes) written to '%5' in %6 us",
+                      header.from_version, header.to_version, header.num_nodes, total_size, path,
+                      std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count());
+    }
+}
+
+void DB::apply_backup_delta(std::string_view backup_path, std::string_view delta_path)
+{
+    File delta;
+    delta.open(delta_path, File::access_ReadOnly, File::create_Never, 0);
+    BackupDeltaHeader header;
+    if (delta.read(0, reinterpret_cast<char*>(&header), sizeof header) != sizeof header ||
+        !std::equal(std::begin(backup_delta_mnemonic), std::end(backup_delta_mnemonic), header.mnemonic) ||
+        header.format_version != backup_delta_format_version)
+        throw InvalidDatabase("Not a backup delta file", std::string(delta_path));
+
+    File backup;
+    backup.open(backup_path, File::access_ReadWrite, File::create_Never, 0);
+    SlabAlloc::Header file_header;
+    if (backup.read(0, reinterpret_cast<char*>(&file_header), sizeof file_header) != sizeof file_header ||
+        !std::equal(file_header.m_mnemonic, file_header.m_mnemonic + 4, "T-DB"))
+        throw InvalidDatabase("Not a Realm file", std::string(backup_path));
+    int slot = file_header.m_flags & SlabAlloc::flags_SelectBit;
+    if (file_header.m_top_ref[slot] != header.from_top_ref)
+        throw InvalidArgument(util::format("Backup delta from version %1 does not apply to the backup at '%2'",
+                                           header.from_version, backup_path));
+
+    // The nodes of the delta only overwrite space which is free in the
+    // version currently in the backup, so that version stays intact until
+    // the top ref is switched below
+    if (backup.get_size() < File::SizeType(header.to_file_size))
+        backup.resize(header.to_file_size);
+    File::SizeType read_pos = sizeof header;
+    std::vector<char> read_buffer(1024 * 1024);
+    size_t buffer_begin = 0, buffer_end = 0;
+    auto read = [&](char* dest, size_t size) {
+        while (size > 0) {
+            if (buffer_begin == buffer_end) {
+                buffer_begin = 0;
+                buffer_end = delta.read(read_pos, read_buffer.data(), read_buffer.size());
+                read_pos += buffer_end;
+                if (buffer_end == 0)
+                    throw InvalidDatabase("Truncated backup delta file", std::string(delta_path));
+            }
+            size_t n = std::min(size, buffer_end - buffer_begin);
+            std::copy_n(read_buffer.data() + buffer_begin, n, dest);
+            buffer_begin += n;
+            dest += n;
+            size -= n;
+        }
+    };
+    std::vector<char> node;
+    for (uint64_t i = 0; i < header.num_nodes; ++i) {
+        uint64_t record[2];
+        read(reinterpret_cast<char*>(record), sizeof record);
+        if (record[0] < sizeof(SlabAlloc::Header) || record[0] + record[1] > header.to_file_size)
+            throw InvalidDatabase("Corrupted backup delta file", std::string(delta_path));
+        node.resize(size_t(record[1]));
+        read(node.data(), node.size());
+        backup.write(File::SizeType(record[0]), node.data(), node.size());
+    }
+    backup.resize(header.to_file_size);
+    backup.sync();
+
+    // Switch to the new top ref the same way as a commit does, so that a
+    // crash leaves either the old or the new version of the backup
+    int new_slot = 1 - slot;
+    file_header.m_top_ref[new_slot] = header.to_top_ref;
+    file_header.m_file_format[new_slot] = uint8_t(header.file_format);
+    backup.write(0, reinterpret_cast<const char*>(&file_header), sizeof file_header);
+    backup.sync();
+    file_header.m_flags = uint8_t((file_header.m_flags & ~SlabAlloc::flags_SelectBit) | new_slot);
+    backup.write(0, reinterpret_cast<const char*>(&file_header), sizeof file_header);
+    backup.sync();
+}
+
 uint_fast64_t DB::get_number_of_versions()
 {
     if (m_fake_read_lock_if_immutable)
@@ -1938,6 +2336,9 @@ void DB::close(bool allow_open_read_transactions)
 {
     // make helper thread(s) terminate
     m_commit_helper.reset();
+    // release the read lock held by the cache
+    if (m_query_cache)
+        m_query_cache->clear();
 
     if (m_fake_read_lock_if_immutable) {
         if (!is_attached())
@@ -2136,6 +2537,20 @@ bool DB::has_changed(TransactionRef& tr)
 bool DB::wait_for_change(TransactionRef& tr)
 {
     REALM_ASSERT(!m_fake_read_lock_if_immutable);
+    if (g_have_futex) {
+        while (true) {
+            // Read the counter before checking, so that a change made after the
+            // check makes the wait return immediately
+            uint32_t counter = m_info->change_counter.load();
+            {
+                std::lock_guard<InterprocessMutex> lock(m_controlmutex);
+                bool changed = tr->m_read_lock.m_version != m_info->latest_version_number;
+                if (changed || !m_wait_for_change_enabled)
+                    return changed;
+            }
+            wait_for_change_counter(m_info->change_counter, m_info->change_waiters, counter);
+        }
+    }
     std::lock_guard<InterprocessMutex> lock(m_controlmutex);
     while (tr->m_read_lock.m_version == m_info->latest_version_number && m_wait_for_change_enabled) {
         m_new_commit_available.wait(m_controlmutex, 0);
@@ -2148,9 +2563,15 @@ void DB::wait_for_change_release()
 {
     if (m_fake_read_lock_if_immutable)
         return;
-    std::lock_guard<InterprocessMutex> lock(m_controlmutex);
-    m_wait_for_change_enabled = false;
-    m_new_commit_available.notify_all();
+    {
+        std::lock_guard<InterprocessMutex> lock(m_controlmutex);
+        m_wait_for_change_enabled = false;
+        m_new_commit_available.notify_all();
+    }
+    // This also wakes up waiters in other processes, which will find that
+    // nothing has changed and go back to sleep
+    if (g_have_futex)
+        notify_change_counter(m_info->change_counter, m_info->change_waiters);
 }
 
 
@@ -2161,6 +2582,50 @@ void DB::enable_wait_for_change()
     m_wait_for_change_enabled = true;
 }
 
+std::unique_ptr<DB::ChangeNotifier> DB::make_change_notifier()
+{
+    if (!g_have_futex || m_in_memory_info || !m_info)
+        return nullptr;
+    return std::unique_ptr<ChangeNotifier>(new ChangeNotifier(get_core_file(m_db_path, CoreFileType::Lock)));
+}
+
+DB::ChangeNotifier::ChangeNotifier(const std::string& lockfile_path)
+{
+    m_file.open(lockfile_path, File::access_ReadWrite, File::create_Never, 0); // Throws
+    // Holding a shared lock prevents the lock file from being reinitialized,
+    // which would reset the counters, if all DBs using it are closed.
+    m_file.rw_lock_shared();                                       // Throws
+    m_map.map(m_file, File::access_ReadWrite, sizeof(SharedInfo)); // Throws
+    m_last_seen = m_map.get_addr()->change_counter.load();
+}
+
+DB::ChangeNotifier::~ChangeNotifier() noexcept
+{
+    m_map.unmap();
+    m_file.rw_unlock();
+}
+
+bool DB::ChangeNotifier::wait()
+{
+    SharedInfo* info = m_map.get_addr();
+    if (!m_released)
+        wait_for_change_counter(info->change_counter, info->change_waiters, m_last_seen);
+    m_last_seen = info->change_counter.load();
+    return !m_released;
+}
+
+void DB::ChangeNotifier::notify() noexcept
+{
+    SharedInfo* info = m_map.get_addr();
+    notify_change_counter(info->change_counter, info->change_waiters);
+}
+
+void DB::ChangeNotifier::release() noexcept
+{
+    m_released = true;
+    notify();
+}
+
 bool DB::needs_file_format_upgrade(const std::string& file, Span<const char> encryption_key)
 {
     SlabAlloc alloc;
@@ -2523,6 +2988,7 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
 
     GroupWriter out(transaction, Durability(info->durability), m_marker_observer.get()); // Throws
     out.set_versions(new_version, top_refs, any_new_unreachables);
+    out.set_commit_write_mode(m_commit_write_mode);
     out.prepare_evacuation();
     auto t1 = std::chrono::steady_clock::now();
     auto commit_size = m_alloc.get_commit_size();
@@ -2588,6 +3054,8 @@ void DB::low_level_commit(uint_fast64_t new_version, Transaction& transaction, b
 
         m_new_commit_available.notify_all();
     }
+    if (g_have_futex)
+        notify_change_counter(info->change_counter, info->change_waiters);
     auto t2 = std::chrono::steady_clock::now();
     if (m_logger) {
         std::string to_disk_str = commit_to_disk ? util::format(" ref %1", new_top_ref) : " (no commit to disk)";
@@ -2779,11 +3247,15 @@ void DB::async_request_write_mutex(TransactionRef& tr, util::UniqueFunction<void
 
 inline DB::DB(Private, const DBOptions& options)
     : m_upgrade_callback(std::move(options.upgrade_callback))
+    , m_commit_write_mode(options.commit_write_mode)
     , m_log_id(util::gen_log_id(this))
 {
     if (options.enable_async_writes) {
         m_commit_helper = std::make_unique<AsyncCommitHelper>(this);
     }
+    if (options.query_cache_size) {
+        m_query_cache = std::make_unique<QueryResultCache>(*this, options.query_cache_size);
+    }
 }
 
 DBRef DB::create(const std::string& file, const DBOptions& options) NO_THREAD_SAFETY_ANALYSIS
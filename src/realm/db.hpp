@@ -40,6 +40,7 @@
 
 namespace realm {
 
+class QueryResultCache;
 class Transaction;
 using TransactionRef = std::shared_ptr<Transaction>;
 
@@ -195,6 +196,13 @@ public:
         return m_db_path;
     }
 
+    /// The cache of query results enabled by DBOptions::query_cache_size, or
+    /// null if disabled.
+    QueryResultCache* get_query_cache() const noexcept
+    {
+        return m_query_cache.get();
+    }
+
 #ifdef REALM_DEBUG
     /// Deprecated method, only called from a unit test
     ///
@@ -241,6 +249,18 @@ public:
 
     /// re-enable waiting for change
     void enable_wait_for_change();
+
+    /// Cross-process notification of commits, for threads which deliver change
+    /// notifications. The lock file holds a counter which is incremented by
+    /// every commit, and waiters block on it with a futex, so a commit costs a
+    /// single wake-up no matter how many processes are waiting, and nothing if
+    /// none are. The notifier has its own mapping of the lock file, so it stays
+    /// valid if this DB is closed, and it keeps the session open like a DB does.
+    ///
+    /// Returns null if not supported, i.e. on platforms other than Linux and
+    /// Android, or if there is no lock file.
+    class ChangeNotifier;
+    std::unique_ptr<ChangeNotifier> make_change_notifier();
     // Transactions:
 
     using version_type = _impl::History::version_type;
@@ -329,6 +349,29 @@ public:
 
     void write_copy(std::string_view path, const char* output_encryption_key) REQUIRES(!m_mutex);
 
+    /// Incremental backups.
+    ///
+    /// write_backup() writes the version accessed by `tr` to a new file at
+    /// `path`. Unlike write_copy(), every node is written at the same position
+    /// as in this file, and space which is free in that version is left as
+    /// holes. The result is a regular (unencrypted) Realm file. The nodes are
+    /// written by `num_threads` threads in parallel.
+    ///
+    /// write_backup_delta() writes the nodes which are reachable from the
+    /// version accessed by `to`, but not from the version accessed by `from`,
+    /// to a new delta file at `path`. Its cost is proportional to the amount
+    /// of data changed between the two versions, not to the size of the file.
+    /// apply_backup_delta() applies such a delta to a backup of the version of
+    /// `from`, turning it into a backup of the version of `to`.
+    ///
+    /// Both transactions must belong to this DB and be reading or frozen. The
+    /// version of `from` must have been kept alive (e.g. by a frozen
+    /// transaction) since its backup was written, as otherwise the space
+    /// holding it may have been reused.
+    void write_backup(const Transaction& tr, std::string_view path, size_t num_threads = 1);
+    void write_backup_delta(const Transaction& from, const Transaction& to, std::string_view path);
+    static void apply_backup_delta(std::string_view backup_path, std::string_view delta_path);
+
 #ifdef REALM_DEBUG
     void test_ringbuf();
 #endif
@@ -505,6 +548,8 @@ private:
     util::InterprocessCondVar m_pick_next_writer;
     std::function<void(int, int)> m_upgrade_callback;
     std::unique_ptr<AsyncCommitHelper> m_commit_helper;
+    std::unique_ptr<QueryResultCache> m_query_cache;
+    DBOptions::CommitWriteMode m_commit_write_mode = DBOptions::CommitWriteMode::MemoryMap;
     std::shared_ptr<util::Logger> m_logger;
     std::mutex m_commit_listener_mutex;
     std::vector<CommitListener*> m_commit_listeners;
@@ -606,6 +651,9 @@ private:
 
     int get_file_format_version() const noexcept;
 
+    void check_backup_transaction(const Transaction&) const;
+    static void write_backup_header(util::File&, ref_type top_ref, int file_format_version);
+
     /// finish up the process of starting a write transaction. Internal use only.
     void finish_begin_write() REQUIRES(!m_mutex);
 
@@ -623,6 +671,7 @@ private:
 
     friend class SlabAlloc;
     friend class Transaction;
+    friend class QueryResultCache;
 };
 
 inline void DB::get_stats(size_t& free_space, size_t& used_space, size_t* locked_space) const
@@ -685,6 +734,28 @@ private:
     ReadLockInfo* m_read_lock;
 };
 
+class DB::ChangeNotifier {
+public:
+    ~ChangeNotifier() noexcept;
+
+    /// Block until a commit has been made, or notify() has been called, since
+    /// the previous call returned. Returns false once release() has been called.
+    bool wait();
+    /// Wake up the waiters in all processes
+    void notify() noexcept;
+    /// Make pending and future calls to wait() return false
+    void release() noexcept;
+
+private:
+    util::File m_file;
+    util::File::Map<SharedInfo> m_map;
+    uint32_t m_last_seen = 0;
+    std::atomic<bool> m_released = false;
+
+    ChangeNotifier(const std::string& lockfile_path);
+    friend class DB;
+};
+
 inline int DB::get_file_format_version() const noexcept
 {
     return m_file_format_version;
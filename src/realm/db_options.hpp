@@ -106,6 +106,26 @@ struct DBOptions {
     /// will clear and reinitialize the file.
     bool clear_on_invalid_file = false;
 
+    /// If non-zero, results of counts, aggregates and small find_all() queries
+    /// run in read or frozen transactions are cached, using at most this many
+    /// bytes. See QueryResultCache.
+    size_t query_cache_size = 0;
+
+    /// How a commit writes the changed nodes to the file.
+    enum class CommitWriteMode {
+        /// Copy the nodes into writable memory mappings of the file, and
+        /// msync() the mappings.
+        MemoryMap,
+        /// Gather the nodes in memory, merging nodes which are adjacent in
+        /// the file into runs, and write each run with a single positioned
+        /// write followed by one fsync() of the file. This avoids the page
+        /// faults of first touching a writable mapping and syncing whole
+        /// mappings. Encrypted files always use MemoryMap.
+        BatchedWrite,
+    };
+    /// Readers use read-only memory mappings regardless of this setting.
+    CommitWriteMode commit_write_mode = CommitWriteMode::MemoryMap;
+
     /// sys_tmp_dir will be used if the temp_dir is empty when creating DBOptions.
     /// It must be writable and allowed to create pipe/fifo file on it.
     /// set_sys_tmp_dir is not a thread-safe call and it is only supposed to be called once
@@ -22,6 +22,7 @@
 
 #include <external/IntelRDFPMathLib20U2/LIBRARY/src/bid_conf.h>
 #include <external/IntelRDFPMathLib20U2/LIBRARY/src/bid_functions.h>
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
@@ -1793,6 +1794,73 @@ void Decimal128::unpack(Bid128& coefficient, int& exponent, bool& sign) const no
     coefficient.w[1] = get_coefficient_high();
 }
 
+bool Decimal128::Accumulator::scale(Bid128& value, int digits) noexcept
+{
+    if (value.w[0] == 0 && value.w[1] == 0)
+        return true;
+    for (int i = 0; i < digits; i++) {
+        // value * 10 == (value << 3) + (value << 1)
+        Bid128 times8{{value.w[0] << 3, (value.w[1] << 3) | (value.w[0] >> 61)}};
+        Bid128 times2{{value.w[0] << 1, (value.w[1] << 1) | (value.w[0] >> 63)}};
+        value = times8;
+        add_to(value, times2);
+        if (!less(value, max_coefficient))
+            return false;
+    }
+    return true;
+}
+
+void Decimal128::Accumulator::add_slow(const Decimal128& value) noexcept
+{
+    if ((value.m_value.w[1] & MASK_STEERING) != MASK_STEERING) {
+        Bid128 coefficient;
+        int exponent;
+        bool sign;
+        value.unpack(coefficient, exponent, sign);
+        Bid128 positive = m_positive;
+        Bid128 negative = m_negative;
+        Bid128 magnitude = m_magnitude;
+        bool ok = less(coefficient, max_coefficient); // Non canonical coefficients are handled by the library
+        if (ok && exponent < m_exponent) {
+            // The exponent of the sum becomes the smallest exponent seen
+            int digits = m_exponent - exponent;
+            ok = scale(magnitude, digits) && scale(positive, digits) && scale(negative, digits);
+        }
+        else if (ok && exponent > m_exponent) {
+            ok = scale(coefficient, exponent - m_exponent);
+        }
+        if (ok) {
+            add_to(magnitude, coefficient);
+            if (less(magnitude, max_coefficient)) {
+                add_to(sign ? negative : positive, coefficient);
+                m_positive = positive;
+                m_negative = negative;
+                m_magnitude = magnitude;
+                m_exponent = std::min(m_exponent, exponent);
+                return;
+            }
+        }
+    }
+
+    // From here on rounding may occur, so let the library do the work
+    m_fallback = result();
+    m_exact = false;
+    m_fallback += value;
+}
+
+Decimal128 Decimal128::Accumulator::result() const noexcept
+{
+    if (!m_exact)
+        return m_fallback;
+
+    // An exact sum of zero is positive when rounding to nearest
+    bool sign = less(m_positive, m_negative);
+    const Bid128& a = sign ? m_negative : m_positive;
+    const Bid128& b = sign ? m_positive : m_negative;
+    Bid128 coefficient{{a.w[0] - b.w[0], a.w[1] - b.w[1] - (a.w[0] < b.w[0])}};
+    return Decimal128(coefficient, m_exponent, sign);
+}
+
 bool operator==(Decimal128::Bid32 lhs, Decimal128::Bid32 rhs) noexcept
 {
     static constexpr int DECIMAL_COEFF_BITS_32 = 23;
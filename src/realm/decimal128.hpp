@@ -131,6 +131,8 @@ public:
     }
     void unpack(Bid128& coefficient, int& exponent, bool& sign) const noexcept;
 
+    class Accumulator;
+
 private:
     // The high word of a Decimal128 consists of 49 bit coefficient, 14 bit exponent and a sign bit
     static constexpr int DECIMAL_EXPONENT_BIAS_128 = 6176;
@@ -155,6 +157,74 @@ private:
     }
 };
 
+// Computes the same result as repeatedly applying operator+= to a zero
+// initialized Decimal128, but without going through the decimal library for
+// every value. As long as the sum of the magnitudes of the coefficients (scaled
+// to the smallest exponent seen) stays below 10^34, every intermediate result of
+// operator+= is exact and has the smallest exponent as its exponent. In that
+// range the coefficients are accumulated as 128 bit integers and converted back
+// once at the end. Should the range be exceeded (or a value be infinite), the
+// exact sum so far is converted and the remaining values are added through
+// operator+=, which gives a bit identical result.
+class Decimal128::Accumulator {
+public:
+    void add(const Decimal128& value) noexcept
+    {
+        if (!m_exact) {
+            m_fallback += value;
+            return;
+        }
+        uint64_t high = value.m_value.w[1];
+        if ((high & MASK_STEERING) != MASK_STEERING && exponent_of(high) == m_exponent) {
+            // Fast path: same exponent as the running sum
+            Bid128 coefficient{{value.m_value.w[0], high & MASK_COEFF}};
+            Bid128 magnitude = m_magnitude;
+            add_to(magnitude, coefficient);
+            if (less(magnitude, max_coefficient)) {
+                m_magnitude = magnitude;
+                add_to((high & MASK_SIGN) ? m_negative : m_positive, coefficient);
+                return;
+            }
+        }
+        add_slow(value);
+    }
+    void add(const Accumulator& other) noexcept
+    {
+        add(other.result());
+    }
+    Decimal128 result() const noexcept;
+
+private:
+    static constexpr uint64_t MASK_STEERING = 3ull << 61;
+    static constexpr Bid128 max_coefficient = {{0x378d8e6400000000, 0x1ed09bead87c0}}; // 10^34
+
+    bool m_exact = true;
+    int m_exponent = 0;
+    Bid128 m_positive = {{0, 0}};
+    Bid128 m_negative = {{0, 0}};
+    // m_positive + m_negative, always less than 10^34
+    Bid128 m_magnitude = {{0, 0}};
+    Decimal128 m_fallback;
+
+    void add_slow(const Decimal128& value) noexcept;
+    static bool scale(Bid128& value, int digits) noexcept;
+
+    static int exponent_of(uint64_t high) noexcept
+    {
+        return int((high & MASK_EXP) >> DECIMAL_COEFF_HIGH_BITS) - DECIMAL_EXPONENT_BIAS_128;
+    }
+    // Operands are always less than 2^114, so this cannot overflow
+    static void add_to(Bid128& lhs, const Bid128& rhs) noexcept
+    {
+        lhs.w[0] += rhs.w[0];
+        lhs.w[1] += rhs.w[1] + (lhs.w[0] < rhs.w[0]);
+    }
+    static bool less(const Bid128& lhs, const Bid128& rhs) noexcept
+    {
+        return lhs.w[1] < rhs.w[1] || (lhs.w[1] == rhs.w[1] && lhs.w[0] < rhs.w[0]);
+    }
+};
+
 bool operator==(Decimal128::Bid32 lhs, Decimal128::Bid32 rhs) noexcept;
 
 inline std::ostream& operator<<(std::ostream& ostr, const Decimal128& id)
@@ -325,7 +325,7 @@ int Group::get_target_file_format_version_for_session(int current_file_format_ve
     // individual file format versions.
 
     if (requested_history_type == Replication::hist_None) {
-        if (current_file_format_version == 24) {
+        if (current_file_format_version == 25) {
             // We are able to open these file formats in RO mode
             return current_file_format_version;
         }
@@ -482,11 +482,6 @@ void Group::remap_and_update_refs(ref_type new_top_ref, size_t new_file_size, bo
     m_alloc.update_reader_view(new_file_size); // Throws
     update_allocator_wrappers(writable);
 
-    // force update of all ref->ptr translations if the mapping has changed
-    auto mapping_version = m_alloc.get_mapping_version();
-    if (mapping_version != m_last_seen_mapping_version) {
-        m_last_seen_mapping_version = mapping_version;
-    }
     update_refs(new_top_ref);
 }
 
@@ -1296,6 +1291,11 @@ void Group::refresh_dirty_accessors()
         m_table_accessors.resize(m_tables.size());
     }
 
+    // If the file has been remapped, all ref->ptr translations must be redone
+    auto mapping_version = m_alloc.get_mapping_version();
+    bool remapped = mapping_version != m_last_seen_mapping_version;
+    m_last_seen_mapping_version = mapping_version;
+
     // Update all attached table accessors.
     for (size_t i = 0; i < m_table_accessors.size(); ++i) {
         auto& table_accessor = m_table_accessors[i];
@@ -1304,14 +1304,20 @@ void Group::refresh_dirty_accessors()
             // new table. This will detach the old accessor and remove it.
             RefOrTagged rot = m_tables.get_as_ref_or_tagged(i);
             bool same_table = false;
+            bool same_ref = false;
             if (rot.is_ref()) {
                 auto ref = rot.get_as_ref();
                 TableKey new_key = Table::get_key_direct(m_alloc, ref);
                 if (new_key == table_accessor->get_key())
                     same_table = true;
+                same_ref = ref == table_accessor->m_top.get_ref();
             }
             if (same_table) {
-                table_accessor->refresh_accessor_tree();
+                // Both the old and the new version are locked while we get
+                // here, so if the table's top ref is unchanged, so is every
+                // node below it, and the accessor tree is still valid.
+                if (remapped || !same_ref)
+                    table_accessor->refresh_accessor_tree();
             }
             else {
                 table_accessor->detach(Table::cookie_removed);
@@ -590,6 +590,7 @@ private:
     Array m_top;
     Array m_tables;
     ArrayStringShort m_table_names;
+    // Mapping version at the last refresh of the table accessors
     uint64_t m_last_seen_mapping_version = 0;
 
     typedef std::vector<Table*> TableAccessors;
@@ -763,6 +764,9 @@ private:
     ///     Backlinks in BPlusTree
     ///     Sort order of Strings changed (affects sets and the string index)
     ///
+    ///  25 Compact Timestamp leaves storing nanoseconds since epoch in a single
+    ///     integer array.
+    ///
     /// IMPORTANT: When introducing a new file format version, be sure to review
     /// the file validity checks in Group::open() and DB::do_open, the file
     /// format selection logic in
@@ -770,7 +774,7 @@ private:
     /// upgrade logic in Group::upgrade_file_format(), AND the lists of accepted
     /// file formats and the version deletion list residing in "backup_restore.cpp"
 
-    static constexpr int g_current_file_format_version = 24;
+    static constexpr int g_current_file_format_version = 25;
 
     int get_file_format_version() const noexcept;
     void set_file_format_version(int) noexcept;
@@ -0,0 +1,467 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/group_by.hpp>
+
+#include <realm/aggregate_ops.hpp>
+#include <realm/query_engine.hpp>
+#include <realm/table.hpp>
+
+using namespace realm;
+
+namespace {
+
+// Integer division rounding towards negative infinity
+int64_t floor_div(int64_t a, int64_t b)
+{
+    int64_t q = a / b;
+    if ((a % b != 0) && ((a < 0) != (b < 0)))
+        --q;
+    return q;
+}
+
+// Decimals with different exponents may compare equal (1.0 == 1.00), so the
+// hash is computed on the representation with trailing zeros removed.
+size_t decimal_hash(const Decimal128& value)
+{
+    Decimal128::Bid128 coefficient;
+    int exponent;
+    bool sign;
+    value.unpack(coefficient, exponent, sign);
+    if (coefficient.w[1] == 0) {
+        if (coefficient.w[0] == 0)
+            return 0;
+        while (coefficient.w[0] % 10 == 0) {
+            coefficient.w[0] /= 10;
+            ++exponent;
+        }
+    }
+    size_t h = std::hash<uint64_t>()(coefficient.w[0]) ^ (std::hash<uint64_t>()(coefficient.w[1]) << 1);
+    return h ^ (size_t(exponent) << 2) ^ size_t(sign);
+}
+
+} // anonymous namespace
+
+size_t GroupByResult::find(const std::vector<Mixed>& keys) const noexcept
+{
+    if (keys.size() != m_num_keys)
+        return realm::npos;
+    size_t sz = size();
+    for (size_t i = 0; i < sz; ++i) {
+        auto begin = m_keys.begin() + i * m_num_keys;
+        if (std::equal(keys.begin(), keys.end(), begin, [](const Mixed& a, const Mixed& b) {
+                return a.is_null() ? b.is_null() : (!b.is_null() && a.get_type() == b.get_type() && a == b);
+            }))
+            return i;
+    }
+    return realm::npos;
+}
+
+GroupByState::GroupByState(const Table& table, std::vector<GroupByKey> keys,
+                           std::vector<GroupByAggregate> aggregates)
+    : m_group_keys(std::move(keys))
+    , m_buffers(std::make_shared<std::deque<std::string>>())
+{
+    if (m_group_keys.empty()) {
+        throw InvalidArgument("Group by requires at least one key");
+    }
+    for (auto& key : m_group_keys) {
+        table.check_column(key.col_key);
+        if (key.col_key.is_collection() || key.col_key.get_type() == col_type_BackLink) {
+            throw IllegalOperation(util::format("Cannot group by collection property '%1'",
+                                                table.get_column_name(key.col_key)));
+        }
+        if (key.bucket_seconds != 0 && key.col_key.get_type() != col_type_Timestamp) {
+            throw IllegalOperation(util::format("Only timestamp properties can be bucketed, '%1' is of type %2",
+                                                table.get_column_name(key.col_key),
+                                                table.get_column_type(key.col_key)));
+        }
+        if (key.bucket_seconds < 0) {
+            throw InvalidArgument("Bucket interval must be positive");
+        }
+    }
+
+    for (auto& agg : aggregates) {
+        AggregateInfo info{Kind::Count, false, false, type_Int, agg.col_key};
+        if (agg.type != GroupByAggregate::Type::Count) {
+            table.check_column(agg.col_key);
+            if (agg.col_key.is_collection()) {
+                throw IllegalOperation(util::format("Cannot aggregate collection property '%1'",
+                                                    table.get_column_name(agg.col_key)));
+            }
+            info.type = table.get_column_type(agg.col_key);
+            info.is_float = info.type == type_Float;
+        }
+        auto unsupported = [&] {
+            return IllegalOperation(util::format("Aggregate not supported on property '%1' of type %2",
+                                                 table.get_column_name(agg.col_key), info.type));
+        };
+        switch (agg.type) {
+            case GroupByAggregate::Type::Count:
+                break;
+            case GroupByAggregate::Type::Average:
+                info.average = true;
+                [[fallthrough]];
+            case GroupByAggregate::Type::Sum:
+                switch (info.type) {
+                    case type_Int:
+                        info.kind = Kind::SumInt;
+                        break;
+                    case type_Float:
+                    case type_Double:
+                        info.kind = Kind::SumDouble;
+                        break;
+                    case type_Decimal:
+                        info.kind = Kind::SumDecimal;
+                        break;
+                    case type_Mixed:
+                        info.kind = Kind::SumMixed;
+                        break;
+                    default:
+                        throw unsupported();
+                }
+                break;
+            case GroupByAggregate::Type::Min:
+            case GroupByAggregate::Type::Max:
+                switch (info.type) {
+                    case type_Int:
+                    case type_Float:
+                    case type_Double:
+                    case type_Decimal:
+                    case type_Timestamp:
+                    case type_Mixed:
+                        break;
+                    default:
+                        throw unsupported();
+                }
+                info.kind = agg.type == GroupByAggregate::Type::Min ? Kind::Min : Kind::Max;
+                break;
+        }
+        m_aggregates.push_back(info);
+    }
+
+    m_scratch.resize(m_group_keys.size());
+    m_slots.resize(16);
+}
+
+GroupByState::~GroupByState() = default;
+GroupByState::GroupByState(GroupByState&&) noexcept = default;
+GroupByState& GroupByState::operator=(GroupByState&&) noexcept = default;
+
+void GroupByState::set_cluster(const Cluster* cluster)
+{
+    auto& alloc = cluster->get_alloc();
+    if (m_key_leaves.empty()) {
+        for (auto& key : m_group_keys) {
+            m_key_leaves.push_back(TwoColumnsNodeBase::update_cached_leaf_pointers_for_column(alloc, key.col_key));
+        }
+        for (auto& agg : m_aggregates) {
+            if (agg.kind == Kind::Count)
+                m_value_leaves.push_back(nullptr);
+            else
+                m_value_leaves.push_back(
+                    TwoColumnsNodeBase::update_cached_leaf_pointers_for_column(alloc, agg.col_key));
+        }
+    }
+    for (size_t i = 0; i < m_group_keys.size(); ++i) {
+        cluster->init_leaf(m_group_keys[i].col_key, m_key_leaves[i].get());
+    }
+    for (size_t i = 0; i < m_aggregates.size(); ++i) {
+        if (auto& leaf = m_value_leaves[i])
+            cluster->init_leaf(m_aggregates[i].col_key, leaf.get());
+    }
+}
+
+void GroupByState::accumulate(size_t ndx)
+{
+    const size_t num_keys = m_group_keys.size();
+    for (size_t i = 0; i < num_keys; ++i) {
+        m_scratch[i] = normalize_key(i, m_key_leaves[i]->get_any(ndx));
+    }
+    size_t group = find_or_create_group(m_scratch.data(), hash_keys(m_scratch.data(), num_keys));
+    Partial* partials = &m_partials[group * m_aggregates.size()];
+    for (size_t i = 0; i < m_aggregates.size(); ++i) {
+        auto& info = m_aggregates[i];
+        accumulate_value(info, partials[i], info.kind == Kind::Count ? Mixed() : m_value_leaves[i]->get_any(ndx));
+    }
+}
+
+void GroupByState::accumulate(const Obj& obj)
+{
+    const size_t num_keys = m_group_keys.size();
+    for (size_t i = 0; i < num_keys; ++i) {
+        m_scratch[i] = normalize_key(i, obj.get_any(m_group_keys[i].col_key));
+    }
+    size_t group = find_or_create_group(m_scratch.data(), hash_keys(m_scratch.data(), num_keys));
+    Partial* partials = &m_partials[group * m_aggregates.size()];
+    for (size_t i = 0; i < m_aggregates.size(); ++i) {
+        auto& info = m_aggregates[i];
+        accumulate_value(info, partials[i], info.kind == Kind::Count ? Mixed() : obj.get_any(info.col_key));
+    }
+}
+
+void GroupByState::merge(const GroupByState& other)
+{
+    REALM_ASSERT(other.m_group_keys.size() == m_group_keys.size());
+    REALM_ASSERT(other.m_aggregates.size() == m_aggregates.size());
+    const size_t num_keys = m_group_keys.size();
+    const size_t num_aggregates = m_aggregates.size();
+    for (size_t g = 0; g < other.m_num_groups; ++g) {
+        size_t group = find_or_create_group(&other.m_keys[g * num_keys], other.m_hashes[g]);
+        for (size_t i = 0; i < num_aggregates; ++i) {
+            merge_partial(m_aggregates[i], m_partials[group * num_aggregates + i],
+                          other.m_partials[g * num_aggregates + i]);
+        }
+    }
+}
+
+GroupByResult GroupByState::finalize() const
+{
+    GroupByResult result;
+    result.m_num_keys = m_group_keys.size();
+    result.m_num_aggregates = m_aggregates.size();
+    result.m_keys = m_keys;
+    result.m_buffers = m_buffers;
+    result.m_values.reserve(m_num_groups * m_aggregates.size());
+    for (size_t g = 0; g < m_num_groups; ++g) {
+        for (size_t i = 0; i < m_aggregates.size(); ++i) {
+            result.m_values.push_back(this->result(m_aggregates[i], m_partials[g * m_aggregates.size() + i]));
+        }
+    }
+    return result;
+}
+
+Mixed GroupByState::normalize_key(size_t key_ndx, Mixed value) const
+{
+    if (auto interval = m_group_keys[key_ndx].bucket_seconds; interval && !value.is_null()) {
+        auto ts = value.get_timestamp();
+        // A negative nanosecond part means that the value lies before the whole second
+        int64_t seconds = ts.get_nanoseconds() < 0 ? ts.get_seconds() - 1 : ts.get_seconds();
+        return Timestamp(floor_div(seconds, interval) * interval, 0);
+    }
+    return value;
+}
+
+size_t GroupByState::hash_keys(const Mixed* keys, size_t num_keys) noexcept
+{
+    size_t hash = 0;
+    for (size_t i = 0; i < num_keys; ++i) {
+        const Mixed& key = keys[i];
+        size_t h = 0;
+        if (!key.is_null()) {
+            switch (key.get_type()) {
+                case type_Link:
+                    h = std::hash<int64_t>()(key.get<ObjKey>().value);
+                    break;
+                case type_Float:
+                case type_Double: {
+                    // 0.0 and -0.0 compare equal, so they must hash equally
+                    double d = key.get_type() == type_Float ? double(key.get_float()) : key.get_double();
+                    h = d == 0 ? 0 : std::hash<double>()(d);
+                    break;
+                }
+                case type_Decimal:
+                    h = decimal_hash(key.get_decimal());
+                    break;
+                default:
+                    h = key.hash();
+                    break;
+            }
+            h += size_t(key.get_type()) + 1;
+        }
+        hash ^= h + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
+bool GroupByState::keys_equal(const Mixed* a, const Mixed* b, size_t num_keys) noexcept
+{
+    for (size_t i = 0; i < num_keys; ++i) {
+        if (a[i].is_null() || b[i].is_null()) {
+            if (a[i].is_null() != b[i].is_null())
+                return false;
+        }
+        else if (a[i].get_type() != b[i].get_type() || a[i].compare(b[i]) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t GroupByState::find_or_create_group(const Mixed* keys, size_t hash)
+{
+    const size_t num_keys = m_group_keys.size();
+    size_t mask = m_slots.size() - 1;
+    size_t pos = hash & mask;
+    while (size_t slot = m_slots[pos]) {
+        size_t group = slot - 1;
+        if (m_hashes[group] == hash && keys_equal(&m_keys[group * num_keys], keys, num_keys))
+            return group;
+        pos = (pos + 1) & mask;
+    }
+
+    size_t group = m_num_groups++;
+    m_slots[pos] = group + 1;
+    m_hashes.push_back(hash);
+    for (size_t i = 0; i < num_keys; ++i) {
+        Mixed key = keys[i];
+        if (!key.is_null() && (key.get_type() == type_String || key.get_type() == type_Binary)) {
+            // Keys may point into the mapped file, so take a private copy
+            key.use_buffer(m_buffers->emplace_back());
+        }
+        m_keys.push_back(key);
+    }
+    m_partials.resize(m_num_groups * m_aggregates.size());
+
+    if (m_num_groups * 2 > m_slots.size())
+        grow();
+    return group;
+}
+
+void GroupByState::grow()
+{
+    std::vector<size_t> slots(m_slots.size() * 2);
+    size_t mask = slots.size() - 1;
+    for (size_t group = 0; group < m_num_groups; ++group) {
+        size_t pos = m_hashes[group] & mask;
+        while (slots[pos])
+            pos = (pos + 1) & mask;
+        slots[pos] = group + 1;
+    }
+    m_slots = std::move(slots);
+}
+
+void GroupByState::accumulate_value(const AggregateInfo& info, Partial& partial, Mixed value)
+{
+    using namespace aggregate_operations;
+    switch (info.kind) {
+        case Kind::Count:
+            ++partial.count;
+            break;
+        case Kind::SumInt:
+            if (!value.is_null()) {
+                partial.int_sum = int64_t(uint64_t(partial.int_sum) + uint64_t(value.get_int()));
+                ++partial.count;
+            }
+            break;
+        case Kind::SumDouble:
+            if (!value.is_null()) {
+                double d = info.is_float ? double(value.get_float()) : value.get_double();
+                if (valid_for_agg(d)) {
+                    partial.double_sum += d;
+                    ++partial.count;
+                }
+            }
+            break;
+        case Kind::SumDecimal:
+            if (!value.is_null()) {
+                auto d = value.get_decimal();
+                if (valid_for_agg(d)) {
+                    partial.decimal_accumulator.add(d);
+                    ++partial.count;
+                }
+            }
+            break;
+        case Kind::SumMixed:
+            if (value.accumulate_numeric_to(partial.decimal_sum))
+                ++partial.count;
+            break;
+        case Kind::Min:
+        case Kind::Max:
+            if (valid_for_agg(value)) {
+                if ((value.get_type() == type_Float && std::isnan(value.get_float())) ||
+                    (value.get_type() == type_Double && std::isnan(value.get_double())))
+                    break;
+                if (partial.minmax.is_null() ||
+                    (info.kind == Kind::Min ? value < partial.minmax : value > partial.minmax)) {
+                    partial.minmax = value;
+                }
+                ++partial.count;
+            }
+            break;
+    }
+}
+
+void GroupByState::merge_partial(const AggregateInfo& info, Partial& partial, const Partial& other)
+{
+    switch (info.kind) {
+        case Kind::Count:
+            break;
+        case Kind::SumInt:
+            partial.int_sum = int64_t(uint64_t(partial.int_sum) + uint64_t(other.int_sum));
+            break;
+        case Kind::SumDouble:
+            partial.double_sum += other.double_sum;
+            break;
+        case Kind::SumDecimal:
+            partial.decimal_accumulator.add(other.decimal_accumulator);
+            break;
+        case Kind::SumMixed:
+            partial.decimal_sum += other.decimal_sum;
+            break;
+        case Kind::Min:
+        case Kind::Max:
+            if (!other.minmax.is_null() &&
+                (partial.minmax.is_null() ||
+                 (info.kind == Kind::Min ? other.minmax < partial.minmax : other.minmax > partial.minmax))) {
+                partial.minmax = other.minmax;
+            }
+            break;
+    }
+    partial.count += other.count;
+}
+
+Mixed GroupByState::result(const AggregateInfo& info, const Partial& partial)
+{
+    switch (info.kind) {
+        case Kind::Count:
+            return int64_t(partial.count);
+        case Kind::SumInt:
+            if (info.average)
+                return partial.count ? Mixed(double(partial.int_sum) / partial.count) : Mixed();
+            return partial.int_sum;
+        case Kind::SumDouble:
+            if (info.average)
+                return partial.count ? Mixed(partial.double_sum / partial.count) : Mixed();
+            return partial.double_sum;
+        case Kind::SumDecimal:
+        case Kind::SumMixed: {
+            auto sum = info.kind == Kind::SumDecimal ? partial.decimal_accumulator.result() : partial.decimal_sum;
+            if (info.average)
+                return partial.count ? Mixed(sum / partial.count) : Mixed();
+            return sum;
+        }
+        case Kind::Min:
+        case Kind::Max:
+            return partial.minmax;
+    }
+    REALM_UNREACHABLE();
+}
+
+GroupBy::GroupBy(const Query& query, std::vector<GroupByKey> keys)
+    : m_query(query)
+    , m_keys(std::move(keys))
+{
+}
+
+GroupByState GroupBy::aggregate_partial(std::vector<GroupByAggregate> aggregates) const
+{
+    GroupByState state(*m_query.get_table(), m_keys, std::move(aggregates));
+    m_query.do_group_by(state);
+    return state;
+}
@@ -0,0 +1,259 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_GROUP_BY_HPP
+#define REALM_GROUP_BY_HPP
+
+#include <realm/decimal128.hpp>
+#include <realm/keys.hpp>
+#include <realm/mixed.hpp>
+#include <realm/query.hpp>
+#include <realm/query_state.hpp>
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace realm {
+
+class ArrayPayload;
+class Cluster;
+class Obj;
+
+// A column to group by. Timestamp columns may be bucketed into fixed intervals
+// (counted from the UNIX epoch), so that e.g. all events within the same hour
+// end up in the same group.
+struct GroupByKey {
+    GroupByKey(ColKey col)
+        : col_key(col)
+    {
+    }
+
+    static GroupByKey bucketed(ColKey col, int64_t interval_seconds)
+    {
+        GroupByKey key(col);
+        key.bucket_seconds = interval_seconds;
+        return key;
+    }
+
+    ColKey col_key;
+    // If non-zero, timestamps are truncated to a multiple of this many seconds
+    int64_t bucket_seconds = 0;
+};
+
+// An aggregate computed per group. The result types follow those of the
+// scalar aggregates on Query, i.e. sum of an int column is an int, average of
+// an int column is a double etc. `count()` counts the objects in the group.
+struct GroupByAggregate {
+    enum class Type { Count, Sum, Min, Max, Average };
+
+    static GroupByAggregate count()
+    {
+        return {Type::Count, ColKey()};
+    }
+    static GroupByAggregate sum(ColKey col)
+    {
+        return {Type::Sum, col};
+    }
+    static GroupByAggregate min(ColKey col)
+    {
+        return {Type::Min, col};
+    }
+    static GroupByAggregate max(ColKey col)
+    {
+        return {Type::Max, col};
+    }
+    static GroupByAggregate avg(ColKey col)
+    {
+        return {Type::Average, col};
+    }
+
+    Type type;
+    ColKey col_key;
+};
+
+// The finalized result of a grouped aggregation. Groups are reported in the
+// order in which they were first encountered. The result owns all string and
+// binary keys, so it stays valid after the transaction has ended.
+class GroupByResult {
+public:
+    size_t size() const noexcept
+    {
+        return m_num_keys ? m_keys.size() / m_num_keys : 0;
+    }
+    size_t num_keys() const noexcept
+    {
+        return m_num_keys;
+    }
+    size_t num_aggregates() const noexcept
+    {
+        return m_num_aggregates;
+    }
+    Mixed get_key(size_t group_ndx, size_t key_ndx = 0) const
+    {
+        return m_keys[group_ndx * m_num_keys + key_ndx];
+    }
+    Mixed get_value(size_t group_ndx, size_t aggregate_ndx = 0) const
+    {
+        return m_values[group_ndx * m_num_aggregates + aggregate_ndx];
+    }
+    // Returns the index of the group with the given keys or realm::npos
+    size_t find(const std::vector<Mixed>& keys) const noexcept;
+
+private:
+    friend class GroupByState;
+
+    size_t m_num_keys = 0;
+    size_t m_num_aggregates = 0;
+    std::vector<Mixed> m_keys;
+    std::vector<Mixed> m_values;
+    std::shared_ptr<std::deque<std::string>> m_buffers;
+};
+
+// The partial state of a grouped aggregation. It is a hash aggregate over an
+// open addressing table storing keys and partial aggregates in flat arrays.
+// Partial states computed by different workers (e.g. over frozen transactions
+// of the same version) may be combined with merge() before finalizing.
+class GroupByState {
+public:
+    GroupByState(const Table& table, std::vector<GroupByKey> keys, std::vector<GroupByAggregate> aggregates);
+    ~GroupByState();
+
+    GroupByState(GroupByState&&) noexcept;
+    GroupByState& operator=(GroupByState&&) noexcept;
+
+    // Attach to the leaves of a cluster. Subsequent calls to accumulate(size_t)
+    // will read values from position 'ndx' in the cluster.
+    void set_cluster(const Cluster* cluster);
+    void accumulate(size_t ndx);
+    void accumulate(const Obj& obj);
+
+    void merge(const GroupByState& other);
+    size_t size() const noexcept
+    {
+        return m_num_groups;
+    }
+
+    GroupByResult finalize() const;
+
+private:
+    enum class Kind : uint8_t {
+        Count,
+        SumInt,
+        SumDouble,
+        SumDecimal,
+        SumMixed,
+        Min,
+        Max,
+    };
+
+    struct Partial {
+        int64_t int_sum = 0;
+        double double_sum = 0;
+        Decimal128 decimal_sum = {};
+        Decimal128::Accumulator decimal_accumulator;
+        Mixed minmax;
+        size_t count = 0;
+    };
+
+    struct AggregateInfo {
+        Kind kind;
+        bool average;
+        bool is_float;
+        DataType type;
+        ColKey col_key;
+    };
+
+    std::vector<GroupByKey> m_group_keys;
+    std::vector<AggregateInfo> m_aggregates;
+
+    // Leaves of the current cluster
+    std::vector<std::unique_ptr<ArrayPayload>> m_key_leaves;
+    std::vector<std::unique_ptr<ArrayPayload>> m_value_leaves;
+
+    // Hash table
+    size_t m_num_groups = 0;
+    std::vector<size_t> m_slots; // group index + 1, or 0 if empty
+    std::vector<size_t> m_hashes;
+    std::vector<Mixed> m_keys;
+    std::vector<Partial> m_partials;
+    std::shared_ptr<std::deque<std::string>> m_buffers;
+
+    std::vector<Mixed> m_scratch;
+
+    Mixed normalize_key(size_t key_ndx, Mixed value) const;
+    size_t find_or_create_group(const Mixed* keys, size_t hash);
+    void grow();
+    static size_t hash_keys(const Mixed* keys, size_t num_keys) noexcept;
+    static bool keys_equal(const Mixed* a, const Mixed* b, size_t num_keys) noexcept;
+    static void accumulate_value(const AggregateInfo& info, Partial& partial, Mixed value);
+    static void merge_partial(const AggregateInfo& info, Partial& partial, const Partial& other);
+    static Mixed result(const AggregateInfo& info, const Partial& partial);
+};
+
+// Feeds the matches found by the query engine into a GroupByState
+class QueryStateGroupBy : public QueryStateBase {
+public:
+    explicit QueryStateGroupBy(GroupByState& state)
+        : m_state(state)
+    {
+    }
+    bool match(size_t index, Mixed) noexcept final
+    {
+        m_state.accumulate(index);
+        ++m_match_count;
+        return true;
+    }
+    bool match(size_t index) noexcept final
+    {
+        m_state.accumulate(index);
+        ++m_match_count;
+        return true;
+    }
+
+private:
+    GroupByState& m_state;
+};
+
+// Grouped aggregation over the objects matching a query.
+//
+//    auto result = table->where().greater(col_amount, 0).group_by({col_customer}).aggregate(
+//        {GroupByAggregate::sum(col_amount), GroupByAggregate::count()});
+//
+class GroupBy {
+public:
+    GroupBy(const Query& query, std::vector<GroupByKey> keys);
+
+    // Compute the partial aggregation state, which can be merged with partial
+    // states computed elsewhere.
+    GroupByState aggregate_partial(std::vector<GroupByAggregate> aggregates) const;
+
+    GroupByResult aggregate(std::vector<GroupByAggregate> aggregates) const
+    {
+        return aggregate_partial(std::move(aggregates)).finalize();
+    }
+
+private:
+    Query m_query;
+    std::vector<GroupByKey> m_keys;
+};
+
+} // namespace realm
+
+#endif // REALM_GROUP_BY_HPP
@@ -28,6 +28,7 @@
 #include <realm/disable_sync_to_disk.hpp>
 #include <realm/impl/destroy_guard.hpp>
 #include <realm/impl/simulated_failure.hpp>
+#include <realm/util/buffer.hpp>
 #include <realm/util/safe_int_ops.hpp>
 
 using namespace realm;
@@ -63,6 +64,73 @@ private:
     GroupWriter& m_owner;
     SlabAlloc& m_alloc;
 };
+
+// Gathers the arrays written by a commit in memory and writes them to the
+// file with positioned writes. Arrays which are adjacent in the file are
+// merged into runs which are written with a single call.
+class BatchedFileWriter : public _impl::ArrayWriterBase {
+public:
+    BatchedFileWriter(GroupWriter& owner)
+        : m_owner(owner)
+        , m_file(owner.m_alloc.get_file())
+    {
+    }
+    ref_type write_array(const char* data, size_t size, uint32_t checksum) override
+    {
+        size_t pos = m_owner.get_free_space(size);
+
+        char* dest_addr = append(pos, size); // Throws
+        memcpy(dest_addr, &checksum, 4);
+        memcpy(dest_addr + 4, data + 4, size - 4);
+        return to_ref(pos);
+    }
+    // Get room for 'size' bytes to be written at 'pos'. The memory is valid
+    // until the next call.
+    char* append(size_t pos, size_t size)
+    {
+        if (m_buffer.size() + size > s_max_buffer_size && m_buffer.size() > 0)
+            flush(); // Throws
+        size_t offset = m_buffer.size();
+        if (!m_runs.empty() && m_runs.back().pos + m_runs.back().size == pos) {
+            m_runs.back().size += size;
+        }
+        else {
+            m_runs.push_back({pos, offset, size}); // Throws
+        }
+        m_buffer.resize(offset + size); // Throws
+        return m_buffer.data() + offset;
+    }
+    // Translate a ref within the most recently appended range
+    char* translate(ref_type ref)
+    {
+        auto& run = m_runs.back();
+        REALM_ASSERT_DEBUG(ref >= run.pos && ref < run.pos + run.size);
+        return m_buffer.data() + run.offset + (ref - run.pos);
+    }
+    void flush()
+    {
+        for (auto& run : m_runs) {
+            m_file.write(run.pos, m_buffer.data() + run.offset, run.size); // Throws
+        }
+        m_runs.clear();
+        m_buffer.clear();
+    }
+
+private:
+    // Limits the memory used for commits with many changes
+    static constexpr size_t s_max_buffer_size = 16 * 1024 * 1024;
+
+    struct Run {
+        size_t pos;
+        size_t offset;
+        size_t size;
+    };
+
+    GroupWriter& m_owner;
+    util::File& m_file;
+    util::AppendBuffer<char> m_buffer;
+    std::vector<Run> m_runs;
+};
 } // namespace realm
 
 
@@ -229,6 +297,103 @@ WriteWindowMgr::WriteWindowMgr(SlabAlloc& alloc, Durability dura, WriteMarker* w
 #endif
 }
 
+void FreeSpaceBins::reserve(size_t num_chunks)
+{
+    m_chunks.reserve(num_chunks);
+}
+
+void FreeSpaceBins::clear() noexcept
+{
+    m_chunks.clear();
+    m_unused = npos;
+    m_count = 0;
+    m_heads.fill(npos);
+    m_non_empty.fill(0);
+}
+
+size_t FreeSpaceBins::size_class(size_t size) noexcept
+{
+    if (size < exact_limit)
+        return size / 8;
+    // Four classes per power of two, selected by the two bits after the top bit
+    size_t top_bit = size_t(log2(size));
+    size_t sub_class = (size >> (top_bit - 2)) & 3;
+    return num_exact_classes + (top_bit - exact_limit_log2) * 4 + sub_class;
+}
+
+size_t FreeSpaceBins::next_non_empty(size_t cls) const noexcept
+{
+    size_t word_ndx = cls / bits_per_word;
+    if (word_ndx >= num_bitmap_words)
+        return num_classes;
+    // Ignore the classes before 'cls' in the first word
+    size_t word = m_non_empty[word_ndx] & (~size_t(0) << (cls % bits_per_word));
+    while (word == 0) {
+        if (++word_ndx == num_bitmap_words)
+            return num_classes;
+        word = m_non_empty[word_ndx];
+    }
+    return word_ndx * bits_per_word + size_t(ctz(word));
+}
+
+FreeSpaceBins::Handle FreeSpaceBins::insert(size_t size, size_t pos)
+{
+    Handle h;
+    if (m_unused != npos) {
+        h = m_unused;
+        m_unused = m_chunks[h].next;
+    }
+    else {
+        REALM_ASSERT_RELEASE(m_chunks.size() < npos);
+        h = Handle(m_chunks.size());
+        m_chunks.emplace_back(); // Throws
+    }
+    size_t cls = size_class(size);
+    Handle head = m_heads[cls];
+    m_chunks[h] = {size, pos, npos, head};
+    if (head != npos)
+        m_chunks[head].prev = h;
+    m_heads[cls] = h;
+    m_non_empty[cls / bits_per_word] |= size_t(1) << (cls % bits_per_word);
+    ++m_count;
+    return h;
+}
+
+void FreeSpaceBins::erase(Handle h) noexcept
+{
+    Chunk& chunk = m_chunks[h];
+    if (chunk.prev != npos) {
+        m_chunks[chunk.prev].next = chunk.next;
+    }
+    else {
+        size_t cls = size_class(chunk.size);
+        m_heads[cls] = chunk.next;
+        if (chunk.next == npos)
+            m_non_empty[cls / bits_per_word] &= ~(size_t(1) << (cls % bits_per_word));
+    }
+    if (chunk.next != npos)
+        m_chunks[chunk.next].prev = chunk.prev;
+    chunk.next = m_unused;
+    m_unused = h;
+    --m_count;
+}
+
+FreeSpaceBins::Handle FreeSpaceBins::largest() const noexcept
+{
+    for (size_t word_ndx = num_bitmap_words; word_ndx > 0; --word_ndx) {
+        if (size_t word = m_non_empty[word_ndx - 1]) {
+            size_t cls = (word_ndx - 1) * bits_per_word + size_t(log2(word));
+            Handle best = m_heads[cls];
+            for (Handle h = m_chunks[best].next; h != npos; h = m_chunks[h].next) {
+                if (m_chunks[h].size > m_chunks[best].size)
+                    best = h;
+            }
+            return best;
+        }
+    }
+    return npos;
+}
+
 GroupCommitter::GroupCommitter(Transaction& group, Durability dura, WriteMarker* write_marker)
     : m_group(group)
     , m_alloc(group.m_alloc)
@@ -305,8 +470,24 @@ GroupWriter::GroupWriter(Transaction& group, Durability dura, WriteMarker* write
 }
 
 
+void GroupWriter::set_commit_write_mode(DBOptions::CommitWriteMode mode)
+{
+    bool batched = mode == DBOptions::CommitWriteMode::BatchedWrite && !m_alloc.is_in_memory() &&
+                   !m_alloc.get_file().get_encryption();
+    if (batched)
+        m_batched_writer = std::make_unique<BatchedFileWriter>(*this); // Throws
+    else
+        m_batched_writer.reset();
+}
+
 void GroupWriter::sync_according_to_durability()
 {
+    if (m_batched_writer) {
+        // Everything has been written to the file by write_group()
+        if (m_durability == Durability::Full && !get_disable_sync_to_disk())
+            m_alloc.get_file().sync(); // Throws
+        return;
+    }
     switch (m_durability) {
         case Durability::Full:
         case Durability::Unsafe:
@@ -649,6 +830,11 @@ ref_type GroupWriter::write_group()
 
     read_in_freelist();
     // Now, 'm_size_map' holds all free elements candidate for recycling
+    m_placement_cursor = FreeSpaceBins::npos;
+    // While evacuating, the space below the evacuation limit is best packed
+    // tightly, so nodes are placed by best fit only
+    m_use_placement_policy = (get_evacuation_limit() == 0);
+    m_bytes_to_place = m_alloc.get_commit_size();
 
     Array& top = m_group.m_top;
     ALLOC_DBG_COUT("  Allocating file space for data:" << std::endl);
@@ -666,6 +852,9 @@ ref_type GroupWriter::write_group()
         in_memory_writer = std::make_unique<InMemoryWriter>(*this);
         writer = in_memory_writer.get();
     }
+    else if (m_batched_writer) {
+        writer = m_batched_writer.get();
+    }
     ref_type names_ref = m_group.m_table_names.write(*writer, deep, only_if_modified); // Throws
     ref_type tables_ref = m_group.m_tables.write(*writer, deep, only_if_modified);     // Throws
 
@@ -711,8 +900,16 @@ ref_type GroupWriter::write_group()
             top.set(Group::s_evacuation_point_ndx, 0);
         }
     }
+    if (m_batched_writer) {
+        // Arrays written above may be read back below (e.g. the evacuation
+        // point array is destroyed when the logical file size is reduced)
+        m_batched_writer->flush(); // Throws
+    }
+
+    // The cursor may be invalidated when the free list is modified below
+    m_placement_cursor = FreeSpaceBins::npos;
 
-    ALLOC_DBG_COUT("  Freelist size after allocations: " << m_size_map.size() << std::endl);
+    ALLOC_DBG_COUT("  Freelist size after allocations: " << m_size_map.count() << std::endl);
     // We now back-date (if possible) any blocks freed in versions which
     // are becoming unreachable.
     if (m_any_new_unreachables)
@@ -724,7 +921,7 @@ ref_type GroupWriter::write_group()
     // calculate an upper bound on the amount af space required for all of the
     // remaining arrays and allocate the space as one big chunk. This way we can
     // finalize the free-lists before writing them to the file.
-    size_t max_free_list_size = m_size_map.size();
+    size_t max_free_list_size = m_size_map.count();
 
     // We need to add to the free-list any space that was freed during the
     // current transaction, but to avoid clobering the previous version, we
@@ -767,8 +964,8 @@ ref_type GroupWriter::write_group()
     // using the maximum size possible, we still do not end up with a zero size
     // free-space chunk as we deduct the actually used size from it.
     auto reserve = reserve_free_space(max_free_space_needed + 8); // Throws
-    size_t reserve_pos = reserve->second;
-    size_t reserve_size = reserve->first;
+    size_t reserve_pos = m_size_map.chunk_pos(reserve);
+    size_t reserve_size = m_size_map.chunk_size(reserve);
 
     // Now we can check, if we can reduce the logical file size. This can be done
     // when there is only one block in m_under_evacuation, which means that all
@@ -922,6 +1119,17 @@ ref_type GroupWriter::write_group()
         // Write top
         write_array_at(translator, top_ref, top.get_header(), top_byte_size); // Throws
     }
+    else if (m_batched_writer) {
+        auto translator = m_batched_writer.get();
+        translator->append(reserve_ref, used); // Throws
+        write_array_at(translator, free_positions_ref, m_free_positions.get_header(), free_positions_size); // Throws
+        write_array_at(translator, free_sizes_ref, m_free_lengths.get_header(), free_sizes_size);           // Throws
+        write_array_at(translator, free_versions_ref, m_free_versions.get_header(), free_versions_size);    // Throws
+
+        // Write top
+        write_array_at(translator, top_ref, top.get_header(), top_byte_size); // Throws
+        m_batched_writer->flush();                                            // Throws
+    }
     else {
         MapWindow* window = m_window_mgr.get_window(reserve_ref, end_ref - reserve_ref);
         char* start_addr = window->translate(reserve_ref);
@@ -1024,14 +1232,14 @@ size_t GroupWriter::recreate_freelist(size_t reserve_pos)
     std::vector<FreeSpaceEntry> free_in_file;
     auto& new_free_space = m_group.m_alloc.get_free_read_only(); // Throws
     auto nb_elements =
-        m_size_map.size() + m_not_free_in_file.size() + m_under_evacuation.size() + new_free_space.size();
+        m_size_map.count() + m_not_free_in_file.size() + m_under_evacuation.size() + new_free_space.size();
     free_in_file.reserve(nb_elements);
 
     size_t reserve_ndx = realm::npos;
 
-    for (const auto& entry : m_size_map) {
-        free_in_file.emplace_back(entry.second, entry.first, 0);
-    }
+    m_size_map.for_each([&](size_t size, size_t ref) {
+        free_in_file.emplace_back(ref, size, 0);
+    });
 
     {
         size_t locked_space_size = 0;
@@ -1050,7 +1258,6 @@ size_t GroupWriter::recreate_freelist(size_t reserve_pos)
     for (const auto& elem : m_under_evacuation) {
         free_in_file.emplace_back(elem.ref, elem.size, 0);
     }
-
     REALM_ASSERT(free_in_file.size() == nb_elements);
     std::sort(begin(free_in_file), end(free_in_file), [](auto& a, auto& b) {
         return a.ref < b.ref;
@@ -1125,15 +1332,16 @@ void GroupWriter::merge_adjacent_entries_in_freelist(std::vector<GroupWriter::Fr
 }
 
 void GroupWriter::move_free_in_file_to_size_map(const std::vector<GroupWriter::FreeSpaceEntry>& list,
-                                                std::multimap<size_t, size_t>& size_map)
+                                                FreeSpaceBins& size_map)
 {
     ALLOC_DBG_COUT("  Freelist (true free): ");
+    size_map.reserve(list.size()); // Throws
     for (auto& elem : list) {
         // Skip elements merged in 'merge_adjacent_entries_in_freelist'
         if (elem.size) {
             REALM_ASSERT_RELEASE_EX(!(elem.size & 7), elem.size);
             REALM_ASSERT_RELEASE_EX(!(elem.ref & 7), elem.ref);
-            size_map.emplace(elem.size, elem.ref);
+            size_map.insert(elem.size, elem.ref);
             ALLOC_DBG_COUT("[" << elem.ref << ", " << elem.size << "] ");
         }
     }
@@ -1144,11 +1352,11 @@ size_t GroupWriter::get_free_space(size_t size)
 {
     REALM_ASSERT_3(size % 8, ==, 0); // 8-byte alignment
 
-    auto p = reserve_free_space(size);
+    auto p = reserve_placement(size);
 
     // Claim space from identified chunk
-    size_t chunk_pos = p->second;
-    size_t chunk_size = p->first;
+    size_t chunk_pos = m_size_map.chunk_pos(p);
+    size_t chunk_size = m_size_map.chunk_size(p);
     REALM_ASSERT_3(chunk_size, >=, size);
     REALM_ASSERT_RELEASE_EX(!(chunk_pos & 7), chunk_pos);
     REALM_ASSERT_RELEASE_EX(!(chunk_size & 7), chunk_size);
@@ -1160,37 +1368,75 @@ size_t GroupWriter::get_free_space(size_t size)
         // of the chunk. The call to reserve_free_space may split chunks
         // in order to make sure that it returns a chunk from which allocation
         // can be done from the beginning
-        m_size_map.emplace(rest, chunk_pos + size);
+        m_placement_cursor = m_size_map.insert(rest, chunk_pos + size);
     }
+    m_bytes_to_place -= std::min(m_bytes_to_place, size);
     return chunk_pos;
 }
 
+GroupWriter::FreeListElement GroupWriter::reserve_placement(size_t size)
+{
+    if (!m_use_placement_policy) {
+        return reserve_free_space(size);
+    }
+    auto cursor = m_placement_cursor;
+    if (cursor != FreeSpaceBins::npos) {
+        m_placement_cursor = FreeSpaceBins::npos;
+        // Continue right after the previous array if possible
+        size_t pos = m_size_map.chunk_pos(cursor);
+        size_t chunk_size = m_size_map.chunk_size(cursor);
+        if (chunk_size >= size && m_alloc.find_section_in_range(pos, chunk_size, size) == pos) {
+            return cursor;
+        }
+    }
+    if (m_bytes_to_place > size && !m_size_map.empty()) {
+        // Start a new extent in the smallest chunk which can hold the rest of
+        // the commit, or failing that, in the largest chunk available.
+        size_t extent = std::max(size, std::min(m_bytes_to_place, s_max_extent));
+        auto ret = m_size_map.find(extent, std::numeric_limits<size_t>::max(), [&](FreeListElement it) {
+            return search_free_space_in_free_list_element(it, extent);
+        });
+        if (ret != FreeSpaceBins::npos) {
+            return ret;
+        }
+        auto largest = m_size_map.largest();
+        size_t largest_size = m_size_map.chunk_size(largest);
+        if (largest_size < extent && largest_size >= size) {
+            ret = search_free_space_in_free_list_element(largest, size);
+            if (ret != FreeSpaceBins::npos) {
+                return ret;
+            }
+        }
+    }
+    return reserve_free_space(size);
+}
+
 
 inline GroupWriter::FreeListElement GroupWriter::split_freelist_chunk(FreeListElement it, size_t alloc_pos)
 {
-    size_t start_pos = it->second;
-    size_t chunk_size = it->first;
+    size_t start_pos = m_size_map.chunk_pos(it);
+    size_t chunk_size = m_size_map.chunk_size(it);
     m_size_map.erase(it);
     REALM_ASSERT_RELEASE_EX(alloc_pos > start_pos, alloc_pos, start_pos);
 
     REALM_ASSERT_RELEASE_EX(!(alloc_pos & 7), alloc_pos);
     size_t size_first = alloc_pos - start_pos;
     size_t size_second = chunk_size - size_first;
-    m_size_map.emplace(size_first, start_pos);
-    return m_size_map.emplace(size_second, alloc_pos);
+    m_size_map.insert(size_first, start_pos);
+    return m_size_map.insert(size_second, alloc_pos);
 }
 
 GroupWriter::FreeListElement GroupWriter::search_free_space_in_free_list_element(FreeListElement it, size_t size)
 {
     SlabAlloc& alloc = m_group.m_alloc;
-    size_t chunk_size = it->first;
+    size_t chunk_size = m_size_map.chunk_size(it);
 
     // search through the chunk, finding a place within it,
     // where an allocation will not cross a mmap boundary
-    size_t start_pos = it->second;
+    size_t start_pos = m_size_map.chunk_pos(it);
     size_t alloc_pos = alloc.find_section_in_range(start_pos, chunk_size, size);
     if (alloc_pos == 0) {
-        return m_size_map.end();
+        return FreeSpaceBins::npos;
     }
     // we found a place - if it's not at the beginning of the chunk,
     // we split the chunk so that the allocation can be done from the
@@ -1205,37 +1451,29 @@ GroupWriter::FreeListElement GroupWriter::search_free_space_in_free_list_element
 
 GroupWriter::FreeListElement GroupWriter::search_free_space_in_part_of_freelist(size_t size)
 {
-    auto it = m_size_map.lower_bound(size);
-    while (it != m_size_map.end()) {
-        // Accept either a perfect match or a block that is twice the size. Tests have shown
-        // that this is a good strategy.
-        if (it->first == size || it->first >= 2 * size) {
-            auto ret = search_free_space_in_free_list_element(it, size);
-            if (ret != m_size_map.end()) {
-                return ret;
-            }
-            ++it;
-        }
-        else {
-            // If block was too small, search for the first that is at least twice as big.
-            it = m_size_map.lower_bound(2 * size);
-        }
+    auto try_chunk = [&](FreeListElement it) {
+        return search_free_space_in_free_list_element(it, size);
+    };
+    // Accept either a perfect match or a block that is twice the size. Tests have shown
+    // that this is a good strategy.
+    auto ret = m_size_map.find(size, size, try_chunk);
+    if (ret == FreeSpaceBins::npos) {
+        ret = m_size_map.find(2 * size, std::numeric_limits<size_t>::max(), try_chunk);
     }
-    // No match
-    return m_size_map.end();
+    return ret;
 }
 
 
 GroupWriter::FreeListElement GroupWriter::reserve_free_space(size_t size)
 {
     auto chunk = search_free_space_in_part_of_freelist(size);
-    while (chunk == m_size_map.end()) {
+    while (chunk == FreeSpaceBins::npos) {
         if (!m_under_evacuation.empty()) {
             // We have been too aggressive in setting the evacuation limit
             // Just give up
             // But first we will release all kept back elements
             for (auto& elem : m_under_evacuation) {
-                m_size_map.emplace(elem.size, elem.ref);
+                m_size_map.insert(elem.size, elem.ref);
             }
             m_under_evacuation.clear();
             m_evacuation_limit = 0;
@@ -1320,7 +1558,7 @@ GroupWriter::FreeListElement GroupWriter::extend_free_space(size_t requested_siz
     size_t chunk_size = new_file_size - logical_file_size;
     REALM_ASSERT_RELEASE_EX(!(chunk_size & 7), chunk_size);
     REALM_ASSERT_RELEASE(chunk_size != 0);
-    auto it = m_size_map.emplace(chunk_size, logical_file_size);
+    auto it = m_size_map.insert(chunk_size, logical_file_size);
 
     // Update the logical file size
     m_logical_size = new_file_size;
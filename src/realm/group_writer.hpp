@@ -21,6 +21,7 @@
 
 #include <cstdint> // unint8_t etc
 #include <utility>
+#include <array>
 #include <map>
 
 #include <realm/util/file.hpp>
@@ -35,6 +36,7 @@ namespace realm {
 // Pre-declarations
 class Transaction;
 class SlabAlloc;
+class BatchedFileWriter;
 namespace util {
 class WriteMarker;
 }
@@ -60,6 +62,113 @@ public:
 using TopRefMap = std::map<uint64_t, VersionInfo>;
 using VersionVector = std::vector<uint64_t>;
 
+/// Segregated fit index of the free chunks of the file used by GroupWriter.
+///
+/// Chunks are kept in doubly linked lists by size class: one class for every
+/// size below 'exact_limit' (sizes are multiples of 8), and four classes per
+/// power of two above. A bitmap of non-empty classes allows the first class
+/// which can satisfy a request to be found with a few bit scans, so neither
+/// insertion, removal nor lookup depend on the number of free chunks. Handles
+/// remain valid until the chunk is erased.
+class FreeSpaceBins {
+public:
+    using Handle = uint32_t;
+    static constexpr Handle npos = Handle(-1);
+
+    FreeSpaceBins() noexcept
+    {
+        m_heads.fill(npos);
+    }
+
+    void reserve(size_t num_chunks);
+    void clear() noexcept;
+
+    Handle insert(size_t size, size_t pos);
+    void erase(Handle) noexcept;
+
+    size_t chunk_size(Handle h) const noexcept
+    {
+        return m_chunks[h].size;
+    }
+    size_t chunk_pos(Handle h) const noexcept
+    {
+        return m_chunks[h].pos;
+    }
+    size_t count() const noexcept
+    {
+        return m_count;
+    }
+    bool empty() const noexcept
+    {
+        return m_count == 0;
+    }
+
+    /// Offer chunks with a size in [min_size, max_size] to 'fn' in order of
+    /// increasing size class, until 'fn' returns something other than npos,
+    /// which is then returned. 'fn' may only modify the bins when it succeeds.
+    template <class F>
+    Handle find(size_t min_size, size_t max_size, F&& fn);
+
+    /// The largest chunk, or npos if there are no chunks
+    Handle largest() const noexcept;
+
+    template <class F>
+    void for_each(F&& fn) const;
+
+private:
+    static constexpr size_t exact_limit_log2 = 10;
+    static constexpr size_t exact_limit = size_t(1) << exact_limit_log2;
+    static constexpr size_t num_exact_classes = exact_limit / 8;
+    static constexpr size_t num_classes = num_exact_classes + 4 * (64 - exact_limit_log2);
+    static constexpr size_t bits_per_word = sizeof(size_t) * 8;
+    static constexpr size_t num_bitmap_words = (num_classes + bits_per_word - 1) / bits_per_word;
+
+    struct Chunk {
+        size_t size;
+        size_t pos;
+        Handle prev;
+        Handle next;
+    };
+
+    std::vector<Chunk> m_chunks;
+    // Erased entries in 'm_chunks' linked through 'next'
+    Handle m_unused = npos;
+    size_t m_count = 0;
+    std::array<Handle, num_classes> m_heads;
+    std::array<size_t, num_bitmap_words> m_non_empty = {};
+
+    static size_t size_class(size_t size) noexcept;
+    // First non-empty class at or after 'cls', or num_classes
+    size_t next_non_empty(size_t cls) const noexcept;
+};
+
+template <class F>
+FreeSpaceBins::Handle FreeSpaceBins::find(size_t min_size, size_t max_size, F&& fn)
+{
+    size_t last = size_class(max_size);
+    for (size_t cls = next_non_empty(size_class(min_size)); cls <= last && cls < num_classes;
+         cls = next_non_empty(cls + 1)) {
+        for (Handle h = m_heads[cls]; h != npos; h = m_chunks[h].next) {
+            size_t size = m_chunks[h].size;
+            if (size >= min_size && size <= max_size) {
+                Handle ret = fn(h);
+                if (ret != npos)
+                    return ret;
+            }
+        }
+    }
+    return npos;
+}
+
+template <class F>
+void FreeSpaceBins::for_each(F&& fn) const
+{
+    for (size_t cls = next_non_empty(0); cls < num_classes; cls = next_non_empty(cls + 1)) {
+        for (Handle h = m_heads[cls]; h != npos; h = m_chunks[h].next)
+            fn(m_chunks[h].size, m_chunks[h].pos);
+    }
+}
+
 class WriteWindowMgr {
 public:
     using Durability = DBOptions::Durability;
@@ -129,6 +238,10 @@ public:
 
     void set_versions(uint64_t current, TopRefMap& top_refs, bool any_num_unreachables) noexcept;
 
+    /// Select how write_group() writes nodes to the file. Encrypted and
+    /// in-memory files always use their own way of writing.
+    void set_commit_write_mode(DBOptions::CommitWriteMode mode);
+
     /// Write all changed array nodes into free space.
     ///
     /// Returns the new top ref. When in full durability mode, call
@@ -200,6 +313,7 @@ public:
 
 private:
     friend class InMemoryWriter;
+    friend class BatchedFileWriter;
     struct FreeSpaceEntry {
         FreeSpaceEntry(size_t r, size_t s, uint64_t v)
             : ref(r)
@@ -214,12 +328,14 @@ private:
 
     static void merge_adjacent_entries_in_freelist(std::vector<FreeSpaceEntry>& list);
     static void move_free_in_file_to_size_map(const std::vector<GroupWriter::FreeSpaceEntry>& list,
-                                              std::multimap<size_t, size_t>& size_map);
+                                              FreeSpaceBins& size_map);
 
     Transaction& m_group;
     SlabAlloc& m_alloc;
     Durability m_durability;
     WriteWindowMgr m_window_mgr;
+    // Used instead of 'm_window_mgr' with CommitWriteMode::BatchedWrite
+    std::unique_ptr<BatchedFileWriter> m_batched_writer;
     Array m_free_positions; // 4th slot in Group::m_top
     Array m_free_lengths;   // 5th slot in Group::m_top
     Array m_free_versions;  // 6th slot in Group::m_top
@@ -236,9 +352,20 @@ private:
     //  m_free_in_file;
     std::vector<FreeSpaceEntry> m_not_free_in_file;
     std::vector<FreeSpaceEntry> m_under_evacuation;
-    std::multimap<size_t, size_t> m_size_map;
+    FreeSpaceBins m_size_map;
     std::vector<size_t> m_evacuation_progress;
-    using FreeListElement = std::multimap<size_t, size_t>::iterator;
+    using FreeListElement = FreeSpaceBins::Handle;
+
+    // Arrays are written depth first, so the nodes of a subtree, and thereby
+    // the columns of a table, are written one after the other. To keep them
+    // next to each other in the file, allocation continues in the remainder
+    // of the chunk used for the previous array as long as it fits. When it
+    // doesn't, a new chunk large enough for the rest of the commit (up to
+    // 's_max_extent') is preferred over the best fit for the single array.
+    FreeListElement m_placement_cursor = FreeSpaceBins::npos;
+    size_t m_bytes_to_place = 0;
+    bool m_use_placement_policy = true;
+    static constexpr size_t s_max_extent = 0x40000; // 256 KiB
 
     void read_in_freelist();
     size_t recreate_freelist(size_t reserve_pos);
@@ -253,6 +380,10 @@ private:
     /// chunk.
     size_t get_free_space(size_t size);
 
+    /// Find the chunk to allocate an array of the specified size from,
+    /// according to the placement policy described at 'm_placement_cursor'.
+    FreeListElement reserve_placement(size_t size);
+
     /// Find a block of free space that is at least as big as the
     /// specified size and which will allow an allocation that is mapped
     /// inside a contiguous address range. The specified size does not
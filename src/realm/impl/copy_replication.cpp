@@ -21,6 +21,7 @@
 #include <realm/dictionary.hpp>
 #include <realm/list.hpp>
 #include <realm/set.hpp>
+#include <realm/vector_index.hpp>
 
 namespace realm::_impl {
 
@@ -86,7 +87,10 @@ void CopyReplication::insert_column(const Table* t, ColKey col_key, DataType typ
         else {
             auto new_col_key = table->add_column(type, name, col_key.is_nullable());
             auto index_type = t->search_index_type(col_key);
-            if (index_type != IndexType::None) {
+            if (index_type == IndexType::Vector) {
+                table->add_vector_index(new_col_key, t->get_vector_index(col_key)->get_metric());
+            }
+            else if (index_type != IndexType::None) {
                 table->add_search_index(new_col_key, index_type);
             }
         }
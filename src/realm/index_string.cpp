@@ -24,6 +24,7 @@
 #include <iostream>
 #endif
 
+#include <realm/array_string.hpp>
 #include <realm/exceptions.hpp>
 #include <realm/index_string.hpp>
 #include <realm/table.hpp>
@@ -45,12 +46,70 @@ void get_child(Array& parent, size_t child_ref_ndx, Array& child) noexcept
     child.set_parent(&parent, child_ref_ndx);
 }
 
+// Trigrams are compared with ASCII letters in lower case, so that one index serves both case sensitive and case
+// insensitive searches
+inline char fold_ascii(char c) noexcept
+{
+    return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+}
+
+// The distinct sequences of three bytes in 'str'. Sequences holding a zero byte are left out.
+std::set<std::string> get_trigrams(StringData str)
+{
+    std::set<std::string> trigrams;
+    size_t sz = str.size();
+    for (size_t i = 0; i + 3 <= sz; ++i) {
+        char trigram[3] = {fold_ascii(str[i]), fold_ascii(str[i + 1]), fold_ascii(str[i + 2])};
+        if (trigram[0] && trigram[1] && trigram[2])
+            trigrams.emplace(trigram, 3);
+    }
+    return trigrams;
+}
+
+// The trigrams which any string matching the pattern must contain. Contains and like compare each byte of the
+// string with the bytes at the same position in the upper and lower case forms of the pattern, so a sequence of
+// three pattern positions gives a trigram if the two forms fold to the same bytes there. The wildcards of a like
+// pattern match a variable number of bytes and break the sequences.
+std::vector<std::string> get_pattern_trigrams(StringData upper, StringData lower, bool like)
+{
+    std::set<std::string> trigrams;
+    if (upper.is_null() || lower.is_null() || upper.size() != lower.size())
+        return {};
+    std::string run;
+    auto add_run = [&] {
+        for (size_t i = 0; i + 3 <= run.size(); ++i)
+            trigrams.insert(run.substr(i, 3));
+        run.clear();
+    };
+    for (size_t i = 0; i < upper.size(); ++i) {
+        char c = fold_ascii(upper[i]);
+        if ((like && (upper[i] == '*' || upper[i] == '?')) || c != fold_ascii(lower[i]) || c == 0) {
+            add_run();
+        }
+        else {
+            run += c;
+        }
+    }
+    add_run();
+    return {trigrams.begin(), trigrams.end()};
+}
+
+// The words of a full text index or the trigrams of a trigram index
+std::set<std::string> get_tokens(const ClusterColumn& column, StringData str)
+{
+    if (column.trigrams())
+        return get_trigrams(str);
+    return Tokenizer::get_instance()->reset(std::string_view(str)).get_all_tokens();
+}
+
 // This method reconstructs the string inserted in the search index based on a string
 // that matches so far and the last key (only works if complete strings are stored in the index)
 static StringData reconstruct_string(size_t offset, StringIndex::key_type key, StringData new_string)
 {
-    if (key == 0)
-        return StringData();
+    // Complete strings are stored under the key holding their terminator. If the matching
+    // string also ends within this key (or before it), the two strings are equal.
+    if (new_string.size() < offset + 4)
+        return new_string;
 
     size_t rest_len = 4;
     char* k = reinterpret_cast<char*>(&key);
@@ -107,10 +166,24 @@ Mixed ClusterColumn::get_value(ObjKey key) const
     return obj.get_any(m_column_key);
 }
 
-Lst<String> ClusterColumn::get_list(ObjKey key) const
+void ClusterColumn::get_strings(const std::vector<ObjKey>& keys,
+                                util::FunctionRef<void(size_t, StringData)> func) const
+{
+    ArrayString leaf(m_cluster_tree->get_alloc());
+    ref_type leaf_ref = 0;
+    m_cluster_tree->resolve(keys.data(), keys.size(), [&](size_t i, const Cluster* cluster, size_t ndx) {
+        if (cluster->get_ref() != leaf_ref) {
+            cluster->init_leaf(m_column_key, &leaf);
+            leaf_ref = cluster->get_ref();
+        }
+        func(i, leaf.get(ndx));
+    });
+}
+
+CollectionBasePtr ClusterColumn::get_collection(ObjKey key) const
 {
     const Obj obj{m_cluster_tree->get(key)};
-    return obj.get_list<String>(m_column_key);
+    return obj.get_collection_ptr(m_column_key);
 }
 
 std::vector<ObjKey> ClusterColumn::get_all_keys() const
@@ -303,6 +376,8 @@ int64_t IndexArray::index_string(const Mixed& value, InternalFindResult& result_
         if (!sub_isindex) {
             const IntegerColumn sub(m_alloc, ref_type(ref));
             if (column.full_word()) {
+                if (reconstruct_string(stringoffset, key, index_data) != index_data)
+                    return local_not_found;
                 return from_list_full_word<method>(result_ref, sub);
             }
 
@@ -632,7 +707,8 @@ void IndexArray::index_string_all(const Mixed& value, std::vector<ObjKey>& resul
         if (ref & 1) {
             ObjKey k(int64_t(ref >> 1));
 
-            if (column.full_word() || column.get_value(k) == value) {
+            if (column.full_word() ? reconstruct_string(stringoffset, key, index_data) == index_data
+                                   : column.get_value(k) == value) {
                 result.push_back(k);
                 return;
             }
@@ -645,6 +721,8 @@ void IndexArray::index_string_all(const Mixed& value, std::vector<ObjKey>& resul
         // List of row indices with common prefix up to this point, in sorted order.
         if (!sub_isindex) {
             const IntegerColumn sub(m_alloc, ref_type(ref));
+            if (column.full_word() && reconstruct_string(stringoffset, key, index_data) != index_data)
+                return;
             return from_list_all(value, result, sub, column);
         }
 
@@ -858,10 +936,10 @@ void StringIndex::insert_to_existing_list_at_lower(ObjKey key, Mixed value, Inte
     // first to see if we can avoid the binary search for insert position
     IntegerColumn::const_iterator last = upper - ptrdiff_t(1);
     int64_t last_key_value = *last;
-    if (key.value >= last_key_value) {
+    if (key.value > last_key_value) {
         list.insert(upper.get_position(), key.value);
     }
-    else {
+    else if (key.value < last_key_value) {
         // insert into the group of duplicates, keeping object keys sorted
         IntegerColumn::const_iterator inner_lower = std::lower_bound(lower, upper, key.value);
         if (*inner_lower != key.value) {
@@ -1148,7 +1226,7 @@ bool StringIndex::leaf_insert(ObjKey obj_key, key_type key, size_t offset, Strin
                               bool noextend)
 {
     REALM_ASSERT(!m_array->is_inner_bptree_node());
-    if (offset >= s_max_offset && m_target_column.full_word()) {
+    if (offset >= s_max_offset && index_data.size() > s_max_offset && m_target_column.full_word()) {
         size_t len = value.get_string().size();
         size_t max = s_max_offset;
         throw LogicError(ErrorCodes::LimitExceeded,
@@ -1164,8 +1242,8 @@ bool StringIndex::leaf_insert(ObjKey obj_key, key_type key, size_t offset, Strin
         REALM_ASSERT(m_array->size() == keys.size() + 1);
 
         // If we are keeping the complete string in the index
-        // we want to know if this is the last part
-        bool is_at_string_end = offset + 4 >= index_data.size();
+        // we want to know if this is the last part, i.e. the key holds the terminator
+        bool is_at_string_end = offset + 4 > index_data.size();
 
         size_t ins_pos = keys.lower_bound_int(key);
         ins_pos_refs = ins_pos + 1; // first entry in refs points to offsets
@@ -1348,17 +1426,16 @@ void StringIndex::erase(ObjKey key)
 {
     StringConversionBuffer buffer;
     if (m_target_column.full_word()) {
-        if (m_target_column.tokenize()) {
-            // This is a full text index
-            auto index_data(get(key).get_index_data(buffer));
-            auto words = Tokenizer::get_instance()->reset(std::string_view(index_data)).get_all_tokens();
+        if (m_target_column.tokenize() || m_target_column.trigrams()) {
+            // This is a full text or trigram index
+            auto words = get_tokens(m_target_column, get(key).get_index_data(buffer));
             for (auto& w : words) {
                 erase_string(key, w);
             }
         }
         else {
-            // This is a list (of strings)
-            erase_list(key, m_target_column.get_list(key));
+            // This is a list or a set
+            erase_collection(key, *m_target_column.get_collection(key));
         }
     }
     else {
@@ -1366,19 +1443,38 @@ void StringIndex::erase(ObjKey key)
     }
 }
 
-void StringIndex::erase_list(ObjKey key, const Lst<String>& list)
+void StringIndex::erase_collection(ObjKey key, const CollectionBase& collection)
 {
-    std::vector<StringData> strings;
-    strings.reserve(list.size());
-    for (auto& val : list) {
-        strings.push_back(val);
+    std::vector<Mixed> values;
+    size_t sz = collection.size();
+    values.reserve(sz);
+    for (size_t i = 0; i < sz; i++) {
+        values.push_back(collection.get_any(i));
+    }
+
+    std::sort(values.begin(), values.end());
+    auto last = std::unique(values.begin(), values.end());
+    CollectionElementBuffer buffer;
+    StringConversionBuffer data_buffer;
+    for (auto it = values.begin(); it != last; ++it) {
+        erase_string(key, collection_element(*it, buffer).get_index_data(data_buffer));
     }
+}
+
+Mixed StringIndex::collection_element(const Mixed& value, CollectionElementBuffer& buffer) noexcept
+{
+    if (value.is_null() || value.is_type(type_String))
+        return value;
 
-    std::sort(strings.begin(), strings.end());
-    auto last = std::unique(strings.begin(), strings.end());
-    for (auto it = strings.begin(); it != last; ++it) {
-        erase_string(key, *it);
+    StringConversionBuffer data_buffer;
+    StringData data = value.get_index_data(data_buffer);
+    REALM_ASSERT_DEBUG(2 * data.size() <= buffer.size());
+    for (size_t i = 0; i < data.size(); i++) {
+        auto byte = static_cast<unsigned char>(data[i]);
+        buffer[2 * i] = char('a' + (byte >> 4));
+        buffer[2 * i + 1] = char('a' + (byte & 0xf));
     }
+    return StringData(buffer.data(), 2 * data.size());
 }
 
 namespace {
@@ -1455,6 +1551,18 @@ void StringIndex::insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, si
     }
 }
 
+namespace {
+template <class T>
+void insert_collection_values(StringIndex& index, ObjKey key, ref_type ref, Allocator& alloc)
+{
+    BPlusTree<T> values(alloc);
+    values.init_from_ref(ref);
+    values.for_all([&](const T& value) {
+        index.insert(key, Mixed(value));
+    });
+}
+} // namespace
+
 void StringIndex::insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
                                    ArrayInteger& ref_array)
 {
@@ -1464,14 +1572,40 @@ void StringIndex::insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offse
         }
         return ObjKey(n + key_offset);
     };
+    Allocator& alloc = ref_array.get_alloc();
+    ColKey col_key = m_target_column.get_column_key();
+    bool nullable = col_key.is_nullable();
     for (size_t i = 0; i < num_values; ++i) {
         ObjKey key = get_obj_key(i);
         if (auto ref = to_ref(ref_array.get(i))) {
-            BPlusTree<String> values(ref_array.get_alloc());
-            values.init_from_ref(ref);
-            values.for_all([&](const StringData& str) {
-                insert(key, str);
-            });
+            switch (col_key.get_type()) {
+                case col_type_Int:
+                    if (nullable)
+                        insert_collection_values<util::Optional<int64_t>>(*this, key, ref, alloc);
+                    else
+                        insert_collection_values<int64_t>(*this, key, ref, alloc);
+                    break;
+                case col_type_String:
+                    insert_collection_values<String>(*this, key, ref, alloc);
+                    break;
+                case col_type_Timestamp:
+                    insert_collection_values<Timestamp>(*this, key, ref, alloc);
+                    break;
+                case col_type_ObjectId:
+                    if (nullable)
+                        insert_collection_values<util::Optional<ObjectId>>(*this, key, ref, alloc);
+                    else
+                        insert_collection_values<ObjectId>(*this, key, ref, alloc);
+                    break;
+                case col_type_UUID:
+                    if (nullable)
+                        insert_collection_values<util::Optional<UUID>>(*this, key, ref, alloc);
+                    else
+                        insert_collection_values<UUID>(*this, key, ref, alloc);
+                    break;
+                default:
+                    REALM_UNREACHABLE();
+            }
         }
     }
 }
@@ -1587,6 +1721,59 @@ void StringIndex::find_all_fulltext(std::vector<ObjKey>& result, StringData valu
     }
 }
 
+bool StringIndex::find_all_trigram_matches(std::vector<ObjKey>& result, StringData upper, StringData lower,
+                                           bool like, util::FunctionRef<bool(StringData)> matches) const
+{
+    REALM_ASSERT(result.empty());
+    auto trigrams = get_pattern_trigrams(upper, lower, like);
+    if (trigrams.empty())
+        return false;
+
+    // Look up all the posting lists first, so that they can be intersected starting with the shortest one
+    std::vector<std::pair<FindRes, InternalFindResult>> postings;
+    postings.reserve(trigrams.size());
+    for (auto& trigram : trigrams) {
+        InternalFindResult res;
+        FindRes fr = find_all_no_copy(StringData(trigram), res);
+        if (fr == FindRes_not_found)
+            return true;
+        if (fr == FindRes_single) {
+            res.start_ndx = 0;
+            res.end_ndx = 1;
+        }
+        postings.emplace_back(fr, res);
+    }
+    std::sort(postings.begin(), postings.end(), [](const auto& a, const auto& b) {
+        return a.second.end_ndx - a.second.start_ndx < b.second.end_ndx - b.second.start_ndx;
+    });
+
+    for (auto& [fr, res] : postings) {
+        if (fr == FindRes_single) {
+            ObjKey key(res.payload);
+            bool found = result.empty() || std::binary_search(result.begin(), result.end(), key);
+            result.clear();
+            if (found)
+                result.push_back(key);
+        }
+        else {
+            IntegerColumn indexes(m_array->get_alloc(), ref_type(res.payload));
+            FindResWrapper wrapper{res, indexes};
+            intersect(result, wrapper);
+        }
+        if (result.empty())
+            return true;
+    }
+
+    // Check the candidates against the strings
+    std::vector<ObjKey> candidates;
+    candidates.swap(result);
+    m_target_column.get_strings(candidates, [&](size_t i, StringData str) {
+        if (matches(str))
+            result.push_back(candidates[i]);
+    });
+    return true;
+}
+
 
 void StringIndex::clear()
 {
@@ -1779,9 +1966,9 @@ void StringIndex::insert(ObjKey key, const Mixed& value)
     StringConversionBuffer buffer;
     constexpr size_t offset = 0; // First key from beginning of string
 
-    if (this->m_target_column.tokenize()) {
+    if (this->m_target_column.tokenize() || m_target_column.trigrams()) {
         if (value.is_type(type_String)) {
-            auto words = Tokenizer::get_instance()->reset(std::string_view(value.get<StringData>())).get_all_tokens();
+            auto words = get_tokens(m_target_column, value.get<StringData>());
 
             for (auto& word : words) {
                 Mixed m(word);
@@ -1789,6 +1976,11 @@ void StringIndex::insert(ObjKey key, const Mixed& value)
             }
         }
     }
+    else if (m_target_column.is_collection()) {
+        CollectionElementBuffer element_buffer;
+        Mixed m = collection_element(value, element_buffer);
+        insert_with_offset(key, m.get_index_data(buffer), m, offset); // Throws
+    }
     else {
         insert_with_offset(key, value.get_index_data(buffer), value, offset); // Throws
     }
@@ -1799,18 +1991,16 @@ void StringIndex::set(ObjKey key, const Mixed& new_value)
     StringConversionBuffer buffer;
     Mixed old_value = get(key);
 
-    if (this->m_target_column.tokenize()) {
-        auto tokenizer = Tokenizer::get_instance();
+    if (this->m_target_column.tokenize() || m_target_column.trigrams()) {
         StringData old_string = old_value.get_index_data(buffer);
         std::set<std::string> old_words;
 
         if (old_string.size() > 0) {
-            tokenizer->reset({old_string.data(), old_string.size()});
-            old_words = tokenizer->get_all_tokens();
+            old_words = get_tokens(m_target_column, old_string);
         }
         std::set<std::string> new_words;
         if (new_value.is_type(type_String)) {
-            new_words = tokenizer->reset(std::string_view(new_value.get<StringData>())).get_all_tokens();
+            new_words = get_tokens(m_target_column, new_value.get<StringData>());
         }
 
         auto w1 = old_words.begin();
@@ -118,6 +118,10 @@ using StringConversionBuffer = std::array<char, string_conversion_buffer_size>;
 static_assert(sizeof(UUID::UUIDBytes) <= string_conversion_buffer_size,
               "if you change the size of a UUID then also change the string index buffer space");
 
+// Elements of indexed lists and sets are kept in the index as complete words. Other values than strings are stored
+// as two letters per byte of their index data, as the raw bytes could contain the end marker of a word.
+using CollectionElementBuffer = std::array<char, 2 * string_conversion_buffer_size>;
+
 
 class StringIndex : public SearchIndex {
 public:
@@ -130,6 +134,12 @@ public:
         return (type == type_Int || type == type_String || type == type_Bool || type == type_Timestamp ||
                 type == type_ObjectId || type == type_Mixed || type == type_UUID);
     }
+    // Lists and sets of these types can be indexed by their elements
+    static bool collection_type_supported(realm::DataType type)
+    {
+        return (type == type_Int || type == type_String || type == type_Timestamp || type == type_ObjectId ||
+                type == type_UUID);
+    }
 
     // StringIndex interface:
 
@@ -138,11 +148,16 @@ public:
     {
         return this->m_target_column.tokenize();
     }
+    bool is_trigram_index() const
+    {
+        return this->m_target_column.trigrams();
+    }
 
     void insert(ObjKey key, const Mixed& value) final;
     void set(ObjKey key, const Mixed& new_value) final;
     void erase(ObjKey key) final;
-    void erase_list(ObjKey key, const Lst<String>&);
+    // The owning object is present once for every distinct value of an indexed list or set
+    void erase_collection(ObjKey key, const CollectionBase&);
     // Erase without getting value from parent column (useful when string stored
     // does not directly match string in parent, like with full-text indexing)
     void erase_string(ObjKey key, StringData value);
@@ -156,6 +171,16 @@ public:
                           ArrayInteger& ref_array) final;
 
     void find_all_fulltext(std::vector<ObjKey>& result, StringData value) const;
+    // Find the objects whose string matches a CONTAINS or LIKE pattern through a trigram index. 'upper' and
+    // 'lower' are the two case forms of the pattern for a case insensitive condition, and otherwise both are the
+    // pattern. The objects holding every trigram a matching string must contain are looked up in the index, and
+    // the result is those of them for which 'matches' returns true. Returns false without searching if the
+    // pattern requires no trigram, in which case the index can't be used.
+    bool find_all_trigram_matches(std::vector<ObjKey>& result, StringData upper, StringData lower, bool like,
+                                  util::FunctionRef<bool(StringData)> matches) const;
+
+    /// The value stored in the index for 'value' as an element of an indexed list or set
+    static Mixed collection_element(const Mixed& value, CollectionElementBuffer& buffer) noexcept;
 
     void clear() override;
     bool has_duplicate_values() const noexcept override;
@@ -213,6 +238,11 @@ private:
 
     static std::unique_ptr<IndexArray> create_node(Allocator&, bool is_leaf);
 
+    Mixed index_value(const Mixed& value, CollectionElementBuffer& buffer) const noexcept
+    {
+        return m_target_column.is_collection() ? collection_element(value, buffer) : value;
+    }
+
     void insert_with_offset(ObjKey key, StringData index_data, const Mixed& value, size_t offset);
     void insert_row_list(size_t ref, size_t offset, StringData value);
     void insert_to_existing_list(ObjKey key, Mixed value, IntegerColumn& list);
@@ -360,25 +390,29 @@ inline StringIndex::key_type StringIndex::create_key(StringData str, size_t offs
 
 inline ObjKey StringIndex::find_first(const Mixed& value) const
 {
+    CollectionElementBuffer buffer;
     // Use direct access method
-    return m_array->index_string_find_first(value, m_target_column);
+    return m_array->index_string_find_first(index_value(value, buffer), m_target_column);
 }
 
 inline void StringIndex::find_all(std::vector<ObjKey>& result, Mixed value, bool case_insensitive) const
 {
+    CollectionElementBuffer buffer;
     // Use direct access method
-    return m_array->index_string_find_all(result, value, m_target_column, case_insensitive);
+    return m_array->index_string_find_all(result, index_value(value, buffer), m_target_column, case_insensitive);
 }
 
 inline FindRes StringIndex::find_all_no_copy(Mixed value, InternalFindResult& result) const
 {
-    return m_array->index_string_find_all_no_copy(value, m_target_column, result);
+    CollectionElementBuffer buffer;
+    return m_array->index_string_find_all_no_copy(index_value(value, buffer), m_target_column, result);
 }
 
 inline size_t StringIndex::count(const Mixed& value) const
 {
+    CollectionElementBuffer buffer;
     // Use direct access method
-    return m_array->index_string_count(value, m_target_column);
+    return m_array->index_string_count(index_value(value, buffer), m_target_column);
 }
 
 } // namespace realm
@@ -243,6 +243,11 @@ protected:
     void do_remove(size_t ndx);
     void do_clear();
 
+    static constexpr bool s_may_be_indexed =
+        realm::is_any_v<T, Int, util::Optional<Int>, StringData, Timestamp, ObjectId, util::Optional<ObjectId>, UUID,
+                        util::Optional<UUID>>;
+    bool is_single_occurrence(const T& value) const;
+
     // BPlusTree must be wrapped in an `std::unique_ptr` because it is not
     // default-constructible, due to its `Allocator&` member.
     mutable std::unique_ptr<BPlusTree<T>> m_tree;
@@ -545,15 +550,6 @@ private:
     inline std::shared_ptr<T> do_get_collection(const PathElement& path_elem);
 };
 
-// Specialization of Lst<StringData>:
-template <>
-void Lst<StringData>::do_insert(size_t, StringData);
-template <>
-void Lst<StringData>::do_set(size_t, StringData);
-template <>
-void Lst<StringData>::do_remove(size_t);
-template <>
-void Lst<StringData>::do_clear();
 // Specialization of Lst<ObjKey>:
 template <>
 void Lst<ObjKey>::do_set(size_t, ObjKey);
@@ -879,27 +875,67 @@ inline Mixed Lst<T>::get_any(size_t ndx) const
 template <class T>
 inline void Lst<T>::do_set(size_t ndx, T value)
 {
+    if constexpr (s_may_be_indexed) {
+        if (auto index = Base::get_search_index()) {
+            T old_value = m_tree->get(ndx);
+            if (is_single_occurrence(old_value)) {
+                this->index_erase(*index, old_value);
+            }
+            this->index_insert(*index, value);
+        }
+    }
     m_tree->set(ndx, value);
 }
 
 template <class T>
 inline void Lst<T>::do_insert(size_t ndx, T value)
 {
+    if constexpr (s_may_be_indexed) {
+        if (auto index = Base::get_search_index()) {
+            this->index_insert(*index, value);
+        }
+    }
     m_tree->insert(ndx, value);
 }
 
 template <class T>
 inline void Lst<T>::do_remove(size_t ndx)
 {
+    if constexpr (s_may_be_indexed) {
+        if (auto index = Base::get_search_index()) {
+            T old_value = m_tree->get(ndx);
+            if (is_single_occurrence(old_value)) {
+                this->index_erase(*index, old_value);
+            }
+        }
+    }
     m_tree->erase(ndx);
 }
 
 template <class T>
 inline void Lst<T>::do_clear()
 {
+    if constexpr (s_may_be_indexed) {
+        if (auto index = Base::get_search_index()) {
+            this->index_clear(*index);
+        }
+    }
     m_tree->clear();
 }
 
+template <class T>
+bool Lst<T>::is_single_occurrence(const T& value) const
+{
+    size_t count = 0;
+    m_tree->for_all([&](const T& val) {
+        if (val == value) {
+            count++;
+        }
+        return count < 2;
+    });
+    return count == 1;
+}
+
 template <typename U>
 inline Lst<U> Obj::get_list(ColKey col_key) const
 {
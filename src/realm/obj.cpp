@@ -22,6 +22,7 @@
 #include "realm/array_bool.hpp"
 #include "realm/array_string.hpp"
 #include "realm/array_binary.hpp"
+#include "realm/blob.hpp"
 #include "realm/array_mixed.hpp"
 #include "realm/array_timestamp.hpp"
 #include "realm/array_decimal128.hpp"
@@ -1139,6 +1140,12 @@ bool Obj::ensure_writeable()
     return false;
 }
 
+int_fast64_t Obj::bump_content_version()
+{
+    m_table.unchecked_ptr()->note_object_changed(m_key);
+    return get_alloc().bump_content_version();
+}
+
 REALM_FORCEINLINE void Obj::sync(Node& arr)
 {
     auto ref = arr.get_ref();
@@ -1202,7 +1209,7 @@ Obj& Obj::set<Mixed>(ColKey col_key, Mixed value, bool is_default)
         }
 
         Allocator& alloc = get_alloc();
-        alloc.bump_content_version();
+        bump_content_version();
         Array fallback(alloc);
         Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
         REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1303,7 +1310,7 @@ Obj& Obj::set<int64_t>(ColKey col_key, int64_t value, bool is_default)
     }
 
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
     REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1344,7 +1351,7 @@ Obj& Obj::add_int(ColKey col_key, int64_t value)
     };
 
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
     REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1438,7 +1445,7 @@ Obj& Obj::set<ObjKey>(ColKey col_key, ObjKey target_key, bool is_default)
         _update_if_needed();
 
         Allocator& alloc = get_alloc();
-        alloc.bump_content_version();
+        bump_content_version();
         Array fallback(alloc);
         Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
         REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1482,7 +1489,7 @@ Obj& Obj::set<ObjLink>(ColKey col_key, ObjLink target_link, bool is_default)
         _update_if_needed();
 
         Allocator& alloc = get_alloc();
-        alloc.bump_content_version();
+        bump_content_version();
         Array fallback(alloc);
         Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
         REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1544,7 +1551,7 @@ Obj Obj::create_and_set_linked_object(ColKey col_key, bool is_default)
     _update_if_needed();
 
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
     REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1675,7 +1682,7 @@ Obj& Obj::set(ColKey col_key, T value, bool is_default)
     }
 
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
     REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1706,12 +1713,42 @@ INSTANTIATE_OBJ_SET(BinaryData);
 INSTANTIATE_OBJ_SET(ObjectId);
 INSTANTIATE_OBJ_SET(UUID);
 
+Blob Obj::open_blob(ColKey col_key) const
+{
+    return Blob(*this, col_key);
+}
+
+void Obj::replace_binary(ColKey col_key, size_t begin, size_t end, BinaryData value)
+{
+    checked_update_if_needed();
+    auto col_ndx = col_key.get_index();
+
+    Allocator& alloc = get_alloc();
+    bump_content_version();
+    Array fallback(alloc);
+    Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
+    REALM_ASSERT(col_ndx.val + 1 < fields.size());
+    ArrayBinary values(alloc);
+    values.set_parent(&fields, col_ndx.val + 1);
+    values.init_from_parent();
+
+    size_t old_size = values.get(m_row_ndx).size();
+    if (REALM_UNLIKELY(old_size - (end - begin) + value.size() > ArrayBlob::max_binary_size))
+        throw LogicError(ErrorCodes::LimitExceeded, "Binary too big");
+    values.replace(m_row_ndx, begin, end, value);
+
+    sync(fields);
+
+    if (Replication* repl = get_replication())
+        repl->set(m_table.unchecked_ptr(), col_key, m_key, values.get(m_row_ndx), _impl::instr_Set); // Throws
+}
+
 void Obj::set_int(ColKey::Idx col_ndx, int64_t value)
 {
     checked_update_if_needed();
 
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
     REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1728,7 +1765,7 @@ void Obj::set_ref(ColKey::Idx col_ndx, ref_type value, CollectionType type)
     checked_update_if_needed();
 
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
     REALM_ASSERT(col_ndx.val + 1 < fields.size());
@@ -1744,7 +1781,7 @@ void Obj::add_backlink(ColKey backlink_col_key, ObjKey origin_key)
 {
     ColKey::Idx backlink_col_ndx = backlink_col_key.get_index();
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
 
@@ -1761,7 +1798,7 @@ bool Obj::remove_one_backlink(ColKey backlink_col_key, ObjKey origin_key)
 {
     ColKey::Idx backlink_col_ndx = backlink_col_key.get_index();
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
 
@@ -1876,7 +1913,7 @@ void Obj::nullify_link(ColKey origin_col_key, ObjLink target_link) &&
 
     nullifier.run();
 
-    get_alloc().bump_content_version();
+    bump_content_version();
 }
 
 
@@ -2269,7 +2306,7 @@ inline void Obj::do_set_null(ColKey col_key)
 {
     ColKey::Idx col_ndx = col_key.get_index();
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
 
@@ -2287,7 +2324,7 @@ inline void Obj::do_set_null<ArrayString>(ColKey col_key)
     ColKey::Idx col_ndx = col_key.get_index();
     size_t spec_ndx = m_table->leaf_ndx2spec_ndx(col_ndx);
     Allocator& alloc = get_alloc();
-    alloc.bump_content_version();
+    bump_content_version();
     Array fallback(alloc);
     Array& fields = get_tree_top()->get_fields_accessor(fallback, m_mem);
 
@@ -30,6 +30,7 @@
 
 namespace realm {
 
+class Blob;
 class ClusterTree;
 class TableView;
 class CascadeState;
@@ -204,6 +205,9 @@ public:
     }
     Obj& set_json(ColKey col_key, StringData json);
 
+    // Byte range access to the value of a binary property. See blob.hpp
+    Blob open_blob(ColKey col_key) const;
+
     Obj& add_int(ColKey col_key, int64_t value);
     Obj& add_int(StringData col_name, int64_t value)
     {
@@ -306,6 +310,7 @@ public:
 
 private:
     friend class ArrayBacklink;
+    friend class Blob;
     friend class CascadeState;
     friend class Cluster;
     friend class CollectionParent;
@@ -384,6 +389,7 @@ private:
     }
 
     void set_int(ColKey::Idx col_ndx, int64_t value);
+    void replace_binary(ColKey col_key, size_t begin, size_t end, BinaryData value);
     void set_ref(ColKey::Idx col_ndx, ref_type value, CollectionType type);
     void add_backlink(ColKey backlink_col, ObjKey origin_key);
     bool remove_one_backlink(ColKey backlink_col, ObjKey origin_key);
@@ -655,12 +661,6 @@ inline Obj& Obj::set_all(Head v, Tail... tail)
     return _set_all(start_index, v, tail...);
 }
 
-inline int_fast64_t Obj::bump_content_version()
-{
-    Allocator& alloc = get_alloc();
-    return alloc.bump_content_version();
-}
-
 } // namespace realm
 
 #endif // REALM_OBJ_HPP
@@ -0,0 +1,484 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/obj_key_set.hpp>
+#include <realm/exceptions.hpp>
+
+#include <algorithm>
+#include <iterator>
+
+namespace realm {
+
+namespace {
+
+inline size_t popcount(uint64_t word) noexcept
+{
+    return size_t(fast_popcount64(int64_t(word)));
+}
+
+} // anonymous namespace
+
+// Container ------------------------------------------------------
+
+bool ObjKeySet::Container::add(uint16_t low)
+{
+    switch (type) {
+        case Type::Run:
+            to_bitmap();
+            [[fallthrough]];
+        case Type::Bitmap: {
+            uint64_t& word = bits[low >> 6];
+            uint64_t mask = uint64_t(1) << (low & 63);
+            if (word & mask)
+                return false;
+            word |= mask;
+            break;
+        }
+        case Type::Array: {
+            if (values.empty() || values.back() < low) {
+                values.push_back(low);
+            }
+            else {
+                auto it = std::lower_bound(values.begin(), values.end(), low);
+                if (*it == low)
+                    return false;
+                values.insert(it, low);
+            }
+            if (values.size() > max_array_size)
+                to_bitmap();
+            break;
+        }
+    }
+    ++cardinality;
+    return true;
+}
+
+bool ObjKeySet::Container::contains(uint16_t low) const noexcept
+{
+    switch (type) {
+        case Type::Array:
+            return std::binary_search(values.begin(), values.end(), low);
+        case Type::Bitmap:
+            return (bits[low >> 6] >> (low & 63)) & 1;
+        case Type::Run: {
+            // Find the last run starting at or before 'low'
+            size_t lo = 0;
+            size_t hi = values.size() / 2;
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (values[2 * mid] <= low)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            return lo > 0 && low <= uint32_t(values[2 * lo - 2]) + values[2 * lo - 1];
+        }
+    }
+    return false;
+}
+
+size_t ObjKeySet::Container::rank(uint16_t low) const noexcept
+{
+    switch (type) {
+        case Type::Array:
+            return size_t(std::lower_bound(values.begin(), values.end(), low) - values.begin());
+        case Type::Bitmap: {
+            size_t word_ndx = low >> 6;
+            size_t count = 0;
+            for (size_t w = 0; w < word_ndx; ++w)
+                count += popcount(bits[w]);
+            uint64_t below = (uint64_t(1) << (low & 63)) - 1;
+            return count + popcount(bits[word_ndx] & below);
+        }
+        case Type::Run: {
+            size_t count = 0;
+            for (size_t i = 0; i < values.size() && values[i] < low; i += 2) {
+                uint32_t end = uint32_t(values[i]) + values[i + 1];
+                count += (end < low ? end : low - 1u) - values[i] + 1;
+            }
+            return count;
+        }
+    }
+    return 0;
+}
+
+uint16_t ObjKeySet::Container::select(size_t ndx) const noexcept
+{
+    switch (type) {
+        case Type::Array:
+            return values[ndx];
+        case Type::Bitmap:
+            for (size_t w = 0;; ++w) {
+                size_t count = popcount(bits[w]);
+                if (ndx < count) {
+                    uint64_t word = bits[w];
+                    while (ndx--)
+                        word &= word - 1;
+                    return uint16_t(w * 64 + first_bit(word));
+                }
+                ndx -= count;
+            }
+        case Type::Run:
+            for (size_t i = 0;; i += 2) {
+                size_t len = size_t(values[i + 1]) + 1;
+                if (ndx < len)
+                    return uint16_t(values[i] + ndx);
+                ndx -= len;
+            }
+    }
+    return 0;
+}
+
+void ObjKeySet::Container::to_bitmap()
+{
+    if (type == Type::Bitmap)
+        return;
+    std::vector<uint64_t> new_bits(bitmap_words, 0);
+    for_each([&](uint16_t low) {
+        new_bits[low >> 6] |= uint64_t(1) << (low & 63);
+    });
+    bits = std::move(new_bits);
+    std::vector<uint16_t>().swap(values);
+    type = Type::Bitmap;
+}
+
+void ObjKeySet::Container::to_array()
+{
+    if (type == Type::Array)
+        return;
+    std::vector<uint16_t> new_values;
+    new_values.reserve(cardinality);
+    for_each([&](uint16_t low) {
+        new_values.push_back(low);
+    });
+    values = std::move(new_values);
+    std::vector<uint64_t>().swap(bits);
+    type = Type::Array;
+}
+
+size_t ObjKeySet::Container::count_runs() const noexcept
+{
+    size_t runs = 0;
+    int32_t last = -2;
+    for_each([&](uint16_t low) {
+        if (low != last + 1)
+            ++runs;
+        last = low;
+    });
+    return runs;
+}
+
+void ObjKeySet::Container::optimize()
+{
+    size_t runs = count_runs();
+    size_t run_size = runs * 2 * sizeof(uint16_t);
+    size_t array_size = cardinality * sizeof(uint16_t);
+    size_t bitmap_size = bitmap_words * sizeof(uint64_t);
+    if (run_size < array_size && run_size < bitmap_size) {
+        if (type == Type::Run)
+            return;
+        std::vector<uint16_t> new_values;
+        new_values.reserve(runs * 2);
+        for_each([&](uint16_t low) {
+            if (!new_values.empty() && uint32_t(new_values[new_values.size() - 2]) + new_values.back() + 1 == low)
+                ++new_values.back();
+            else {
+                new_values.push_back(low);
+                new_values.push_back(0);
+            }
+        });
+        values = std::move(new_values);
+        std::vector<uint64_t>().swap(bits);
+        type = Type::Run;
+    }
+    else if (cardinality <= max_array_size) {
+        to_array();
+    }
+    else {
+        to_bitmap();
+    }
+    values.shrink_to_fit();
+}
+
+void ObjKeySet::Container::intersect(const Container& other)
+{
+    if (type == Type::Bitmap && other.type == Type::Bitmap) {
+        // Word by word, in loops the compiler can vectorize
+        uint64_t* dst = bits.data();
+        const uint64_t* src = other.bits.data();
+        for (size_t w = 0; w < bitmap_words; ++w)
+            dst[w] &= src[w];
+        size_t count = 0;
+        for (size_t w = 0; w < bitmap_words; ++w)
+            count += popcount(dst[w]);
+        cardinality = uint32_t(count);
+        if (cardinality <= max_array_size)
+            to_array();
+        return;
+    }
+    std::vector<uint16_t> result;
+    result.reserve(std::min<size_t>(cardinality, other.cardinality));
+    if (type == Type::Array && other.type == Type::Array) {
+        std::set_intersection(values.begin(), values.end(), other.values.begin(), other.values.end(),
+                              std::back_inserter(result));
+    }
+    else {
+        // Probe the other container with the values of the smaller one
+        const Container& small = cardinality <= other.cardinality ? *this : other;
+        const Container& large = cardinality <= other.cardinality ? other : *this;
+        small.for_each([&](uint16_t low) {
+            if (large.contains(low))
+                result.push_back(low);
+        });
+    }
+    values = std::move(result);
+    std::vector<uint64_t>().swap(bits);
+    type = Type::Array;
+    cardinality = uint32_t(values.size());
+}
+
+void ObjKeySet::Container::unite(const Container& other)
+{
+    if (type == Type::Array && other.type == Type::Array &&
+        values.size() + other.values.size() <= max_array_size) {
+        std::vector<uint16_t> result;
+        result.reserve(values.size() + other.values.size());
+        std::set_union(values.begin(), values.end(), other.values.begin(), other.values.end(),
+                       std::back_inserter(result));
+        values = std::move(result);
+        cardinality = uint32_t(values.size());
+        return;
+    }
+    to_bitmap();
+    uint64_t* dst = bits.data();
+    if (other.type == Type::Bitmap) {
+        const uint64_t* src = other.bits.data();
+        for (size_t w = 0; w < bitmap_words; ++w)
+            dst[w] |= src[w];
+    }
+    else {
+        other.for_each([&](uint16_t low) {
+            dst[low >> 6] |= uint64_t(1) << (low & 63);
+        });
+    }
+    size_t count = 0;
+    for (size_t w = 0; w < bitmap_words; ++w)
+        count += popcount(dst[w]);
+    cardinality = uint32_t(count);
+}
+
+size_t ObjKeySet::Container::memory_usage() const noexcept
+{
+    return sizeof(Container) + values.capacity() * sizeof(uint16_t) + bits.capacity() * sizeof(uint64_t);
+}
+
+bool ObjKeySet::Container::operator==(const Container& other) const noexcept
+{
+    if (high != other.high || cardinality != other.cardinality)
+        return false;
+    if (type == other.type)
+        return values == other.values && bits == other.bits;
+    std::vector<uint16_t> a;
+    std::vector<uint16_t> b;
+    for_each([&](uint16_t low) {
+        a.push_back(low);
+    });
+    other.for_each([&](uint16_t low) {
+        b.push_back(low);
+    });
+    return a == b;
+}
+
+// ObjKeySet ------------------------------------------------------
+
+ObjKeySet::ObjKeySet(const std::vector<ObjKey>& keys)
+{
+    for (auto key : keys)
+        add(key);
+}
+
+void ObjKeySet::clear() noexcept
+{
+    m_containers.clear();
+    m_size = 0;
+}
+
+auto ObjKeySet::find_container(uint64_t high) noexcept -> Container*
+{
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), high, [](const Container& c, uint64_t h) {
+        return c.high < h;
+    });
+    return (it != m_containers.end() && it->high == high) ? &*it : nullptr;
+}
+
+auto ObjKeySet::find_container(uint64_t high) const noexcept -> const Container*
+{
+    return const_cast<ObjKeySet*>(this)->find_container(high);
+}
+
+void ObjKeySet::update_offsets(size_t begin) noexcept
+{
+    size_t offset = begin ? m_containers[begin - 1].offset + m_containers[begin - 1].cardinality : 0;
+    for (size_t i = begin; i < m_containers.size(); ++i) {
+        m_containers[i].offset = offset;
+        offset += m_containers[i].cardinality;
+    }
+}
+
+void ObjKeySet::add(ObjKey key)
+{
+    REALM_ASSERT(key.value >= 0);
+    uint64_t high = uint64_t(key.value) >> 16;
+
+    size_t ndx;
+    if (m_containers.empty() || m_containers.back().high < high) {
+        ndx = m_containers.size();
+        m_containers.emplace_back();
+        m_containers.back().high = high;
+        m_containers.back().offset = m_size;
+    }
+    else {
+        auto it = std::lower_bound(m_containers.begin(), m_containers.end(), high, [](const Container& c, uint64_t h) {
+            return c.high < h;
+        });
+        if (it->high != high) {
+            it = m_containers.emplace(it);
+            it->high = high;
+        }
+        ndx = size_t(it - m_containers.begin());
+    }
+    if (m_containers[ndx].add(uint16_t(key.value))) {
+        ++m_size;
+        if (ndx + 1 < m_containers.size())
+            update_offsets(ndx);
+    }
+}
+
+bool ObjKeySet::contains(ObjKey key) const noexcept
+{
+    if (key.value < 0)
+        return false;
+    auto c = find_container(uint64_t(key.value) >> 16);
+    return c && c->contains(uint16_t(key.value));
+}
+
+size_t ObjKeySet::rank(ObjKey key) const noexcept
+{
+    if (key.value < 0)
+        return 0;
+    uint64_t high = uint64_t(key.value) >> 16;
+    auto it = std::lower_bound(m_containers.begin(), m_containers.end(), high, [](const Container& c, uint64_t h) {
+        return c.high < h;
+    });
+    if (it == m_containers.end())
+        return m_size;
+    if (it->high != high)
+        return it->offset;
+    return it->offset + it->rank(uint16_t(key.value));
+}
+
+ObjKey ObjKeySet::select(size_t ndx) const
+{
+    if (ndx >= m_size)
+        throw OutOfBounds("ObjKeySet::select()", ndx, m_size);
+    // Find the last container starting at or before 'ndx'
+    auto it = std::upper_bound(m_containers.begin(), m_containers.end(), ndx, [](size_t n, const Container& c) {
+        return n < c.offset;
+    });
+    --it;
+    return ObjKey(int64_t(it->high << 16) | it->select(ndx - it->offset));
+}
+
+ObjKeySet& ObjKeySet::operator&=(const ObjKeySet& other)
+{
+    std::vector<Container> result;
+    auto it = other.m_containers.begin();
+    auto end = other.m_containers.end();
+    for (auto& c : m_containers) {
+        while (it != end && it->high < c.high)
+            ++it;
+        if (it == end)
+            break;
+        if (it->high == c.high) {
+            c.intersect(*it);
+            if (c.cardinality)
+                result.push_back(std::move(c));
+        }
+    }
+    m_containers = std::move(result);
+    update_offsets(0);
+    m_size = m_containers.empty() ? 0 : m_containers.back().offset + m_containers.back().cardinality;
+    return *this;
+}
+
+ObjKeySet& ObjKeySet::operator|=(const ObjKeySet& other)
+{
+    std::vector<Container> result;
+    result.reserve(m_containers.size() + other.m_containers.size());
+    auto a = m_containers.begin();
+    auto b = other.m_containers.begin();
+    while (a != m_containers.end() || b != other.m_containers.end()) {
+        if (b == other.m_containers.end() || (a != m_containers.end() && a->high < b->high)) {
+            result.push_back(std::move(*a++));
+        }
+        else if (a == m_containers.end() || b->high < a->high) {
+            result.push_back(*b++);
+        }
+        else {
+            a->unite(*b++);
+            result.push_back(std::move(*a++));
+        }
+    }
+    m_containers = std::move(result);
+    update_offsets(0);
+    m_size = m_containers.empty() ? 0 : m_containers.back().offset + m_containers.back().cardinality;
+    return *this;
+}
+
+bool ObjKeySet::operator==(const ObjKeySet& other) const noexcept
+{
+    return m_size == other.m_size && m_containers.size() == other.m_containers.size() &&
+           std::equal(m_containers.begin(), m_containers.end(), other.m_containers.begin());
+}
+
+void ObjKeySet::optimize()
+{
+    for (auto& c : m_containers)
+        c.optimize();
+    m_containers.shrink_to_fit();
+}
+
+size_t ObjKeySet::memory_usage() const noexcept
+{
+    size_t usage = 0;
+    for (auto& c : m_containers)
+        usage += c.memory_usage();
+    return usage;
+}
+
+std::vector<ObjKey> ObjKeySet::to_vector() const
+{
+    std::vector<ObjKey> keys;
+    keys.reserve(m_size);
+    for_each([&](ObjKey key) {
+        keys.push_back(key);
+    });
+    return keys;
+}
+
+} // namespace realm
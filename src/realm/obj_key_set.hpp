@@ -0,0 +1,171 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_OBJ_KEY_SET_HPP
+#define REALM_OBJ_KEY_SET_HPP
+
+#include <realm/keys.hpp>
+#include <realm/utilities.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace realm {
+
+// A compressed set of object keys, organized like a roaring bitmap. The keys
+// are partitioned by their upper 48 bits into containers, each holding the
+// lower 16 bits of up to 65536 keys. A container with few keys is a sorted
+// array of the low bits, a container with many keys is a bitmap, and
+// optimize() turns containers into lists of runs where that is smaller. A
+// range of consecutive keys thus costs a few bytes, and a dense set of keys
+// one bit per key instead of the eight bytes of a std::vector<ObjKey>.
+//
+// The keys are kept in ascending order, and positional access is supported
+// through rank() and select(). Null and unresolved keys can't be stored.
+class ObjKeySet {
+public:
+    ObjKeySet() = default;
+    explicit ObjKeySet(const std::vector<ObjKey>& keys);
+
+    size_t size() const noexcept
+    {
+        return m_size;
+    }
+    bool empty() const noexcept
+    {
+        return m_size == 0;
+    }
+    void clear() noexcept;
+
+    // Adding keys in ascending order is the fast path
+    void add(ObjKey key);
+    bool contains(ObjKey key) const noexcept;
+
+    // Number of keys in the set which are less than 'key'
+    size_t rank(ObjKey key) const noexcept;
+    // The key at position 'ndx' in ascending order
+    ObjKey select(size_t ndx) const;
+
+    ObjKeySet& operator&=(const ObjKeySet& other);
+    ObjKeySet& operator|=(const ObjKeySet& other);
+    bool operator==(const ObjKeySet& other) const noexcept;
+    bool operator!=(const ObjKeySet& other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    // Store each container in the smallest of the three forms
+    void optimize();
+    // Number of bytes used by the containers
+    size_t memory_usage() const noexcept;
+
+    // Call 'func' for every key in ascending order
+    template <class F>
+    void for_each(F&& func) const;
+    std::vector<ObjKey> to_vector() const;
+
+private:
+    static constexpr size_t bitmap_words = 1024;
+    // Containers with more keys than this are bitmaps
+    static constexpr size_t max_array_size = 4096;
+
+    struct Container {
+        enum class Type : uint8_t { Array, Bitmap, Run };
+
+        uint64_t high = 0;
+        // Number of keys in the containers before this one
+        size_t offset = 0;
+        uint32_t cardinality = 0;
+        Type type = Type::Array;
+        // Array: the sorted low bits. Run: pairs of start and length - 1.
+        std::vector<uint16_t> values;
+        // Bitmap: one bit for every low bits value
+        std::vector<uint64_t> bits;
+
+        bool add(uint16_t low);
+        bool contains(uint16_t low) const noexcept;
+        size_t rank(uint16_t low) const noexcept;
+        uint16_t select(size_t ndx) const noexcept;
+        void to_bitmap();
+        void to_array();
+        size_t count_runs() const noexcept;
+        void optimize();
+        void intersect(const Container& other);
+        void unite(const Container& other);
+        size_t memory_usage() const noexcept;
+        bool operator==(const Container& other) const noexcept;
+
+        template <class F>
+        void for_each(F&& func) const;
+    };
+
+    std::vector<Container> m_containers;
+    size_t m_size = 0;
+
+    static int first_bit(uint64_t word) noexcept
+    {
+        uint32_t low = uint32_t(word);
+        return low ? ctz(size_t(low)) : 32 + ctz(size_t(word >> 32));
+    }
+
+    Container* find_container(uint64_t high) noexcept;
+    const Container* find_container(uint64_t high) const noexcept;
+    void update_offsets(size_t begin) noexcept;
+};
+
+template <class F>
+void ObjKeySet::Container::for_each(F&& func) const
+{
+    switch (type) {
+        case Type::Array:
+            for (auto low : values)
+                func(low);
+            break;
+        case Type::Bitmap:
+            for (size_t w = 0; w < bitmap_words; ++w) {
+                uint64_t word = bits[w];
+                while (word) {
+                    func(uint16_t(w * 64 + first_bit(word)));
+                    word &= word - 1;
+                }
+            }
+            break;
+        case Type::Run:
+            for (size_t i = 0; i < values.size(); i += 2) {
+                uint32_t end = uint32_t(values[i]) + values[i + 1];
+                for (uint32_t low = values[i]; low <= end; ++low)
+                    func(uint16_t(low));
+            }
+            break;
+    }
+}
+
+template <class F>
+void ObjKeySet::for_each(F&& func) const
+{
+    for (auto& c : m_containers) {
+        int64_t base = int64_t(c.high << 16);
+        c.for_each([&](uint16_t low) {
+            func(ObjKey(base | low));
+        });
+    }
+}
+
+} // namespace realm
+
+#endif // REALM_OBJ_KEY_SET_HPP
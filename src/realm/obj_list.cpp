@@ -22,4 +22,14 @@ namespace realm {
 
 ObjList::~ObjList() {}
 
+void ObjList::for_each_obj(util::FunctionRef<IteratorControl(const Obj&)> func) const
+{
+    auto sz = size();
+    for (size_t i = 0; i < sz; i++) {
+        auto o = get_object(i);
+        if (o && func(o) == IteratorControl::Stop)
+            return;
+    }
+}
+
 } // namespace realm
@@ -20,6 +20,7 @@
 #define REALM_OBJ_LIST_HPP
 
 #include <realm/obj.hpp>
+#include <realm/util/function_ref.hpp>
 
 namespace realm {
 
@@ -67,14 +68,12 @@ public:
     template <class F>
     void for_each(F func) const
     {
-        auto sz = size();
-        for (size_t i = 0; i < sz; i++) {
-            auto o = get_object(i);
-            if (o && func(o) == IteratorControl::Stop)
-                return;
-        }
+        for_each_obj(func);
     }
 
+    // Call 'func' for every valid object in the list, in list order, until it returns IteratorControl::Stop
+    virtual void for_each_obj(util::FunctionRef<IteratorControl(const Obj&)> func) const;
+
     template <class T>
     size_t find_first(ColKey column_key, T value) const
     {
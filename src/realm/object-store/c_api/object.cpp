@@ -141,6 +141,69 @@ RLM_API realm_object_t* realm_object_get_or_create_with_primary_key(realm_t* rea
     });
 }
 
+RLM_API bool realm_object_create_many(realm_t* realm, realm_class_key_t table_key, size_t num_objects,
+                                      const realm_property_key_t* properties, size_t num_properties,
+                                      const realm_value_t* values, bool update, realm_object_t** out_objects)
+{
+    return wrap_err([&]() {
+        auto& shared_realm = *realm;
+        auto tblkey = TableKey(table_key);
+        auto table = shared_realm->read_group().get_table(tblkey);
+        auto& object_schema = schema_for_table(shared_realm, tblkey);
+        auto pk_col = table->get_primary_key_column();
+        if (!pk_col)
+            throw InvalidArgument(ErrorCodes::UnexpectedPrimaryKey,
+                                  util::format("Class '%1' has no primary key", object_schema.name));
+
+        // Perform validation up front to avoid partial updates.
+        size_t pk_ndx = num_properties;
+        for (size_t j = 0; j < num_properties; ++j) {
+            auto col_key = ColKey(properties[j]);
+            table->check_column(col_key);
+            if (col_key.is_collection())
+                throw PropertyTypeMismatch{object_schema.name, table->get_column_name(col_key)};
+            if (col_key == pk_col)
+                pk_ndx = j;
+        }
+        if (pk_ndx == num_properties)
+            throw MissingPropertyValueException(object_schema.name, table->get_column_name(pk_col));
+
+        std::vector<Mixed> pks;
+        pks.reserve(num_objects);
+        for (size_t i = 0; i < num_objects; ++i) {
+            auto row = values + i * num_properties;
+            for (size_t j = 0; j < num_properties; ++j)
+                check_value_assignable(shared_realm, *table, ColKey(properties[j]), from_capi(row[j]));
+            pks.push_back(from_capi(row[pk_ndx]));
+        }
+
+        std::vector<bool> created;
+        auto objects = Object::get_or_create_with_primary_keys(*table, pks, created, update);
+
+        // Write one property of all objects at a time
+        for (size_t j = 0; j < num_properties; ++j) {
+            auto col_key = ColKey(properties[j]);
+            if (j == pk_ndx)
+                continue;
+            for (size_t i = 0; i < num_objects; ++i) {
+                auto val = from_capi(values[i * num_properties + j]);
+                if (!created[i]) {
+                    auto old_val = objects[i].get_any(col_key);
+                    if (val.is_same_type(old_val) && val == old_val)
+                        continue;
+                }
+                objects[i].set_any(col_key, val);
+            }
+        }
+
+        if (out_objects) {
+            for (size_t i = 0; i < num_objects; ++i)
+                out_objects[i] = new realm_object_t{Object{shared_realm, object_schema, objects[i]}};
+        }
+        return true;
+    });
+}
+
 RLM_API bool realm_object_delete(realm_object_t* obj)
 {
     return wrap_err([&]() {
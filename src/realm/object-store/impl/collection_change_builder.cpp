@@ -21,6 +21,7 @@
 #include <realm/util/assert.hpp>
 
 #include <algorithm>
+#include <numeric>
 
 using namespace realm;
 using namespace realm::_impl;
@@ -305,6 +306,7 @@ struct RowInfo {
     int64_t key;
     size_t prev_tv_index;
     size_t tv_index;
+    bool modified = false;
 };
 
 #if 0 // FIXME: this is applicable to backlinks still
@@ -499,6 +501,100 @@ private:
     }
 };
 
+// Calculates the insertions and deletions needed to turn the old order of
+// `rows` into the new one when each key appears at most once, as is always the
+// case for the objects of a sorted Results.
+//
+// The rows which are not reported as moved are the longest subsequence of rows
+// which appear in the same relative order in both the old and the new results,
+// i.e. the longest increasing subsequence of new indices when the rows are
+// taken in their old order. This is found in O(N log N) time with a Fenwick
+// tree rather than with the generic (and potentially quadratic) LCS
+// calculator. Among the subsequences of maximal length we prefer the one with
+// the fewest modified rows, so that modified rows are the ones reported as
+// moved, and then the one which keeps the rows earliest in the old order.
+void calculate_moves_unique(std::vector<RowInfo>& rows, CollectionChangeSet& changeset)
+{
+    const size_t n = rows.size();
+
+    // The indices in `rows` (which is sorted by new TV index), in old order
+    std::vector<size_t> old_order(n);
+    std::iota(old_order.begin(), old_order.end(), 0);
+    std::sort(old_order.begin(), old_order.end(), [&](size_t lft, size_t rgt) {
+        return rows[lft].prev_tv_index < rows[rgt].prev_tv_index;
+    });
+
+    // Rows before the first difference never need to move
+    size_t first_difference = 0;
+    while (first_difference < n && old_order[first_difference] == first_difference)
+        ++first_difference;
+    if (first_difference == n)
+        return;
+
+    // The best subsequence starting at the row at position `pos` in the old order
+    struct Chain {
+        size_t length;
+        size_t modified;
+        size_t pos;
+
+        bool better_than(const Chain& other) const
+        {
+            if (length != other.length)
+                return length > other.length;
+            if (modified != other.modified)
+                return modified < other.modified;
+            return pos < other.pos;
+        }
+    };
+    constexpr Chain empty = {0, 0, IndexSet::npos};
+    std::vector<size_t> next(n, IndexSet::npos);
+
+    // Fenwick tree over the new indices in reverse, so that a prefix query
+    // returns the best chain among the rows which come after a given row in
+    // the new order
+    std::vector<Chain> tree(n + 1, empty);
+    auto query = [&](size_t end) {
+        Chain best = empty;
+        for (; end > 0; end &= end - 1) {
+            if (tree[end].better_than(best))
+                best = tree[end];
+        }
+        return best;
+    };
+    auto update = [&](size_t ndx, const Chain& chain) {
+        for (++ndx; ndx <= n; ndx += ndx & (~ndx + 1)) {
+            if (chain.better_than(tree[ndx]))
+                tree[ndx] = chain;
+        }
+    };
+
+    // Build the chains from the back so that each row links to the best chain
+    // which can follow it
+    Chain best = empty;
+    for (size_t pos = n; pos > first_difference; --pos) {
+        size_t ndx = old_order[pos - 1];
+        Chain tail = query(n - 1 - ndx);
+        Chain chain = {tail.length + 1, tail.modified + rows[ndx].modified, pos - 1};
+        next[pos - 1] = tail.pos;
+        update(n - 1 - ndx, chain);
+        if (chain.better_than(best))
+            best = chain;
+    }
+
+    std::vector<bool> kept(n);
+    for (size_t pos = best.pos; pos != IndexSet::npos; pos = next[pos])
+        kept[old_order[pos]] = true;
+
+    for (size_t pos = first_difference; pos < n; ++pos) {
+        if (!kept[old_order[pos]])
+            changeset.deletions.add(rows[old_order[pos]].prev_tv_index);
+    }
+    for (size_t i = first_difference; i < n; ++i) {
+        if (!kept[i])
+            changeset.insertions.add(rows[i].tv_index);
+    }
+}
+
 void calculate_moves_sorted(std::vector<RowInfo>& rows, CollectionChangeSet& changeset)
 {
     // The RowInfo array contains information about the old and new TV indices of
@@ -612,6 +708,11 @@ void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std:
                                       return row.prev_tv_index == IndexSet::npos;
                                   }),
                    end(new_rows));
+    // new_rows is still sorted by key here. Duplicate keys can only occur for
+    // collections which may contain the same object more than once.
+    bool has_duplicates = std::adjacent_find(begin(new_rows), end(new_rows), [](auto& lft, auto& rgt) {
+                              return lft.key == rgt.key;
+                          }) != end(new_rows);
     std::sort(begin(new_rows), end(new_rows), [](auto& lft, auto& rgt) {
         return lft.tv_index < rgt.tv_index;
     });
@@ -619,11 +720,16 @@ void calculate(CollectionChangeBuilder& ret, std::vector<RowInfo> old_rows, std:
     for (auto& row : new_rows) {
         if (key_did_change(row.key)) {
             ret.modifications.add(row.tv_index);
+            row.modified = true;
         }
     }
 
-    if (!in_table_order)
+    if (in_table_order)
+        return;
+    if (has_duplicates)
         calculate_moves_sorted(new_rows, ret);
+    else
+        calculate_moves_unique(new_rows, ret);
 }
 
 template <typename T>
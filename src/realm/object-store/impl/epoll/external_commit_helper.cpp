@@ -290,7 +290,25 @@ void FdHolder::close()
 
 ExternalCommitHelper::ExternalCommitHelper(RealmCoordinator& parent, const RealmConfig& config)
     : m_parent(parent)
+    , m_change_notifier(parent.make_change_notifier())
 {
+    if (m_change_notifier) {
+        m_thread = std::thread([this] {
+            try {
+                listen_for_changes();
+            }
+            catch (std::exception const& e) {
+                LOGE("uncaught exception in notifier thread: %s: %s\n", typeid(e).name(), e.what());
+                throw;
+            }
+            catch (...) {
+                LOGE("uncaught exception in notifier thread\n");
+                throw;
+            }
+        });
+        return;
+    }
+
     // Object Store needs to create a named pipe in order to coordinate notifications.
     // This can be a problem on some file systems (e.g. FAT32) or due to security policies in SELinux. Most commonly
     // it is a problem when saving Realms on external storage:
@@ -337,10 +355,29 @@ ExternalCommitHelper::ExternalCommitHelper(RealmCoordinator& parent, const Realm
 
 ExternalCommitHelper::~ExternalCommitHelper()
 {
+    if (m_change_notifier) {
+        // Blocks until a running on_change() has completed, just like
+        // removing the pipe from the daemon thread
+        m_change_notifier->release();
+        m_thread.join();
+        return;
+    }
     DaemonThread::shared().remove(m_notify_fd, &m_parent);
 }
 
+void ExternalCommitHelper::listen_for_changes()
+{
+    pthread_setname_np(pthread_self(), "Realm notification listener");
+    while (m_change_notifier->wait()) {
+        m_parent.on_change();
+    }
+}
+
 void ExternalCommitHelper::notify_others()
 {
+    if (m_change_notifier) {
+        m_change_notifier->notify();
+        return;
+    }
     notify_fd(m_notify_fd);
 }
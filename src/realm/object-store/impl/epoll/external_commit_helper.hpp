@@ -16,7 +16,10 @@
 //
 ////////////////////////////////////////////////////////////////////////////
 
+#include <realm/db.hpp>
+
 #include <memory>
+#include <thread>
 #include <vector>
 
 namespace realm {
@@ -64,9 +67,17 @@ public:
 private:
     RealmCoordinator& m_parent;
 
+    // Commits are announced through a futex in the lock file where supported,
+    // with a thread per Realm file waiting on it. Otherwise the named pipe
+    // below is used.
+    std::unique_ptr<DB::ChangeNotifier> m_change_notifier;
+    std::thread m_thread;
+
     // Read-write file descriptor for the named pipe which is waited on for
     // changes and written to when a commit is made
     FdHolder m_notify_fd;
+
+    void listen_for_changes();
 };
 
 } // namespace _impl
@@ -218,6 +218,12 @@ public:
         return m_db->try_claim_sync_agent();
     }
 
+    // Notification of commits made by any process, or null if not supported
+    std::unique_ptr<DB::ChangeNotifier> make_change_notifier()
+    {
+        return m_db->make_change_notifier();
+    }
+
 private:
     friend Realm::Internal;
     Realm::Config m_config;
@@ -26,6 +26,8 @@
 
 #include <realm/table.hpp>
 
+#include <numeric>
+
 using namespace realm;
 
 /* The nice syntax is not supported by MSVC */
@@ -160,6 +162,52 @@ Object::Object(Object&&) = default;
 Object& Object::operator=(Object const&) = default;
 Object& Object::operator=(Object&&) = default;
 
+std::vector<Obj> Object::get_or_create_with_primary_keys(Table& table, const std::vector<Mixed>& primary_keys,
+                                                         std::vector<bool>& created, bool update)
+{
+    size_t count = primary_keys.size();
+
+    // Look up the keys in sorted order, so that consecutive lookups visit
+    // nearby parts of the primary key index. Equal keys end up next to each
+    // other in the order they were given.
+    std::vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return primary_keys[a] < primary_keys[b];
+    });
+
+    // The first position with the same key as each position, and the
+    // existing object for the first positions
+    std::vector<size_t> first(count);
+    std::vector<ObjKey> existing(count);
+    for (size_t i = 0; i < count; ++i) {
+        size_t ndx = order[i];
+        if (i > 0 && primary_keys[ndx] == primary_keys[order[i - 1]]) {
+            if (!update)
+                throw ObjectAlreadyExists(table.get_class_name(), primary_keys[ndx]);
+            first[ndx] = first[order[i - 1]];
+            continue;
+        }
+        first[ndx] = ndx;
+        existing[ndx] = table.find_primary_key(primary_keys[ndx]);
+        if (existing[ndx] && !update)
+            throw ObjectAlreadyExists(table.get_class_name(), primary_keys[ndx]);
+    }
+
+    std::vector<Obj> objects(count);
+    created.assign(count, false);
+    for (size_t i = 0; i < count; ++i) {
+        if (first[i] != i)
+            objects[i] = objects[first[i]];
+        else if (existing[i])
+            objects[i] = table.get_object(existing[i]);
+        else
+            objects[i] = table.create_object_with_primary_key(primary_keys[i]);
+        created[i] = first[i] == i && !existing[i];
+    }
+    return objects;
+}
+
 NotificationToken Object::add_notification_callback(CollectionChangeCallback callback,
                                                     std::optional<KeyPathArray> key_path_array) &
 {
@@ -22,6 +22,7 @@
 #include <realm/object-store/impl/collection_notifier.hpp>
 
 #include <realm/obj.hpp>
+#include <realm/util/span.hpp>
 
 namespace realm {
 class ObjectSchema;
@@ -179,6 +180,31 @@ public:
                          ValueType value, CreatePolicy policy = CreatePolicy::ForceCreate,
                          ObjKey current_obj = ObjKey(), Obj* = nullptr);
 
+    // create or update many Objects from their native representations.
+    // Existing objects and objects given more than once are handled as if
+    // create() was called for each value in order, but the primary keys are
+    // resolved in one batch and the properties are set one property at a time
+    // for all objects.
+    template <typename ValueType, typename ContextType>
+    static std::vector<Object> create_many(ContextType& ctx, std::shared_ptr<Realm> const& realm,
+                                           const ObjectSchema& object_schema, util::Span<ValueType> values,
+                                           CreatePolicy policy = CreatePolicy::ForceCreate);
+
+    template <typename ValueType, typename ContextType>
+    static std::vector<Object> create_many(ContextType& ctx, std::shared_ptr<Realm> const& realm,
+                                           StringData object_type, util::Span<ValueType> values,
+                                           CreatePolicy policy = CreatePolicy::ForceCreate);
+
+    // Find the objects with the given primary keys in a table with a primary
+    // key, and create the ones which don't exist. The keys are looked up in
+    // sorted order and the objects are created in the order of the keys.
+    // `created[i]` is true if the object of `primary_keys[i]` was created,
+    // which is only the case for the first of several equal keys. If `update`
+    // is false, ObjectAlreadyExists is thrown before any object is created if
+    // any of the keys exists or is given more than once.
+    static std::vector<Obj> get_or_create_with_primary_keys(Table& table, const std::vector<Mixed>& primary_keys,
+                                                            std::vector<bool>& created, bool update = true);
+
     template <typename ValueType, typename ContextType>
     static Object get_for_primary_key(ContextType& ctx, std::shared_ptr<Realm> const& realm,
                                       const ObjectSchema& object_schema, ValueType primary_value);
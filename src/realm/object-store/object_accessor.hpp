@@ -403,6 +403,90 @@ Object Object::create(ContextType& ctx, std::shared_ptr<Realm> const& realm, Obj
     return object;
 }
 
+template <typename ValueType, typename ContextType>
+std::vector<Object> Object::create_many(ContextType& ctx, std::shared_ptr<Realm> const& realm,
+                                        StringData object_type, util::Span<ValueType> values, CreatePolicy policy)
+{
+    auto object_schema = realm->schema().find(object_type);
+    REALM_ASSERT(object_schema != realm->schema().end());
+    return create_many(ctx, realm, *object_schema, values, policy);
+}
+
+template <typename ValueType, typename ContextType>
+std::vector<Object> Object::create_many(ContextType& ctx, std::shared_ptr<Realm> const& realm,
+                                        ObjectSchema const& object_schema, util::Span<ValueType> values,
+                                        CreatePolicy policy)
+{
+    realm->verify_in_write();
+
+    std::vector<Object> objects;
+    objects.reserve(values.size());
+    auto table = realm->read_group().get_table(object_schema.table_key);
+    auto primary_prop = object_schema.primary_key_property();
+
+    // Embedded and asymmetric objects, and tables which temporarily have no
+    // primary key during a migration, are created one at a time.
+    if (object_schema.table_type != ObjectSchema::ObjectType::TopLevel ||
+        (primary_prop && table->get_primary_key_column() == ColKey{})) {
+        for (auto& value : values)
+            objects.push_back(create(ctx, realm, object_schema, value, policy));
+        return objects;
+    }
+
+    std::vector<bool> created;
+    if (primary_prop) {
+        size_t primary_ndx = primary_prop - &object_schema.persisted_properties[0];
+        // The unboxed keys may refer to the values, so those must stay alive
+        // and in place until the objects are created
+        std::vector<decltype(ctx.value_for_property(values[0], *primary_prop, primary_ndx))> primary_values;
+        primary_values.reserve(values.size());
+        for (auto& value : values) {
+            auto primary_value = ctx.value_for_property(value, *primary_prop, primary_ndx);
+            if (!primary_value)
+                primary_value = ctx.default_value_for_property(object_schema, *primary_prop);
+            if (!primary_value && !is_nullable(primary_prop->type))
+                throw MissingPropertyValueException(object_schema.name, primary_prop->name);
+            primary_values.push_back(std::move(primary_value));
+        }
+        std::vector<Mixed> primary_keys;
+        primary_keys.reserve(values.size());
+        for (auto& primary_value : primary_values)
+            primary_keys.push_back(as_mixed(ctx, primary_value, primary_prop->type));
+        for (auto& obj : get_or_create_with_primary_keys(*table, primary_keys, created, policy.update))
+            objects.push_back(Object(realm, object_schema, obj));
+    }
+    else {
+        for (size_t i = 0; i < values.size(); ++i)
+            objects.push_back(Object(realm, object_schema, table->create_object()));
+        created.assign(values.size(), true);
+    }
+
+    // Set one property of all objects at a time
+    for (size_t i = 0; i < object_schema.persisted_properties.size(); ++i) {
+        auto& prop = object_schema.persisted_properties[i];
+        if (prop.is_primary)
+            continue;
+        for (size_t j = 0; j < values.size(); ++j) {
+            auto v = ctx.value_for_property(values[j], prop, i);
+            if (!created[j] && !v)
+                continue;
+
+            bool is_default = false;
+            if (!v) {
+                v = ctx.default_value_for_property(object_schema, prop);
+                is_default = true;
+            }
+            if ((!v || ctx.is_null(*v)) && !is_nullable(prop.type) && !is_collection(prop.type)) {
+                if (!ctx.allow_missing(values[j]))
+                    throw MissingPropertyValueException(object_schema.name, prop.name);
+            }
+            if (v)
+                objects[j].set_property_value_impl(ctx, prop, *v, policy, is_default);
+        }
+    }
+    return objects;
+}
+
 template <typename ValueType, typename ContextType>
 Object Object::get_for_primary_key(ContextType& ctx, std::shared_ptr<Realm> const& realm, StringData object_type,
                                    ValueType primary_value)
@@ -339,10 +339,16 @@ inline Property::Property(std::string name, PropertyType type, std::string objec
 
 inline bool Property::type_is_indexable() const noexcept
 {
-    return (!is_collection(type) || (is_array(type) && type == PropertyType::String)) &&
-           (type == PropertyType::Int || type == PropertyType::Bool || type == PropertyType::Date ||
-            type == PropertyType::String || type == PropertyType::ObjectId || type == PropertyType::UUID ||
-            type == PropertyType::Mixed);
+    if (is_dictionary(type))
+        return false;
+    if (is_collection(type)) {
+        // Lists and sets are indexed by their elements
+        return type == PropertyType::Int || type == PropertyType::Date || type == PropertyType::String ||
+               type == PropertyType::ObjectId || type == PropertyType::UUID;
+    }
+    return type == PropertyType::Int || type == PropertyType::Bool || type == PropertyType::Date ||
+           type == PropertyType::String || type == PropertyType::ObjectId || type == PropertyType::UUID ||
+           type == PropertyType::Mixed;
 }
 
 inline bool Property::type_is_nullable() const noexcept
@@ -1014,10 +1014,10 @@ SectionedResults Results::sectioned_results(SectionedResults::SectionKeyFunc&& s
     return SectionedResults(*this, std::move(section_key_func));
 }
 
-SectionedResults Results::sectioned_results(SectionedResultsOperator op, util::Optional<StringData> prop_name)
-    REQUIRES(m_mutex)
+SectionedResults Results::sectioned_results(SectionedResultsOperator op, util::Optional<StringData> prop_name,
+                                            int64_t argument) REQUIRES(m_mutex)
 {
-    return SectionedResults(*this, op, prop_name.value_or(StringData()));
+    return SectionedResults(*this, op, prop_name.value_or(StringData()), argument);
 }
 
 Results Results::snapshot() const&
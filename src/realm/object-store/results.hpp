@@ -317,21 +317,25 @@ public:
     SectionedResults sectioned_results(
         util::UniqueFunction<Mixed(Mixed value, const std::shared_ptr<Realm>& realm)>&& section_key_func);
     enum class SectionedResultsOperator {
-        FirstLetter // Section by the first letter of each string element. Note that col must be a string.
+        FirstLetter, // Section by the first letter of each string element. Note that col must be a string.
+        Value,       // Section by the value of each element.
+        Prefix,      // Section by the first `argument` characters of each string element.
+        DateBucket,  // Section timestamps into buckets of `argument` seconds counted from the UNIX epoch.
     };
 
     /**
      * Creates a SectionedResults object by using a built in sectioning algorithm to help with efficiency and reduce
-     * overhead from the SDK level.
+     * overhead from the SDK level. The section keys are computed in core without calling back into the SDK.
      *
      * @param op The `SectionedResultsOperator` operator to use
      * @param property_name Takes a property name if sectioning on a collection of links, the property name needs to
-     * reference the column being sectioned on.
+     * reference the column being sectioned on. This may be a key path through to-one links, e.g. "owner.name".
+     * @param argument The length of the prefix for `Prefix` and the bucket size in seconds for `DateBucket`.
      *
      * @return A SectionedResults object with results sectioned based on the chosen built in operator.
      */
     SectionedResults sectioned_results(SectionedResultsOperator op,
-                                       util::Optional<StringData> property_name = util::none);
+                                       util::Optional<StringData> property_name = util::none, int64_t argument = 0);
 
 private:
     std::shared_ptr<Realm> m_realm;
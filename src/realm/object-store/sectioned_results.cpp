@@ -22,28 +22,136 @@
 
 namespace realm {
 
-static SectionedResults::SectionKeyFunc builtin_comparison(Results& results, Results::SectionedResultsOperator op,
-                                                           StringData prop_name)
+static const char* name_for_operator(Results::SectionedResultsOperator op)
 {
     switch (op) {
         case Results::SectionedResultsOperator::FirstLetter:
-            if (results.get_type() == PropertyType::Object) {
-                auto col_key = results.get_table()->get_column_key(prop_name);
-                return [col_key](Mixed value, const SharedRealm& realm) {
-                    auto link = value.get_link();
-                    auto v = realm->read_group().get_object(link).get<StringData>(col_key);
-                    return v.size() > 0 ? v.prefix(1) : "";
-                };
+            return "FirstLetter";
+        case Results::SectionedResultsOperator::Value:
+            return "Value";
+        case Results::SectionedResultsOperator::Prefix:
+            return "Prefix";
+        case Results::SectionedResultsOperator::DateBucket:
+            return "DateBucket";
+    }
+    return "unknown";
+}
+
+// Resolve a key path through to-one links to the columns to follow, and check
+// that the operator can be applied to the type of the final property.
+static std::vector<ColKey> resolve_section_key_path(Results& results, Results::SectionedResultsOperator op,
+                                                    StringData key_path, int64_t argument)
+{
+    auto check = [&](bool condition, const char* fmt, auto... args) {
+        if (!condition) {
+            throw InvalidArgument(util::format("Cannot section on key path '%1' using '%2': %3.", key_path,
+                                               name_for_operator(op), util::format(fmt, args...)));
+        }
+    };
+
+    std::vector<ColKey> columns;
+    PropertyType type = results.get_type();
+    if (type == PropertyType::Object) {
+        auto& schema = results.get_realm()->schema();
+        const ObjectSchema* object_schema = &results.get_object_schema();
+        const char* begin = key_path.data();
+        const char* end = key_path.data() + key_path.size();
+        check(begin != end, "missing property name");
+        while (begin != end) {
+            auto sep = std::find(begin, end, '.');
+            check(sep != begin && sep + 1 != end, "missing property name");
+            StringData name(begin, sep - begin);
+            begin = sep + (sep != end);
+
+            auto prop = object_schema->property_for_public_name(name);
+            if (!prop)
+                prop = object_schema->property_for_name(name);
+            check(prop, "property '%1.%2' does not exist", object_schema->name, name);
+            check(!is_collection(prop->type) && prop->type != PropertyType::LinkingObjects,
+                  "property '%1.%2' is of unsupported type '%3'", object_schema->name, name, prop->type_string());
+            if (prop->type == PropertyType::Object) {
+                check(begin != end, "property '%1.%2' of type 'object' cannot be the final property in the key path",
+                      object_schema->name, name);
+                object_schema = &*schema.find(prop->object_type);
             }
             else {
-                return [](Mixed value, const SharedRealm&) {
-                    auto v = value.get_string();
-                    return v.size() > 0 ? v.prefix(1) : "";
-                };
+                check(begin == end, "property '%1.%2' of type '%3' may only be the final property in the key path",
+                      object_schema->name, name, prop->type_string());
             }
-        default:
-            throw LogicError(ErrorCodes::IllegalOperation, "Builtin section algorithm not implemented.");
+            columns.push_back(prop->column_key);
+            type = prop->type;
+        }
+    }
+
+    switch (op) {
+        case Results::SectionedResultsOperator::FirstLetter:
+            check(type == PropertyType::String, "property must be of type 'string'");
+            break;
+        case Results::SectionedResultsOperator::Value:
+            break;
+        case Results::SectionedResultsOperator::Prefix:
+            check(type == PropertyType::String, "property must be of type 'string'");
+            check(argument > 0, "prefix length must be positive");
+            break;
+        case Results::SectionedResultsOperator::DateBucket:
+            check(type == PropertyType::Date, "property must be of type 'date'");
+            check(argument > 0, "bucket size must be positive");
+            break;
+    }
+    return columns;
+}
+
+// The first `length` code points of a UTF-8 encoded string
+static StringData utf8_prefix(StringData str, int64_t length)
+{
+    size_t end = 0;
+    for (; end < str.size(); ++end) {
+        if ((static_cast<unsigned char>(str[end]) & 0xC0) != 0x80 && length-- == 0)
+            break;
+    }
+    return str.prefix(end);
+}
+
+// Floor of the timestamp to a multiple of `bucket_size` seconds since the epoch
+static Timestamp date_bucket(Timestamp ts, int64_t bucket_size)
+{
+    int64_t seconds = ts.get_seconds();
+    // Negative timestamps have a negative nanoseconds part
+    if (ts.get_nanoseconds() < 0)
+        --seconds;
+    int64_t bucket = seconds / bucket_size;
+    if (seconds % bucket_size < 0)
+        --bucket;
+    return Timestamp(bucket * bucket_size, 0);
+}
+
+Mixed SectionedResults::BuiltinSectionKey::operator()(Results& results, size_t row) const
+{
+    Mixed value;
+    if (key_path.empty()) {
+        value = results.get_any(row);
+    }
+    else {
+        Obj obj = results.get<Obj>(row);
+        for (size_t i = 0; i + 1 < key_path.size() && obj; ++i)
+            obj = obj.get_linked_object(key_path[i]);
+        if (obj)
+            value = obj.get_any(key_path.back());
+    }
+
+    switch (op) {
+        case Results::SectionedResultsOperator::FirstLetter: {
+            auto str = value.is_null() ? StringData("", 0) : value.get_string();
+            return str.size() > 0 ? str.prefix(1) : StringData("", 0);
+        }
+        case Results::SectionedResultsOperator::Value:
+            return value;
+        case Results::SectionedResultsOperator::Prefix:
+            return value.is_null() ? value : Mixed(utf8_prefix(value.get_string(), argument));
+        case Results::SectionedResultsOperator::DateBucket:
+            return value.is_null() ? value : Mixed(date_bucket(value.get_timestamp(), argument));
     }
+    REALM_UNREACHABLE();
 }
 
 namespace {
@@ -84,11 +192,12 @@ struct SectionedResultsNotificationHandler {
 public:
     SectionedResultsNotificationHandler(SectionedResults& sectioned_results,
                                         SectionedResultsNotificationCallback&& cb,
-                                        util::Optional<Mixed> section_filter = util::none)
+                                        util::Optional<Mixed> section_filter, bool has_key_path_filter)
         : m_cb(std::move(cb))
         , m_sectioned_results(sectioned_results)
         , m_prev_row_to_index_path(m_sectioned_results.m_row_to_index_path)
         , m_section_filter(section_filter)
+        , m_has_key_path_filter(has_key_path_filter)
     {
     }
 
@@ -96,7 +205,11 @@ public:
     {
         util::CheckedUniqueLock lock(m_sectioned_results.m_mutex);
 
-        m_sectioned_results.calculate_sections_if_required();
+        // The changes describe the changes since the version this handler was
+        // last called for. A key path filter may hide modifications of the
+        // properties the section keys are computed from.
+        m_sectioned_results.calculate_sections_if_required(&c, m_has_key_path_filter ? util::none : m_version);
+        m_version = m_sectioned_results.m_row_keys_version;
         section_initial_changes(c);
         m_prev_row_to_index_path = m_sectioned_results.m_row_to_index_path;
 
@@ -187,6 +300,9 @@ private:
     // change indices referring to the supplied section key.
     util::Optional<Mixed> m_section_filter;
     bool m_section_filter_should_deliver_initial_notification = true;
+    bool m_has_key_path_filter;
+    // The version of the results this handler was last called for
+    util::Optional<VersionID> m_version;
 
     // Group the changes in the changeset by the section
     void section_initial_changes(CollectionChangeSet const& c) REQUIRES(m_sectioned_results.m_mutex)
@@ -382,32 +498,103 @@ SectionedResults::SectionedResults(Results results, SectionKeyFunc section_key_f
 {
 }
 
-SectionedResults::SectionedResults(Results results, Results::SectionedResultsOperator op, StringData prop_name)
+SectionedResults::SectionedResults(Results results, Results::SectionedResultsOperator op, StringData prop_name,
+                                   int64_t argument)
     : m_results(results)
-    , m_callback(builtin_comparison(results, op, prop_name))
+    , m_builtin(BuiltinSectionKey{op, resolve_section_key_path(results, op, prop_name, argument), argument})
 {
 }
 
-void SectionedResults::calculate_sections_if_required()
+void SectionedResults::calculate_sections_if_required(const CollectionChangeSet* changes,
+                                                      util::Optional<VersionID> changes_since)
 {
     if (m_results.m_update_policy == Results::UpdatePolicy::Never)
         return;
-    if ((m_results.is_frozen() || !m_results.has_changed()) && m_has_performed_initial_evaluation)
-        return;
+    auto& realm = m_results.get_realm();
+    if ((m_results.is_frozen() || !m_results.has_changed()) && m_has_performed_initial_evaluation) {
+        // The rows of the results are unchanged, but the properties the keys
+        // are computed from may have changed through a link.
+        if (!changes || changes->modifications_new.empty() ||
+            m_row_keys_version == realm->current_transaction_version())
+            return;
+    }
 
     {
         util::CheckedUniqueLock lock(m_results.m_mutex);
         m_results.ensure_up_to_date();
     }
 
-    calculate_sections();
+    bool can_use_changes = m_has_performed_initial_evaluation && changes_since && changes_since == m_row_keys_version;
+    calculate_sections(can_use_changes ? changes : nullptr);
+
+    // Notifications are delivered for a version before any local changes are
+    // made to it, but otherwise the rows may change without a new version
+    // inside a write transaction.
+    if (changes || !realm->is_in_transaction())
+        m_row_keys_version = realm->current_transaction_version();
+    else
+        m_row_keys_version = util::none;
+}
+
+Mixed SectionedResults::compute_section_key(size_t row)
+{
+    if (m_builtin)
+        return (*m_builtin)(m_results, row);
+    return m_callback(m_results.get_any(row), m_results.get_realm());
 }
 
 // This method will run in the following scenarios:
 // - SectionedResults is performing its initial evaluation.
 // - The underlying Table in the Results collection has changed
-void SectionedResults::calculate_sections()
+//
+// If the changes to the results are known, only the keys of inserted and
+// modified rows are computed and the other rows reuse their previous key. The
+// sections are still rebuilt in a single pass so that their order is the same
+// as if all keys were computed.
+void SectionedResults::calculate_sections(const CollectionChangeSet* changes)
 {
+    size_t size = m_results.size();
+
+    // The previous row of each row, or npos if its key must be computed. The
+    // previous keys refer to the buffers which are moved to
+    // `m_previous_str_buffers` below, so they stay valid during this pass.
+    std::vector<size_t> previous_row;
+    std::vector<Mixed> previous_keys;
+    previous_keys.swap(m_row_keys);
+    if (changes) {
+        previous_row.resize(size, npos);
+        auto insertions = changes->insertions.as_indexes();
+        auto deletions = changes->deletions.as_indexes();
+        auto next_insertion = insertions.begin();
+        auto next_deletion = deletions.begin();
+        size_t old_row = 0;
+        for (size_t i = 0; i < size; ++i) {
+            if (next_insertion != insertions.end() && *next_insertion == i) {
+                ++next_insertion;
+                continue;
+            }
+            while (next_deletion != deletions.end() && *next_deletion == old_row) {
+                ++next_deletion;
+                ++old_row;
+            }
+            previous_row[i] = old_row++;
+        }
+        while (next_deletion != deletions.end() && *next_deletion == old_row) {
+            ++next_deletion;
+            ++old_row;
+        }
+        if (old_row != previous_keys.size()) {
+            // The changes don't describe the transition from the previous keys
+            previous_row.clear();
+        }
+        else {
+            for (auto i : changes->modifications_new.as_indexes()) {
+                if (i < size)
+                    previous_row[i] = npos;
+            }
+        }
+    }
+
     m_previous_str_buffers.clear();
     m_previous_str_buffers.swap(m_current_str_buffers);
     m_previous_key_to_index.clear();
@@ -419,15 +606,21 @@ void SectionedResults::calculate_sections()
 
     m_sections.clear();
     m_row_to_index_path.clear();
-    size_t size = m_results.size();
     m_row_to_index_path.resize(size);
+    m_row_keys.resize(size);
 
     for (size_t i = 0; i < size; ++i) {
-        Mixed key = m_callback(m_results.get_any(i), m_results.get_realm());
-        // Disallow links as section keys. It would be uncommon to use them to begin with
-        // and if the object acting as the key was deleted bad things would happen.
-        if (key.is_type(type_Link, type_TypedLink)) {
-            throw InvalidArgument("Links are not supported as section keys.");
+        Mixed key;
+        if (!previous_row.empty() && previous_row[i] != npos) {
+            key = previous_keys[previous_row[i]];
+        }
+        else {
+            key = compute_section_key(i);
+            // Disallow links as section keys. It would be uncommon to use them to begin with
+            // and if the object acting as the key was deleted bad things would happen.
+            if (key.is_type(type_Link, type_TypedLink)) {
+                throw InvalidArgument("Links are not supported as section keys.");
+            }
         }
 
         auto it = m_current_key_to_index.find(key);
@@ -437,11 +630,13 @@ void SectionedResults::calculate_sections()
             m_sections.push_back(Section{idx, key, {i}});
             m_current_key_to_index[key] = idx;
             m_row_to_index_path[i] = {idx, 0};
+            m_row_keys[i] = key;
         }
         else {
             auto& section = m_sections[it->second];
             section.indices.push_back(i);
             m_row_to_index_path[i] = {section.index, section.indices.size() - 1};
+            m_row_keys[i] = section.key;
         }
     }
     if (!m_has_performed_initial_evaluation) {
@@ -487,15 +682,19 @@ ResultsSection SectionedResults::operator[](Mixed key)
 NotificationToken SectionedResults::add_notification_callback(SectionedResultsNotificationCallback&& callback,
                                                               std::optional<KeyPathArray> key_path_array) &
 {
-    return m_results.add_notification_callback(SectionedResultsNotificationHandler(*this, std::move(callback)),
-                                               std::move(key_path_array));
+    bool has_key_path_filter = key_path_array.has_value();
+    return m_results.add_notification_callback(
+        SectionedResultsNotificationHandler(*this, std::move(callback), util::none, has_key_path_filter),
+        std::move(key_path_array));
 }
 
 NotificationToken SectionedResults::add_notification_callback_for_section(
     Mixed section_key, SectionedResultsNotificationCallback&& callback, std::optional<KeyPathArray> key_path_array)
 {
+    bool has_key_path_filter = key_path_array.has_value();
     return m_results.add_notification_callback(
-        SectionedResultsNotificationHandler(*this, std::move(callback), section_key), std::move(key_path_array));
+        SectionedResultsNotificationHandler(*this, std::move(callback), section_key, has_key_path_filter),
+        std::move(key_path_array));
 }
 
 // Thread-safety analysis doesn't work when creating a different instance of the
@@ -546,11 +745,14 @@ void SectionedResults::reset_section_callback(SectionKeyFunc section_callback)
 {
     util::CheckedUniqueLock lock(m_mutex);
     m_callback = std::move(section_callback);
+    m_builtin.reset();
     m_has_performed_initial_evaluation = false;
     m_sections.clear();
     m_previous_index_to_key.clear();
     m_current_key_to_index.clear();
     m_previous_key_to_index.clear();
     m_row_to_index_path.clear();
+    m_row_keys.clear();
+    m_row_keys_version = util::none;
 }
 } // namespace realm
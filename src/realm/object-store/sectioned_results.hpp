@@ -22,6 +22,7 @@
 #include <realm/object-store/results.hpp>
 
 #include <list>
+#include <optional>
 #include <unordered_map>
 
 namespace realm {
@@ -155,21 +156,38 @@ public:
     void check_valid() const; // Throws if not valid
     bool is_frozen() const REQUIRES(!m_mutex);
     /// Replaces the function which will perform the sectioning on the underlying results.
+    /// This also replaces a built in sectioning algorithm.
     void reset_section_callback(SectionKeyFunc section_callback) REQUIRES(!m_mutex);
 
 private:
     friend class Results;
     friend class realm::ResultsSection;
 
+    // A built in sectioning algorithm, which is evaluated directly on the
+    // objects in the results without calling back into the SDK.
+    struct BuiltinSectionKey {
+        Results::SectionedResultsOperator op;
+        // The columns of the key path. Empty if the results are not objects.
+        std::vector<ColKey> key_path;
+        int64_t argument;
+
+        Mixed operator()(Results& results, size_t row) const;
+    };
+
     /// SectionedResults should not be created directly and should only be instantiated from `Results`.
     SectionedResults(Results results, SectionKeyFunc section_key_func);
-    SectionedResults(Results results, Results::SectionedResultsOperator op, StringData prop_name);
+    SectionedResults(Results results, Results::SectionedResultsOperator op, StringData prop_name,
+                     int64_t argument);
 
     friend struct SectionedResultsNotificationHandler;
     util::CheckedOptionalMutex m_mutex;
     SectionedResults copy(Results&&) REQUIRES(!m_mutex);
-    void calculate_sections_if_required() REQUIRES(m_mutex);
-    void calculate_sections() REQUIRES(m_mutex);
+    // `changes` is given when called from a notification handler. If it describes the changes since the version
+    // the section keys were computed for, only the keys of the rows which were inserted or modified are recomputed.
+    void calculate_sections_if_required(const CollectionChangeSet* changes = nullptr,
+                                        util::Optional<VersionID> changes_since = util::none) REQUIRES(m_mutex);
+    void calculate_sections(const CollectionChangeSet* changes = nullptr) REQUIRES(m_mutex);
+    Mixed compute_section_key(size_t row);
     bool m_has_performed_initial_evaluation = false;
     NotificationToken
     add_notification_callback_for_section(Mixed section_key, SectionedResultsNotificationCallback&& callback,
@@ -177,8 +195,14 @@ private:
 
     Results m_results;
     SectionKeyFunc m_callback;
+    std::optional<BuiltinSectionKey> m_builtin;
     std::vector<Section> m_sections GUARDED_BY(m_mutex);
 
+    // The section key of each row in the underlying `Results` and the version they were computed for.
+    // The keys refer to `m_current_str_buffers`.
+    std::vector<Mixed> m_row_keys;
+    util::Optional<VersionID> m_row_keys_version;
+
     // Returns the key of the current section from its index.
     // Returns the key of the previous section from its index.
     std::vector<Mixed> m_previous_index_to_key;
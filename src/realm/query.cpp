@@ -22,13 +22,17 @@
 #include <realm/array_integer_tpl.hpp>
 #include <realm/transaction.hpp>
 #include <realm/dictionary.hpp>
+#include <realm/group_by.hpp>
+#include <realm/query_cache.hpp>
 #include <realm/query_conditions_tpl.hpp>
 #include <realm/query_engine.hpp>
 #include <realm/query_expression.hpp>
 #include <realm/table_view.hpp>
 #include <realm/set.hpp>
+#include <realm/vector_index.hpp>
 
 #include <algorithm>
+#include <cstring>
 
 using namespace realm;
 
@@ -1124,14 +1128,13 @@ void Query::aggregate(QueryStateBase& st, ColKey column_key) const
                 // all the objects will match this condition
                 pn->m_children[best] = pn->m_children.back();
                 pn->m_children.pop_back();
-                const size_t num_keys = keys->size();
-                for (size_t i = 0; i < num_keys; ++i) {
-                    auto obj = m_table->get_object(keys->get(i));
+                for_each_index_match(*keys, [&](const Obj& obj) {
                     if (pn->m_children.empty() || eval_object(obj)) {
                         st.m_key_offset = obj.get_key().value;
                         st.match(0, obj.get<T>(column_key));
                     }
-                }
+                    return IteratorControl::AdvanceToNext;
+                });
             }
             else {
                 // no index, traverse cluster tree
@@ -1163,6 +1166,25 @@ void Query::aggregate(QueryStateBase& st, ColKey column_key) const
     }
 }
 
+void Query::for_each_index_match(const IndexEvaluator& keys,
+                                 util::FunctionRef<IteratorControl(const Obj&)> func) const
+{
+    std::vector<ObjKey> batch;
+    std::vector<Obj> objects;
+    const size_t num_keys = keys.size();
+    for (size_t begin = 0; begin < num_keys; begin += Table::object_batch_size) {
+        size_t end = std::min(begin + Table::object_batch_size, num_keys);
+        batch.clear();
+        for (size_t i = begin; i < end; ++i)
+            batch.push_back(keys.get(i));
+        m_table->get_objects(batch.data(), batch.size(), objects);
+        for (auto& obj : objects) {
+            if (func(obj) == IteratorControl::Stop)
+                return;
+        }
+    }
+}
+
 size_t Query::find_best_node(ParentNode* pn) const
 {
     auto score_compare = [](const ParentNode* a, const ParentNode* b) {
@@ -1227,22 +1249,119 @@ void Query::aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start,
 
 std::optional<Mixed> Query::sum(ColKey col_key) const
 {
-    return AggregateHelper<Query>::sum(*m_table, *this, col_key);
+    QueryResultCache::Operation cached(*this, "sum", col_key);
+    QueryResultCache::Result result;
+    if (!cached.find(result)) {
+        result.value = AggregateHelper<Query>::sum(*m_table, *this, col_key);
+        cached.store(result);
+    }
+    return result.value;
 }
 
 std::optional<Mixed> Query::avg(ColKey col_key, size_t* value_count) const
 {
-    return AggregateHelper<Query>::avg(*m_table, *this, col_key, value_count);
+    QueryResultCache::Operation cached(*this, "avg", col_key);
+    QueryResultCache::Result result;
+    if (!cached.find(result)) {
+        result.value = AggregateHelper<Query>::avg(*m_table, *this, col_key, &result.count);
+        cached.store(result);
+    }
+    if (value_count)
+        *value_count = result.count;
+    return result.value;
 }
 
 std::optional<Mixed> Query::min(ColKey col_key, ObjKey* return_ndx) const
 {
-    return AggregateHelper<Query>::min(*m_table, *this, col_key, return_ndx);
+    QueryResultCache::Operation cached(*this, "min", col_key);
+    QueryResultCache::Result result;
+    if (!cached.find(result)) {
+        result.value = AggregateHelper<Query>::min(*m_table, *this, col_key, &result.key);
+        cached.store(result);
+    }
+    if (return_ndx)
+        *return_ndx = result.key;
+    return result.value;
 }
 
 std::optional<Mixed> Query::max(ColKey col_key, ObjKey* return_ndx) const
 {
-    return AggregateHelper<Query>::max(*m_table, *this, col_key, return_ndx);
+    QueryResultCache::Operation cached(*this, "max", col_key);
+    QueryResultCache::Result result;
+    if (!cached.find(result)) {
+        result.value = AggregateHelper<Query>::max(*m_table, *this, col_key, &result.key);
+        cached.store(result);
+    }
+    if (return_ndx)
+        *return_ndx = result.key;
+    return result.value;
+}
+
+GroupBy Query::group_by(std::vector<GroupByKey> keys) const
+{
+    return GroupBy(*this, std::move(keys));
+}
+
+void Query::do_group_by(GroupByState& st) const
+{
+    if (m_ordering && (m_ordering->will_apply_distinct() || m_ordering->will_apply_limit() ||
+                       m_ordering->will_apply_filter())) {
+        // The set of objects depends on the ordering, so it must be applied first
+        find_all().for_each([&](const Obj& obj) {
+            st.accumulate(obj);
+            return IteratorControl::AdvanceToNext;
+        });
+        return;
+    }
+
+    init();
+
+    if (m_view) {
+        m_view->for_each([&](const Obj& obj) {
+            if (eval_object(obj)) {
+                st.accumulate(obj);
+            }
+            return IteratorControl::AdvanceToNext;
+        });
+    }
+    else if (!has_conditions()) {
+        m_table->traverse_clusters([&st](const Cluster* cluster) {
+            size_t sz = cluster->node_size();
+            st.set_cluster(cluster);
+            for (size_t i = 0; i < sz; i++) {
+                st.accumulate(i);
+            }
+            return IteratorControl::AdvanceToNext;
+        });
+    }
+    else {
+        auto pn = root_node();
+        auto best = find_best_node(pn);
+        auto node = pn->m_children[best];
+        if (auto keys = node->index_based_keys()) {
+            // The node having the search index can be removed from the query as we know that
+            // all the objects will match this condition
+            pn->m_children[best] = pn->m_children.back();
+            pn->m_children.pop_back();
+            for_each_index_match(*keys, [&](const Obj& obj) {
+                if (pn->m_children.empty() || eval_object(obj)) {
+                    st.accumulate(obj);
+                }
+                return IteratorControl::AdvanceToNext;
+            });
+        }
+        else {
+            QueryStateGroupBy state(st);
+            node = pn;
+            m_table->traverse_clusters([&node, &st, &state, this](const Cluster* cluster) {
+                size_t e = cluster->node_size();
+                node->set_cluster(cluster);
+                st.set_cluster(cluster);
+                aggregate_internal(node, &state, 0, e, nullptr);
+                return IteratorControl::AdvanceToNext;
+            });
+        }
+    }
 }
 
 // Grouping
@@ -1389,7 +1508,7 @@ ObjKey Query::find() const
     return ret;
 }
 
-void Query::do_find_all(QueryStateBase& st) const
+void Query::do_find_all(QueryStateBase& st, ObjKey first_key) const
 {
     auto logger = m_table->get_logger();
     std::chrono::steady_clock::time_point t1;
@@ -1414,7 +1533,14 @@ void Query::do_find_all(QueryStateBase& st) const
 
     bool has_cond = has_conditions();
 
+    // Index of the first object in the cluster to consider
+    auto first_in_cluster = [first_key](const Cluster* cluster) -> size_t {
+        int64_t k = first_key.value - int64_t(cluster->get_offset());
+        return k > 0 ? cluster->lower_bound_key(ClusterNode::RowKey(uint64_t(k))) : 0;
+    };
+
     if (m_view) {
+        REALM_ASSERT(!first_key);
         size_t sz = m_view->size();
         for (size_t t = 0; t < sz; t++) {
             const Obj obj = m_view->get_object(t);
@@ -1427,18 +1553,18 @@ void Query::do_find_all(QueryStateBase& st) const
     }
     else {
         if (!has_cond) {
-            auto f = [&st](const Cluster* cluster) {
+            auto f = [&st, &first_in_cluster](const Cluster* cluster) {
                 size_t sz = cluster->node_size();
                 st.m_key_offset = cluster->get_offset();
                 st.m_key_values = cluster->get_key_array();
-                for (size_t i = 0; i < sz; i++) {
+                for (size_t i = first_in_cluster(cluster); i < sz; i++) {
                     if (!st.match(i, Mixed()))
                         return IteratorControl::Stop;
                 }
                 return IteratorControl::AdvanceToNext;
             };
 
-            m_table->traverse_clusters(f);
+            m_table->traverse_clusters(f, first_key);
         }
         else {
             auto pn = root_node();
@@ -1450,39 +1576,45 @@ void Query::do_find_all(QueryStateBase& st) const
                 pn->m_children[best] = pn->m_children.back();
                 pn->m_children.pop_back();
 
-                const size_t num_keys = keys->size();
-                for (size_t i = 0; i < num_keys; ++i) {
-                    ObjKey key = keys->get(i);
-                    st.m_key_offset = key.value;
-                    if (pn->m_children.empty()) {
-                        // No more conditions - just add key
+                if (pn->m_children.empty()) {
+                    // No more conditions - just add key
+                    const size_t num_keys = keys->size();
+                    for (size_t i = 0; i < num_keys; ++i) {
+                        ObjKey key = keys->get(i);
+                        if (key.value < first_key.value)
+                            continue;
+                        st.m_key_offset = key.value;
                         if (!st.match(0, Mixed()))
                             break;
                     }
-                    else {
-                        auto obj = m_table->get_object(key);
-                        if (eval_object(obj)) {
+                }
+                else {
+                    for_each_index_match(*keys, [&](const Obj& obj) {
+                        ObjKey key = obj.get_key();
+                        if (key.value >= first_key.value && eval_object(obj)) {
+                            st.m_key_offset = key.value;
                             if (!st.match(0, Mixed()))
-                                break;
+                                return IteratorControl::Stop;
                         }
-                    }
+                        return IteratorControl::AdvanceToNext;
+                    });
                 }
             }
             else {
                 // no index on best node (and likely no index at all), descend B+-tree
                 node = pn;
 
-                auto f = [&node, &st, this](const Cluster* cluster) {
+                auto f = [&node, &st, &first_in_cluster, this](const Cluster* cluster) {
                     size_t e = cluster->node_size();
                     node->set_cluster(cluster);
                     st.m_key_offset = cluster->get_offset();
                     st.m_key_values = cluster->get_key_array();
-                    aggregate_internal(node, &st, 0, e, nullptr);
+                    aggregate_internal(node, &st, first_in_cluster(cluster), e, nullptr);
                     // Stop if limit is reached
                     return st.match_count() == st.limit() ? IteratorControl::Stop : IteratorControl::AdvanceToNext;
                 };
 
-                m_table->traverse_clusters(f);
+                m_table->traverse_clusters(f, first_key);
             }
         }
     }
@@ -1509,6 +1641,83 @@ TableView Query::find_all(size_t limit) const
 }
 
 
+ObjKeySet Query::find_all_keys(size_t limit) const
+{
+    ObjKeySet keys;
+    QueryStateFindAll<ObjKeySet> st(keys, limit);
+    do_find_all(st);
+    keys.optimize();
+    return keys;
+}
+
+std::vector<std::pair<ObjKey, float>> Query::nearest(ColKey column, const std::vector<float>& vector, size_t k,
+                                                     VectorMetric metric) const
+{
+    m_table.check();
+    m_table->check_column(column);
+    bool is_list = column.get_type() == col_type_Float && column.is_list();
+    if (!is_list && (column.get_type() != col_type_Binary || column.is_collection())) {
+        throw InvalidArgument(ErrorCodes::TypeMismatch,
+                              util::format("Property '%1' does not hold vectors", m_table->get_column_name(column)));
+    }
+
+    std::vector<std::pair<ObjKey, float>> result;
+    if (k == 0 || vector.empty())
+        return result;
+
+    init();
+    bool has_cond = has_conditions();
+    VectorIndex* index = is_list || m_view ? nullptr : m_table->get_vector_index(column);
+    if (index && index->get_metric() == metric && index->get_dimensions() == vector.size()) {
+        index->search(vector, k, VectorIndex::default_ef, [&](ObjKey key) {
+            return !has_cond || eval_object(m_table->get_object(key));
+        }, result);
+        // When few objects match the conditions, the search may find fewer than 'k' of them. Computing all
+        // distances is then not slower than the search.
+        if (result.size() == k || (!has_cond && result.size() == index->num_vectors()))
+            return result;
+        result.clear();
+    }
+
+    // Keep the 'k' closest vectors in a heap, farthest on top
+    auto closer = [](const std::pair<ObjKey, float>& a, const std::pair<ObjKey, float>& b) {
+        return a.second < b.second || (a.second == b.second && a.first < b.first);
+    };
+    std::vector<float> values(vector.size());
+    find_all_keys().for_each([&](ObjKey key) {
+        Obj obj = m_table->get_object(key);
+        if (is_list) {
+            auto list = obj.get_listbase_ptr(column);
+            if (list->size() != vector.size())
+                return;
+            for (size_t i = 0; i < values.size(); ++i) {
+                Mixed value = list->get_any(i);
+                if (value.is_null())
+                    return;
+                values[i] = value.get_float();
+            }
+        }
+        else {
+            BinaryData data = obj.get<BinaryData>(column);
+            if (data.size() != vector.size() * sizeof(float))
+                return;
+            std::memcpy(values.data(), data.data(), data.size());
+        }
+        std::pair<ObjKey, float> entry(key, vector_distance(metric, vector.data(), values.data(), vector.size()));
+        if (result.size() < k) {
+            result.push_back(entry);
+            std::push_heap(result.begin(), result.end(), closer);
+        }
+        else if (closer(entry, result.front())) {
+            std::pop_heap(result.begin(), result.end(), closer);
+            result.back() = entry;
+            std::push_heap(result.begin(), result.end(), closer);
+        }
+    });
+    std::sort_heap(result.begin(), result.end(), closer);
+    return result;
+}
+
 size_t Query::do_count(size_t limit) const
 {
     auto logger = m_table->get_logger();
@@ -1566,15 +1775,14 @@ size_t Query::do_count(size_t limit) const
                 // all the objects will match this condition
                 pn->m_children[best] = pn->m_children.back();
                 pn->m_children.pop_back();
-                const size_t num_keys = keys->size();
-                for (size_t i = 0; i < num_keys; ++i) {
-                    auto obj = m_table->get_object(keys->get(i));
+                for_each_index_match(*keys, [&](const Obj& obj) {
                     if (eval_object(obj)) {
                         ++cnt;
                         if (cnt == limit)
-                            break;
+                            return IteratorControl::Stop;
                     }
-                }
+                    return IteratorControl::AdvanceToNext;
+                });
             }
             else {
                 // The node having the search index is the only node
@@ -1616,7 +1824,13 @@ size_t Query::count() const
 {
     if (!m_table)
         return 0;
-    return do_count();
+    QueryResultCache::Operation cached(*this, "count");
+    QueryResultCache::Result result;
+    if (!cached.find(result)) {
+        result.count = do_count();
+        cached.store(result);
+    }
+    return result.count;
 }
 
 TableView Query::find_all(const DescriptorOrdering& descriptor) const
@@ -38,6 +38,7 @@
 #include <realm/binary_data.hpp>
 #include <realm/column_type_traits.hpp>
 #include <realm/handover_defs.hpp>
+#include <realm/obj_key_set.hpp>
 #include <realm/obj_list.hpp>
 #include <realm/table_ref.hpp>
 #include <realm/util/bind_ptr.hpp>
@@ -50,6 +51,9 @@ namespace realm {
 class Array;
 class Expression;
 class Group;
+class GroupBy;
+class GroupByState;
+class IndexEvaluator;
 class LinkMap;
 class ParentNode;
 class Table;
@@ -57,6 +61,8 @@ class TableView;
 class Timestamp;
 class Transaction;
 
+struct GroupByKey;
+
 struct QueryGroup {
     enum class State {
         Default,
@@ -260,6 +266,13 @@ public:
     // Searching
     ObjKey find() const;
     TableView find_all(size_t limit = size_t(-1)) const;
+    // The keys of the matching objects as a compressed set. The ordering of the query is not applied.
+    ObjKeySet find_all_keys(size_t limit = size_t(-1)) const;
+    // The 'k' matching objects whose vectors in 'column' are closest to 'vector', nearest first, with their distance.
+    // The column is either a binary column holding vectors of floats, or a list of floats. A vector index on the
+    // column built for the same metric gives an approximate result without computing all distances.
+    std::vector<std::pair<ObjKey, float>> nearest(ColKey column, const std::vector<float>& vector, size_t k,
+                                                  VectorMetric metric = VectorMetric::L2) const;
 
     // Aggregates
     size_t count() const;
@@ -274,6 +287,9 @@ public:
     std::optional<Mixed> max(ColKey col_key, ObjKey* = nullptr) const;
     std::optional<Mixed> avg(ColKey col_key, size_t* value_count = nullptr) const;
 
+    // Grouped aggregates. See group_by.hpp
+    GroupBy group_by(std::vector<GroupByKey> keys) const;
+
     // Deletion
     size_t remove() const;
 
@@ -363,10 +379,15 @@ private:
     void aggregate(QueryStateBase& st, ColKey column_key) const;
 
     size_t find_best_node(ParentNode* pn) const;
+    // Call 'func' for the objects found through a search index, in index order, until it returns
+    // IteratorControl::Stop. The objects are looked up in batches.
+    void for_each_index_match(const IndexEvaluator& keys, util::FunctionRef<IteratorControl(const Obj&)> func) const;
     void aggregate_internal(ParentNode* pn, QueryStateBase* st, size_t start, size_t end,
                             ArrayPayload* source_column) const;
 
-    void do_find_all(QueryStateBase& st) const;
+    // Only objects with a key not below 'first_key' are considered, if given
+    void do_find_all(QueryStateBase& st, ObjKey first_key = {}) const;
+    void do_group_by(GroupByState& st) const;
     size_t do_count(size_t limit = size_t(-1)) const;
     void delete_nodes() noexcept;
 
@@ -380,6 +401,8 @@ private:
 
     friend class Table;
     friend class TableView;
+    friend class GroupBy;
+    friend class QueryResultCache;
     friend class SubQueryCount;
     friend class PrimitiveListCount;
     template <class>
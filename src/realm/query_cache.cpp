@@ -0,0 +1,212 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/query_cache.hpp>
+#include <realm/query.hpp>
+#include <realm/transaction.hpp>
+
+using namespace realm;
+
+QueryResultCache::QueryResultCache(DB& db, size_t memory_budget)
+    : m_db(db)
+    , m_budget(memory_budget)
+{
+}
+
+QueryResultCache::~QueryResultCache()
+{
+    clear();
+}
+
+bool QueryResultCache::lookup(const Transaction& tr, const std::string& key, Result& result)
+{
+    std::lock_guard lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        ++m_misses;
+        return false;
+    }
+    auto entry = it->second;
+    if (!is_unchanged(tr, *entry)) {
+        // The result is outdated for this and all later versions
+        if (tr.get_version_of_current_transaction().version > m_read_lock.m_version)
+            erase(entry);
+        ++m_misses;
+        return false;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, entry);
+    result = entry->result;
+    ++m_hits;
+    return true;
+}
+
+void QueryResultCache::insert(const Transaction& tr, const std::string& key, const std::vector<TableKey>& tables,
+                              Result result)
+{
+    if (result.keys.size() > max_cached_keys)
+        return;
+    // Strings and binaries refer to the file, so they can't outlive the snapshot
+    if (result.value && result.value->is_type(type_String, type_Binary))
+        return;
+
+    Entry entry{key, {}, std::move(result), 0};
+    for (auto table_key : tables) {
+        entry.tables.emplace_back(table_key, _impl::TableFriend::get_ref(*tr.get_table(table_key)));
+    }
+    entry.size = sizeof(Entry) + sizeof(std::pair<std::string_view, EntryList::iterator>) + 2 * sizeof(void*) +
+                 entry.key.size() + entry.tables.size() * sizeof(entry.tables[0]) +
+                 entry.result.keys.size() * sizeof(ObjKey);
+    if (entry.size > m_budget)
+        return;
+
+    std::lock_guard lock(m_mutex);
+    auto version = tr.get_version_of_current_transaction().version;
+    if (!m_has_read_lock || version > m_read_lock.m_version) {
+        move_read_lock(tr); // Throws
+    }
+    else if (version < m_read_lock.m_version) {
+        // Results from an older snapshot are not worth moving the lock back for
+        return;
+    }
+
+    if (auto it = m_index.find(key); it != m_index.end())
+        erase(it->second);
+    m_memory_used += entry.size;
+    m_entries.push_front(std::move(entry));
+    m_index.emplace(m_entries.front().key, m_entries.begin());
+    while (m_memory_used > m_budget)
+        erase(std::prev(m_entries.end()));
+}
+
+void QueryResultCache::clear() noexcept
+{
+    std::lock_guard lock(m_mutex);
+    m_index.clear();
+    m_entries.clear();
+    m_memory_used = 0;
+    release_read_lock();
+}
+
+auto QueryResultCache::get_stats() const -> Stats
+{
+    std::lock_guard lock(m_mutex);
+    Stats stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.entries = m_entries.size();
+    stats.memory_used = m_memory_used;
+    return stats;
+}
+
+bool QueryResultCache::is_unchanged(const Transaction& tr, const Entry& entry) noexcept
+{
+    try {
+        for (auto& [table_key, ref] : entry.tables) {
+            if (_impl::TableFriend::get_ref(*tr.get_table(table_key)) != ref)
+                return false;
+        }
+    }
+    catch (...) {
+        // The table has been removed
+        return false;
+    }
+    return true;
+}
+
+void QueryResultCache::erase(EntryList::iterator it) noexcept
+{
+    m_memory_used -= it->size;
+    m_index.erase(it->key);
+    m_entries.erase(it);
+}
+
+void QueryResultCache::move_read_lock(const Transaction& tr)
+{
+    DB::ReadLockInfo read_lock;
+    if (m_db.m_fake_read_lock_if_immutable) {
+        // The file can't change, so there is nothing to keep alive
+        read_lock = *m_db.m_fake_read_lock_if_immutable;
+    }
+    else {
+        read_lock = m_db.grab_read_lock(DB::ReadLockInfo::Frozen, tr.get_version_of_current_transaction()); // Throws
+    }
+
+    // Both versions are locked now, so a table with the same ref in both is unchanged
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        auto next = std::next(it);
+        if (!is_unchanged(tr, *it))
+            erase(it);
+        it = next;
+    }
+
+    release_read_lock();
+    m_read_lock = read_lock;
+    m_has_read_lock = true;
+}
+
+void QueryResultCache::release_read_lock() noexcept
+{
+    if (m_has_read_lock) {
+        m_db.release_read_lock(m_read_lock);
+        m_has_read_lock = false;
+    }
+}
+
+QueryResultCache::Operation::Operation(const Query& query, const std::string& name, ColKey col_key)
+    : m_query(query)
+{
+    const Table* table = query.m_table.unchecked_ptr();
+    if (!table || query.m_view)
+        return;
+    auto tr = dynamic_cast<const Transaction*>(_impl::TableFriend::get_parent_group(*table));
+    if (!tr)
+        return;
+    auto stage = tr->get_transact_stage();
+    if (stage != DB::transact_Reading && stage != DB::transact_Frozen)
+        return;
+    auto cache = tr->get_query_cache();
+    if (!cache)
+        return;
+    try {
+        m_key = util::format("%1 %2 %3 %4", table->get_key().value, name, col_key.value, query.get_description());
+    }
+    catch (const Exception&) {
+        // Not all queries can be described
+        return;
+    }
+    m_cache = cache;
+    m_tr = tr;
+}
+
+bool QueryResultCache::Operation::find(Result& result)
+{
+    return m_cache && m_cache->lookup(*m_tr, m_key, result);
+}
+
+void QueryResultCache::Operation::store(Result result)
+{
+    if (!m_cache)
+        return;
+    TableVersions versions;
+    m_query.get_outside_versions(versions);
+    std::vector<TableKey> tables;
+    tables.reserve(versions.size());
+    for (auto& version : versions)
+        tables.push_back(version.first);
+    m_cache->insert(*m_tr, m_key, tables, std::move(result)); // Throws
+}
@@ -0,0 +1,137 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_QUERY_CACHE_HPP
+#define REALM_QUERY_CACHE_HPP
+
+#include <realm/db.hpp>
+#include <realm/keys.hpp>
+#include <realm/mixed.hpp>
+
+#include <list>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace realm {
+
+class Query;
+
+// A DB wide cache of query results, enabled by DBOptions::query_cache_size.
+// Counts, aggregates and small lists of object keys are cached under the
+// description of the query together with the operation, and are reused by any
+// read or frozen transaction in which the tables the query depends on are
+// unchanged.
+//
+// A table is unchanged between two snapshots if its top ref is the same in
+// both. This only holds while both snapshots are kept alive, as the space of
+// a table released in a later version may otherwise be reused for a different
+// table. The cache therefore keeps a read lock on the version in which the
+// cached results are valid. When a result is stored from a newer version, the
+// lock is moved to that version and results for tables which have changed in
+// between are dropped.
+class QueryResultCache {
+public:
+    struct Result {
+        std::optional<Mixed> value;
+        // Object holding the min/max value
+        ObjKey key;
+        // Number of matches, or number of values for average
+        size_t count = 0;
+        std::vector<ObjKey> keys;
+    };
+
+    struct Stats {
+        size_t hits = 0;
+        size_t misses = 0;
+        size_t entries = 0;
+        size_t memory_used = 0;
+    };
+
+    // Key lists longer than this are not cached
+    static constexpr size_t max_cached_keys = 1000;
+
+    QueryResultCache(DB& db, size_t memory_budget);
+    ~QueryResultCache();
+
+    QueryResultCache(const QueryResultCache&) = delete;
+    QueryResultCache& operator=(const QueryResultCache&) = delete;
+
+    bool lookup(const Transaction& tr, const std::string& key, Result& result);
+    void insert(const Transaction& tr, const std::string& key, const std::vector<TableKey>& tables,
+                Result result);
+
+    // Drop all results and release the read lock
+    void clear() noexcept;
+
+    Stats get_stats() const;
+
+    // Looks up and stores the result of one operation on a query. All
+    // operations are no-ops if the query can't use the cache, i.e. if the DB
+    // has no cache, the query is not in a read or frozen transaction, or the
+    // query is restricted by a view.
+    class Operation {
+    public:
+        Operation(const Query& query, const std::string& name, ColKey col_key = {});
+
+        bool find(Result& result);
+        void store(Result result);
+
+    private:
+        QueryResultCache* m_cache = nullptr;
+        const Query& m_query;
+        const Transaction* m_tr = nullptr;
+        std::string m_key;
+    };
+
+private:
+    struct Entry {
+        std::string key;
+        std::vector<std::pair<TableKey, ref_type>> tables;
+        Result result;
+        size_t size;
+    };
+    using EntryList = std::list<Entry>;
+
+    DB& m_db;
+    const size_t m_budget;
+
+    mutable std::mutex m_mutex;
+    // Most recently used entries first
+    EntryList m_entries;
+    std::unordered_map<std::string_view, EntryList::iterator> m_index;
+    size_t m_memory_used = 0;
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+
+    // Read lock on the version in which the cached results are valid
+    DB::ReadLockInfo m_read_lock;
+    bool m_has_read_lock = false;
+
+    static bool is_unchanged(const Transaction& tr, const Entry& entry) noexcept;
+    void erase(EntryList::iterator it) noexcept;
+    void move_read_lock(const Transaction& tr);
+    void release_read_lock() noexcept;
+};
+
+} // namespace realm
+
+#endif // REALM_QUERY_CACHE_HPP
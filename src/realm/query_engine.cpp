@@ -267,6 +267,22 @@ size_t MixedNode<EqualIns>::find_first_local(size_t start, size_t end)
     return not_found;
 }
 
+void StringNodeBase::trigram_index_init(StringData upper, StringData lower, bool like,
+                                        util::FunctionRef<bool(StringData)> matches)
+{
+    m_index_evaluator.reset();
+    if (!m_value || m_table->search_index_type(m_condition_column_key) != IndexType::Trigram)
+        return;
+
+    m_trigram_matches.clear();
+    StringIndex* index = m_table->get_string_index(m_condition_column_key);
+    if (index->find_all_trigram_matches(m_trigram_matches, upper, lower, like, matches)) {
+        m_index_evaluator = IndexEvaluator{};
+        m_index_evaluator->init(&m_trigram_matches);
+        m_dT = 0.0;
+    }
+}
+
 void StringNodeEqualBase::init(bool will_query_ranges)
 {
     StringNodeBase::init(will_query_ranges);
@@ -536,12 +552,12 @@ void StringNodeFulltext::_search_index_init()
 
     // If links exists, use backlinks to find the original objects
     if (m_link_map->links_exist()) {
-        std::set<ObjKey> tmp;
+        ObjKeySet tmp;
         for (auto k : m_index_matches) {
-            auto keys = m_link_map->get_origin_objkeys(k);
-            tmp.insert(keys.begin(), keys.end());
+            for (auto key : m_link_map->get_origin_objkeys(k))
+                tmp.add(key);
         }
-        m_index_matches.assign(tmp.begin(), tmp.end());
+        m_index_matches = tmp.to_vector();
     }
 
     m_index_evaluator = IndexEvaluator{};
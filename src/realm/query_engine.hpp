@@ -1492,6 +1492,9 @@ public:
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if constexpr (realm::is_any_v<TConditionFunction, NotEqual, Greater, GreaterEqual, Less, LessEqual>) {
+            return m_leaf->find_first<TConditionFunction>(m_value, start, end);
+        }
         TConditionFunction cond;
         for (size_t i = start; i < end; i++) {
             QueryValue val(m_leaf->get(i));
@@ -1653,8 +1656,16 @@ public:
 
     void cluster_changed() override
     {
-        m_leaf.emplace(m_table.unchecked_ptr()->get_alloc());
-        m_cluster->init_leaf(m_condition_column_key, &*m_leaf);
+        // If we use an index, we do not need further access to clusters
+        if (!m_index_evaluator) {
+            m_leaf.emplace(m_table.unchecked_ptr()->get_alloc());
+            m_cluster->init_leaf(m_condition_column_key, &*m_leaf);
+        }
+    }
+
+    const IndexEvaluator* index_based_keys() override
+    {
+        return m_index_evaluator ? &(*m_index_evaluator) : nullptr;
     }
 
     void init(bool will_query_ranges) override
@@ -1678,6 +1689,7 @@ public:
         , m_value(from.m_value)
         , m_string_value(m_value)
         , m_is_string_enum(from.m_is_string_enum)
+        , m_index_evaluator(from.m_index_evaluator)
     {
     }
 
@@ -1699,10 +1711,18 @@ protected:
     size_t m_leaf_start = 0;
     size_t m_leaf_end = 0;
 
+    std::optional<IndexEvaluator> m_index_evaluator;
+    std::vector<ObjKey> m_trigram_matches;
+
     StringData get_string(size_t s)
     {
         return m_leaf->get(s);
     }
+
+    // Find the matches of a contains or like condition up front if the column has a trigram index, see
+    // StringIndex::find_all_trigram_matches(). 'matches' evaluates the condition for a candidate.
+    void trigram_index_init(StringData upper, StringData lower, bool like,
+                            util::FunctionRef<bool(StringData)> matches);
 };
 
 // Conditions for strings. Note that Equal is specialized later in this file!
@@ -1732,10 +1752,24 @@ public:
     {
         StringNodeBase::init(will_query_ranges);
         clear_leaf_state();
+        if constexpr (std::is_same_v<TConditionFunction, Like>) {
+            trigram_index_init(m_string_value, m_string_value, true, [this](StringData t) {
+                return TConditionFunction()(m_string_value, t);
+            });
+        }
+        else if constexpr (std::is_same_v<TConditionFunction, LikeIns>) {
+            trigram_index_init(m_ucase, m_lcase, true, [this](StringData t) {
+                return TConditionFunction()(m_string_value, m_ucase.c_str(), m_lcase.c_str(), t);
+            });
+        }
     }
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_index_evaluator) {
+            return m_index_evaluator->do_search_index(m_cluster, start, end);
+        }
+
         TConditionFunction cond;
 
         for (size_t s = start; s < end; ++s) {
@@ -1804,11 +1838,18 @@ public:
     {
         StringNodeBase::init(will_query_ranges);
         clear_leaf_state();
+        trigram_index_init(m_string_value, m_string_value, false, [this](StringData t) {
+            return Contains()(m_string_value, m_charmap, t);
+        });
     }
 
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_index_evaluator) {
+            return m_index_evaluator->do_search_index(m_cluster, start, end);
+        }
+
         Contains cond;
 
         for (size_t s = start; s < end; ++s) {
@@ -1881,11 +1922,18 @@ public:
     {
         StringNodeBase::init(will_query_ranges);
         clear_leaf_state();
+        trigram_index_init(m_ucase, m_lcase, false, [this](StringData t) {
+            return ContainsIns()(m_string_value, m_ucase.c_str(), m_lcase.c_str(), m_charmap, t);
+        });
     }
 
 
     size_t find_first_local(size_t start, size_t end) override
     {
+        if (m_index_evaluator) {
+            return m_index_evaluator->do_search_index(m_cluster, start, end);
+        }
+
         ContainsIns cond;
 
         for (size_t s = start; s < end; ++s) {
@@ -1933,7 +1981,6 @@ public:
     }
     StringNodeEqualBase(const StringNodeEqualBase& from)
         : StringNodeBase(from)
-        , m_index_evaluator(from.m_index_evaluator)
     {
     }
 
@@ -1944,14 +1991,6 @@ public:
         return bool(m_table.unchecked_ptr()->search_index_type(m_condition_column_key) == IndexType::General);
     }
 
-    void cluster_changed() override
-    {
-        // If we use searchindex, we do not need further access to clusters
-        if (!m_index_evaluator) {
-            StringNodeBase::cluster_changed();
-        }
-    }
-
     size_t find_first_local(size_t start, size_t end) override;
 
     std::string describe_condition() const override
@@ -1959,14 +1998,7 @@ public:
         return Equal::description();
     }
 
-    const IndexEvaluator* index_based_keys() override
-    {
-        return m_index_evaluator ? &(*m_index_evaluator) : nullptr;
-    }
-
 protected:
-    std::optional<IndexEvaluator> m_index_evaluator;
-
     inline BinaryData str_to_bin(const StringData& s) noexcept
     {
         return BinaryData(s.data(), s.size());
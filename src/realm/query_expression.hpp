@@ -3052,6 +3052,29 @@ public:
         return ColumnListBase::m_comparison_type;
     }
 
+    bool has_search_index() const final
+    {
+        // The index knows which objects contain a value, but not at which position
+        return !m_index && m_link_map.get_target_table()->search_index_type(m_column_key) == IndexType::General;
+    }
+
+    std::vector<ObjKey> find_all(Mixed value) const final
+    {
+        std::vector<ObjKey> ret;
+        std::vector<ObjKey> result;
+
+        StringIndex* index = m_link_map.get_target_table()->get_string_index(m_column_key);
+        REALM_ASSERT(index);
+        index->find_all(result, value);
+
+        for (ObjKey k : result) {
+            auto ndxs = m_link_map.get_origin_objkeys(k);
+            ret.insert(ret.end(), ndxs.begin(), ndxs.end());
+        }
+
+        return ret;
+    }
+
     SizeOperator<int64_t> size() override;
 
     ColumnListElementLength<T> element_lengths() const
@@ -3201,42 +3224,6 @@ public:
     }
 };
 
-template <>
-class Columns<Lst<String>> : public ColumnsCollection<String> {
-public:
-    using ColumnsCollection<String>::ColumnsCollection;
-    using ColumnListBase::m_column_key;
-    using ColumnListBase::m_link_map;
-
-    std::unique_ptr<Subexpr> clone() const override
-    {
-        return make_subexpr<Columns<Lst<String>>>(*this);
-    }
-
-    bool has_search_index() const final
-    {
-        auto target_table = m_link_map.get_target_table();
-        return target_table->search_index_type(m_column_key) == IndexType::General;
-    }
-
-    std::vector<ObjKey> find_all(Mixed value) const final
-    {
-        std::vector<ObjKey> ret;
-        std::vector<ObjKey> result;
-
-        StringIndex* index = m_link_map.get_target_table()->get_string_index(m_column_key);
-        REALM_ASSERT(index);
-        index->find_all(result, value);
-
-        for (ObjKey k : result) {
-            auto ndxs = m_link_map.get_origin_objkeys(k);
-            ret.insert(ret.end(), ndxs.begin(), ndxs.end());
-        }
-
-        return ret;
-    }
-};
-
 template <typename T>
 class Columns<Set<T>> : public ColumnsCollection<T> {
 public:
@@ -4603,6 +4590,67 @@ public:
                     dT = 0;
                 }
             }
+            else if constexpr (realm::is_any_v<TCond, Contains, ContainsIns, Like, LikeIns>) {
+                // The pattern is on the left. If the column on the right has a trigram index, the objects which
+                // may match are found through the index and only those are compared.
+                auto column = dynamic_cast<const Columns<StringData>*>(m_right.get());
+                if (m_left->has_single_value() && column && !column->links_exist()) {
+                    Mixed pattern = m_left->get_mixed();
+                    ConstTableRef table = column->get_base_table();
+                    if (pattern.is_type(type_String) &&
+                        table->search_index_type(column->column_key()) == IndexType::Trigram) {
+                        StringData str = pattern.get_string();
+                        std::string upper(str);
+                        std::string lower(str);
+                        if constexpr (realm::is_any_v<TCond, ContainsIns, LikeIns>) {
+                            upper = case_map(str, true, IgnoreErrors);
+                            lower = case_map(str, false, IgnoreErrors);
+                        }
+                        constexpr bool like = realm::is_any_v<TCond, Like, LikeIns>;
+                        m_matches.clear();
+                        StringIndex* index = table->get_string_index(column->column_key());
+                        if (index->find_all_trigram_matches(m_matches, upper, lower, like, [&](StringData value) {
+                                return TCond()(str, upper.c_str(), lower.c_str(), value);
+                            })) {
+                            m_has_matches = true;
+                            m_index_get = 0;
+                            m_index_end = m_matches.size();
+                            dT = 0;
+                        }
+                    }
+                }
+            }
+        }
+        else if constexpr (std::is_same_v<TCond, Equal>) {
+            // 'ANY list IN {...}' on an indexed list or set is the union of the index lookups of the values
+            const bool left_is_const = m_left_const_values != nullptr;
+            const ValueBase* values = left_is_const ? m_left_const_values : m_right_const_values;
+            const Subexpr* constant = left_is_const ? m_left.get() : m_right.get();
+            const Subexpr* column = left_is_const ? m_right.get() : m_left.get();
+            // Without any comparison type two lists are compared element by element
+            auto column_cmp_type = column->get_comparison_type();
+            auto constant_cmp_type = constant->get_comparison_type();
+            if (values && values->size() > 0 && column->has_search_index() && !column->has_indexes_in_link_map() &&
+                (column_cmp_type || constant_cmp_type) &&
+                column_cmp_type.value_or(ExpressionComparisonType::Any) == ExpressionComparisonType::Any &&
+                constant_cmp_type.value_or(ExpressionComparisonType::Any) == ExpressionComparisonType::Any) {
+                for (auto& value : *values) {
+                    if (value.is_null() || value.get_type() != column->get_type())
+                        return dT;
+                }
+                m_matches.clear();
+                for (auto& value : *values) {
+                    auto keys = column->find_all(value);
+                    m_matches.insert(m_matches.end(), keys.begin(), keys.end());
+                }
+                std::sort(m_matches.begin(), m_matches.end());
+                m_matches.erase(std::unique(m_matches.begin(), m_matches.end()), m_matches.end());
+
+                m_has_matches = true;
+                m_index_get = 0;
+                m_index_end = m_matches.size();
+                dT = 0;
+            }
         }
 
         return dT;
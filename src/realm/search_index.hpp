@@ -32,7 +32,8 @@ public:
         : m_cluster_tree(cluster_tree)
         , m_column_key(column_key)
         , m_tokenize(type == IndexType::Fulltext)
-        , m_full_word(m_tokenize | column_key.is_collection())
+        , m_trigrams(type == IndexType::Trigram)
+        , m_full_word(m_tokenize | m_trigrams | column_key.is_collection())
     {
     }
     size_t size() const
@@ -59,22 +60,34 @@ public:
     {
         return m_column_key.is_nullable();
     }
+    bool is_collection() const
+    {
+        return m_column_key.is_collection();
+    }
     bool tokenize() const
     {
         return m_tokenize;
     }
+    bool trigrams() const
+    {
+        return m_trigrams;
+    }
     bool full_word() const
     {
         return m_full_word;
     }
     Mixed get_value(ObjKey key) const;
-    Lst<String> get_list(ObjKey key) const;
+    // Call 'func' with the position in 'keys' and the value of every object of a string column. The objects are
+    // looked up in batches, see ClusterTree::resolve().
+    void get_strings(const std::vector<ObjKey>& keys, util::FunctionRef<void(size_t, StringData)> func) const;
+    CollectionBasePtr get_collection(ObjKey key) const;
     std::vector<ObjKey> get_all_keys() const;
 
 private:
     const ClusterTree* m_cluster_tree;
     ColKey m_column_key;
     bool m_tokenize;
+    bool m_trigrams;
     bool m_full_word;
 };
 
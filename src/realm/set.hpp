@@ -229,6 +229,10 @@ private:
     void do_erase(size_t ndx);
     void do_clear();
 
+    static constexpr bool s_may_be_indexed =
+        realm::is_any_v<T, Int, util::Optional<Int>, StringData, Timestamp, ObjectId, util::Optional<ObjectId>, UUID,
+                        util::Optional<UUID>>;
+
     iterator find_impl(const T& value) const;
 };
 
@@ -765,18 +769,33 @@ void Set<T>::distinct(std::vector<size_t>& indices, util::Optional<bool> sort_or
 template <class T>
 inline void Set<T>::do_insert(size_t ndx, T value)
 {
+    if constexpr (s_may_be_indexed) {
+        if (auto index = Base::get_search_index()) {
+            this->index_insert(*index, value);
+        }
+    }
     tree().insert(ndx, value);
 }
 
 template <class T>
 inline void Set<T>::do_erase(size_t ndx)
 {
+    if constexpr (s_may_be_indexed) {
+        if (auto index = Base::get_search_index()) {
+            this->index_erase(*index, tree().get(ndx));
+        }
+    }
     tree().erase(ndx);
 }
 
 template <class T>
 inline void Set<T>::do_clear()
 {
+    if constexpr (s_may_be_indexed) {
+        if (auto index = Base::get_search_index()) {
+            this->index_clear(*index);
+        }
+    }
     tree().clear();
 }
 
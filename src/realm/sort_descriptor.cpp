@@ -24,6 +24,8 @@
 #include <realm/list.hpp>
 #include <realm/dictionary.hpp>
 
+#include <unordered_set>
+
 using namespace realm;
 
 ConstTableRef ExtendedColumnKey::get_target_table(const Table* table) const
@@ -285,6 +287,31 @@ void DistinctDescriptor::execute(IndexPairs& v, const Sorter& predicate, const B
         v.erase(nulls, v.end());
     }
 
+    bool will_be_sorted_next = next && next->get_type() == DescriptorType::Sort;
+    if (!will_be_sorted_next && predicate.can_hash()) {
+        // Keep the first row with each combination of values in a single
+        // pass. This retains the order of the rows, so unlike the sort based
+        // approach below, there is no need to restore it afterwards.
+        std::vector<size_t> hashes(v.size());
+        auto hash = [&](size_t ndx) {
+            return hashes[ndx];
+        };
+        auto equal = [&](size_t a, size_t b) {
+            return predicate.equal(v[a], v[b]);
+        };
+        std::unordered_set<size_t, decltype(hash), decltype(equal)> seen(v.size(), hash, equal);
+        size_t kept = 0;
+        for (size_t i = 0; i < v.size(); ++i) {
+            hashes[kept] = predicate.hash(v[i]);
+            if (kept != i)
+                v[kept] = std::move(v[i]);
+            if (seen.insert(kept).second)
+                ++kept;
+        }
+        v.erase(v.begin() + kept, v.end());
+        return;
+    }
+
     // Sort by the columns to distinct on
     std::sort(v.begin(), v.end(), std::ref(predicate));
 
@@ -294,7 +321,6 @@ void DistinctDescriptor::execute(IndexPairs& v, const Sorter& predicate, const B
     });
     // Erase the duplicates
     v.erase(duplicates, v.end());
-    bool will_be_sorted_next = next && next->get_type() == DescriptorType::Sort;
     if (!will_be_sorted_next) {
         // Restore the original order, this is either the original
         // tableview order or the order of the previous sort
@@ -424,30 +450,8 @@ bool BaseDescriptor::Sorter::operator()(IndexPair i, IndexPair j, bool total_ord
             c = i.cached_value.compare(j.cached_value);
         }
         else {
-            if (m_cache[t - 1].empty()) {
-                m_cache[t - 1].resize(256);
-            }
-            ObjCache& cache_i = m_cache[t - 1][key_i.value & 0xFF];
-            ObjCache& cache_j = m_cache[t - 1][key_j.value & 0xFF];
-
-            if (cache_i.key != key_i) {
-                const auto& obj = m_columns[t].table->get_object(key_i);
-                const auto& col_key = m_columns[t].col_key;
-
-                cache_i.value = col_key.get_value(obj);
-                cache_i.key = key_i;
-            }
-            Mixed val_i = cache_i.value;
-
-            if (cache_j.key != key_j) {
-                const auto& obj = m_columns[t].table->get_object(key_j);
-                const auto& col_key = m_columns[t].col_key;
-
-                cache_j.value = col_key.get_value(obj);
-                cache_j.key = key_j;
-            }
-
-            c = val_i.compare(cache_j.value);
+            Mixed val_i = get_value(t, key_i);
+            c = val_i.compare(get_value(t, key_j));
         }
         // if c is negative i comes before j
         if (c) {
@@ -458,6 +462,67 @@ bool BaseDescriptor::Sorter::operator()(IndexPair i, IndexPair j, bool total_ord
     return total_ordering ? i.index_in_view < j.index_in_view : 0;
 }
 
+Mixed BaseDescriptor::Sorter::get_value(size_t column_ndx, ObjKey key) const
+{
+    auto& table_cache = m_cache[column_ndx - 1];
+    if (table_cache.empty()) {
+        table_cache.resize(256);
+    }
+    ObjCache& cache = table_cache[key.value & 0xFF];
+    if (cache.key != key) {
+        const auto& obj = m_columns[column_ndx].table->get_object(key);
+        cache.value = m_columns[column_ndx].col_key.get_value(obj);
+        cache.key = key;
+    }
+    return cache.value;
+}
+
+bool BaseDescriptor::Sorter::can_hash() const
+{
+    // Values of these types may compare equal while having different
+    // representations, e.g. 1.0 and 1.00 or 1 and 1.0
+    return std::none_of(m_columns.begin(), m_columns.end(), [](auto&& col) {
+        auto type = ColKey(col.col_key).get_type();
+        return type == col_type_Mixed || type == col_type_Decimal;
+    });
+}
+
+size_t BaseDescriptor::Sorter::hash(IndexPair i) const
+{
+    // Must give the same hash for all values which compare equal
+    auto hash_value = [](Mixed val) -> size_t {
+        if (val.is_null())
+            return 0;
+        switch (val.get_type()) {
+            case type_Float:
+            case type_Double: {
+                double d = val.get_type() == type_Float ? double(val.get<float>()) : val.get<double>();
+                // 0.0 equals -0.0
+                if (d == 0)
+                    return 1;
+                return murmur2_or_cityhash(reinterpret_cast<const unsigned char*>(&d), sizeof(d));
+            }
+            case type_Link:
+                return size_t(val.get<ObjKey>().value);
+            default:
+                return val.hash();
+        }
+    };
+
+    size_t hash = 0;
+    for (size_t t = 0; t < m_columns.size(); t++) {
+        ObjKey key = i.key_for_object;
+        if (!m_columns[t].translated_keys.empty()) {
+            key = m_columns[t].translated_keys[i.index_in_view];
+            if (!key)
+                continue;
+        }
+        size_t h = hash_value(t == 0 ? i.cached_value : get_value(t, key));
+        hash ^= h + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+}
+
 void BaseDescriptor::Sorter::cache_first_column(IndexPairs& v)
 {
     if (m_columns.empty())
@@ -97,6 +97,15 @@ public:
         }
         void cache_first_column(IndexPairs& v);
 
+        // Hash based distinct. Rows which are equal, i.e. neither is less
+        // than the other, have the same hash if can_hash() returns true.
+        bool can_hash() const;
+        size_t hash(IndexPair i) const;
+        bool equal(IndexPair i, IndexPair j) const
+        {
+            return !(*this)(i, j, false) && !(*this)(j, i, false);
+        }
+
     private:
         struct SortColumn {
             SortColumn(const Table* t, ExtendedColumnKey c, bool a)
@@ -119,6 +128,8 @@ public:
         using TableCache = std::vector<ObjCache>;
         mutable std::vector<TableCache> m_cache;
 
+        Mixed get_value(size_t column_ndx, ObjKey key) const;
+
         friend class ObjList;
     };
 
@@ -35,6 +35,7 @@
 #include <realm/table_view.hpp>
 #include <realm/util/features.h>
 #include <realm/util/serializer.hpp>
+#include <realm/vector_index.hpp>
 
 #include <stdexcept>
 
@@ -630,6 +631,10 @@ void Table::init(ref_type top_ref, ArrayParent* parent, size_t ndx_in_parent, bo
     }
     else
         m_in_file_version_at_transaction_boundary = rot_version.get_as_int();
+    // The accessor may be recycled from another transaction
+    m_changed_since_commit = false;
+    m_changed_in_place_since_commit = false;
+    start_append_run();
 
     auto rot_pk_key = m_top.get_as_ref_or_tagged(top_position_for_pk_col);
     m_primary_key_col = rot_pk_key.is_tagged() ? ColKey(rot_pk_key.get_as_int()) : ColKey();
@@ -678,6 +683,17 @@ ColKey Table::do_insert_column(ColKey col_key, DataType type, StringData name, T
     return col_key;
 }
 
+static IndexType index_type_from_attr(ColumnAttrMask attr)
+{
+    if (attr.test(col_attr_FullText_Indexed))
+        return IndexType::Fulltext;
+    if (attr.test(col_attr_Trigram_Indexed))
+        return IndexType::Trigram;
+    if (attr.test(col_attr_Vector_Indexed))
+        return IndexType::Vector;
+    return IndexType::General;
+}
+
 template <typename Type>
 static void do_bulk_insert_index(Table* table, SearchIndex* index, ColKey col_key, Allocator& alloc)
 {
@@ -713,7 +729,10 @@ void Table::populate_search_index(ColKey col_key)
     SearchIndex* index = m_index_accessors[col_ndx].get();
     DataType type = get_column_type(col_key);
 
-    if (type == type_Int) {
+    if (col_key.is_collection()) {
+        do_bulk_insert_index_list(this, index, col_key, get_alloc());
+    }
+    else if (type == type_Int) {
         if (is_nullable(col_key)) {
             do_bulk_insert_index<Optional<int64_t>>(this, index, col_key, get_alloc());
         }
@@ -730,12 +749,7 @@ void Table::populate_search_index(ColKey col_key)
         }
     }
     else if (type == type_String) {
-        if (col_key.is_list()) {
-            do_bulk_insert_index_list(this, index, col_key, get_alloc());
-        }
-        else {
-            do_bulk_insert_index<StringData>(this, index, col_key, get_alloc());
-        }
+        do_bulk_insert_index<StringData>(this, index, col_key, get_alloc());
     }
     else if (type == type_Timestamp) {
         do_bulk_insert_index<Timestamp>(this, index, col_key, get_alloc());
@@ -759,6 +773,9 @@ void Table::populate_search_index(ColKey col_key)
     else if (type == type_Mixed) {
         do_bulk_insert_index<Mixed>(this, index, col_key, get_alloc());
     }
+    else if (type == type_Binary) {
+        do_bulk_insert_index<BinaryData>(this, index, col_key, get_alloc());
+    }
     else {
         REALM_ASSERT_RELEASE(false && "Data type does not support search index");
     }
@@ -845,6 +862,7 @@ void Table::update_indexes(ObjKey key, const FieldValues& values)
                     }
                     break;
                 case col_type_Mixed:
+                case col_type_Binary:
                     index->insert(key, init_value);
                     break;
                 case col_type_UUID:
@@ -871,7 +889,7 @@ void Table::clear_indexes()
     }
 }
 
-void Table::do_add_search_index(ColKey col_key, IndexType type)
+void Table::do_add_search_index(ColKey col_key, IndexType type, VectorMetric metric)
 {
     size_t column_ndx = col_key.get_index().val;
 
@@ -879,9 +897,20 @@ void Table::do_add_search_index(ColKey col_key, IndexType type)
     if (m_index_accessors[column_ndx] != nullptr)
         return;
 
-    if (!StringIndex::type_supported(DataType(col_key.get_type())) ||
-        (col_key.is_collection() && !(col_key.is_list() && col_key.get_type() == col_type_String)) ||
-        (type == IndexType::Fulltext && col_key.get_type() != col_type_String)) {
+    auto data_type = DataType(col_key.get_type());
+    bool supported;
+    if (type == IndexType::Vector) {
+        supported = data_type == type_Binary && !col_key.is_collection();
+    }
+    else if (type == IndexType::Fulltext || type == IndexType::Trigram) {
+        supported = data_type == type_String && !col_key.is_collection();
+    }
+    else {
+        supported = StringIndex::type_supported(data_type) &&
+                    (!col_key.is_collection() ||
+                     (!col_key.is_dictionary() && StringIndex::collection_type_supported(data_type)));
+    }
+    if (!supported) {
         // Not ideal, but this is what we used to throw, so keep throwing that for compatibility reasons, even though
         // it should probably be a type mismatch exception instead.
         throw IllegalOperation(util::format("Index not supported for this property: %1", get_column_name(col_key)));
@@ -893,8 +922,13 @@ void Table::do_add_search_index(ColKey col_key, IndexType type)
     REALM_ASSERT(m_index_accessors[column_ndx] == nullptr);
 
     // Create the index
-    m_index_accessors[column_ndx] =
-        std::make_unique<StringIndex>(ClusterColumn(&m_clusters, col_key, type), get_alloc()); // Throws
+    ClusterColumn virtual_col(&m_clusters, col_key, type);
+    if (type == IndexType::Vector) {
+        m_index_accessors[column_ndx] = std::make_unique<VectorIndex>(virtual_col, get_alloc(), metric); // Throws
+    }
+    else {
+        m_index_accessors[column_ndx] = std::make_unique<StringIndex>(virtual_col, get_alloc()); // Throws
+    }
     SearchIndex* index = m_index_accessors[column_ndx].get();
     // Insert ref to index
     index->set_parent(&m_index_refs, column_ndx);
@@ -905,6 +939,20 @@ void Table::do_add_search_index(ColKey col_key, IndexType type)
 }
 
 void Table::add_search_index(ColKey col_key, IndexType type)
+{
+    add_index(col_key, type, VectorMetric::L2);
+}
+
+void Table::add_vector_index(ColKey col_key, VectorMetric metric)
+{
+    check_column(col_key);
+    // The graph of a vector index is built for one metric
+    if (auto index = get_vector_index(col_key); index && index->get_metric() != metric)
+        remove_search_index(col_key);
+    add_index(col_key, IndexType::Vector, metric);
+}
+
+void Table::add_index(ColKey col_key, IndexType type, VectorMetric metric)
 {
     check_column(col_key);
 
@@ -914,6 +962,8 @@ void Table::add_search_index(ColKey col_key, IndexType type)
 
     if (col_key == m_primary_key_col && type == IndexType::Fulltext)
         throw InvalidColumnKey("primary key cannot have a full text index");
+    if (col_key == m_primary_key_col && type == IndexType::Trigram)
+        throw InvalidColumnKey("primary key cannot have a trigram index");
 
     switch (type) {
         case IndexType::None:
@@ -925,7 +975,16 @@ void Table::add_search_index(ColKey col_key, IndexType type)
                 REALM_ASSERT(search_index_type(col_key) == IndexType::Fulltext);
                 return;
             }
-            if (attr.test(col_attr_Indexed)) {
+            if (attr.test(col_attr_Indexed) || attr.test(col_attr_Trigram_Indexed)) {
+                this->remove_search_index(col_key);
+            }
+            break;
+        case IndexType::Trigram:
+            if (attr.test(col_attr_Trigram_Indexed)) {
+                REALM_ASSERT(search_index_type(col_key) == IndexType::Trigram);
+                return;
+            }
+            if (attr.test(col_attr_Indexed) || attr.test(col_attr_FullText_Indexed)) {
                 this->remove_search_index(col_key);
             }
             break;
@@ -934,16 +993,36 @@ void Table::add_search_index(ColKey col_key, IndexType type)
                 REALM_ASSERT(search_index_type(col_key) == IndexType::General);
                 return;
             }
-            if (attr.test(col_attr_FullText_Indexed)) {
+            if (attr.test(col_attr_FullText_Indexed) || attr.test(col_attr_Trigram_Indexed)) {
                 this->remove_search_index(col_key);
             }
             break;
+        case IndexType::Vector:
+            if (attr.test(col_attr_Vector_Indexed)) {
+                REALM_ASSERT(search_index_type(col_key) == IndexType::Vector);
+                return;
+            }
+            break;
     }
 
-    do_add_search_index(col_key, type);
+    do_add_search_index(col_key, type, metric);
 
-    // Update spec
-    attr.set(type == IndexType::Fulltext ? col_attr_FullText_Indexed : col_attr_Indexed);
+    // Update spec. Removing a previous index has changed the attributes.
+    attr = m_spec.get_column_attr(spec_ndx);
+    switch (type) {
+        case IndexType::Fulltext:
+            attr.set(col_attr_FullText_Indexed);
+            break;
+        case IndexType::Trigram:
+            attr.set(col_attr_Trigram_Indexed);
+            break;
+        case IndexType::Vector:
+            attr.set(col_attr_Vector_Indexed);
+            break;
+        default:
+            attr.set(col_attr_Indexed);
+            break;
+    }
     m_spec.set_column_attr(spec_ndx, attr); // Throws
 }
 
@@ -969,6 +1048,8 @@ void Table::remove_search_index(ColKey col_key)
     auto attr = m_spec.get_column_attr(spec_ndx);
     attr.reset(col_attr_Indexed);
     attr.reset(col_attr_FullText_Indexed);
+    attr.reset(col_attr_Trigram_Indexed);
+    attr.reset(col_attr_Vector_Indexed);
     m_spec.set_column_attr(spec_ndx, attr); // Throws
 }
 
@@ -1086,6 +1167,7 @@ void Table::do_erase_root_column(ColKey col_key)
         REALM_ASSERT(m_index_accessors.back() == nullptr);
         m_index_accessors.pop_back();
     }
+    note_in_place_change();
     bump_content_version();
     bump_storage_version();
 }
@@ -1272,8 +1354,7 @@ IndexType Table::search_index_type(ColKey col_key) const noexcept
 {
     if (m_index_accessors[col_key.get_index().val].get()) {
         auto attr = m_spec.get_column_attr(m_leaf_ndx2spec_ndx[col_key.get_index().val]);
-        bool fulltext = attr.test(col_attr_FullText_Indexed);
-        return fulltext ? IndexType::Fulltext : IndexType::General;
+        return index_type_from_attr(attr);
     }
     return IndexType::None;
 }
@@ -1627,7 +1708,7 @@ size_t Table::count_decimal(ColKey col_key, Decimal128 value) const
 }
 size_t Table::count_string(ColKey col_key, StringData value) const
 {
-    if (auto index = this->get_search_index(col_key)) {
+    if (auto index = has_search_index(col_key) ? this->get_search_index(col_key) : nullptr) {
         return index->count(value);
     }
     return where().equal(col_key, value).count();
@@ -1698,6 +1779,12 @@ StringIndex* Table::get_string_index(ColKey col) const noexcept
     return dynamic_cast<StringIndex*>(m_index_accessors[col.get_index().val].get());
 }
 
+VectorIndex* Table::get_vector_index(ColKey col) const noexcept
+{
+    check_column(col);
+    return dynamic_cast<VectorIndex*>(m_index_accessors[col.get_index().val].get());
+}
+
 template <class T>
 ObjKey Table::find_first(ColKey col_key, T value) const
 {
@@ -1708,7 +1795,7 @@ ObjKey Table::find_first(ColKey col_key, T value) const
     }
     // You cannot call GetIndexData on ObjKey
     if constexpr (!std::is_same_v<T, ObjKey>) {
-        if (SearchIndex* index = get_search_index(col_key)) {
+        if (SearchIndex* index = has_search_index(col_key) ? get_search_index(col_key) : nullptr) {
             return index->find_first(value);
         }
         if (col_key == m_primary_key_col) {
@@ -2027,6 +2114,12 @@ void Table::schema_to_json(std::ostream& out) const
         if (index_type == IndexType::Fulltext) {
             out << ",\"isFulltextIndexed\":true";
         }
+        if (index_type == IndexType::Trigram) {
+            out << ",\"isTrigramIndexed\":true";
+        }
+        if (index_type == IndexType::Vector) {
+            out << ",\"isVectorIndexed\":true";
+        }
         out << "}";
         if (i < sz - 1) {
             out << ",";
@@ -2077,8 +2170,18 @@ void Table::flush_for_commit()
             ++m_in_file_version_at_transaction_boundary;
             auto rot_version = RefOrTagged::make_tagged(m_in_file_version_at_transaction_boundary);
             m_top.set(top_position_for_version, rot_version);
+            // Tables without the slot are treated as changed in place, so
+            // add it conservatively
+            if (m_changed_in_place_since_commit || m_top.size() <= top_position_for_in_place_version) {
+                while (m_top.size() <= top_position_for_in_place_version)
+                    m_top.add(0);
+                m_top.set(top_position_for_in_place_version, rot_version);
+            }
         }
     }
+    m_changed_since_commit = false;
+    m_changed_in_place_since_commit = false;
+    start_append_run();
 }
 
 void Table::refresh_content_version()
@@ -2089,15 +2192,35 @@ void Table::refresh_content_version()
         // bump the version counter:
         auto rot_version = m_top.get_as_ref_or_tagged(top_position_for_version);
         REALM_ASSERT(rot_version.is_tagged());
-        if (m_in_file_version_at_transaction_boundary != rot_version.get_as_int()) {
+        uint64_t prev_version = m_in_file_version_at_transaction_boundary;
+        if (prev_version != rot_version.get_as_int()) {
             m_in_file_version_at_transaction_boundary = rot_version.get_as_int();
             bump_content_version();
+            // If no commit since the previous version changed objects in
+            // place, the objects have only been appended to
+            bool appended_only = false;
+            if (m_top.size() > top_position_for_in_place_version &&
+                m_in_file_version_at_transaction_boundary > prev_version) {
+                auto rot_in_place = m_top.get_as_ref_or_tagged(top_position_for_in_place_version);
+                appended_only = rot_in_place.is_tagged() && rot_in_place.get_as_int() <= prev_version;
+            }
+            if (!appended_only)
+                note_in_place_change();
+        }
+        else if (m_changed_since_commit) {
+            // Changes have been rolled back
+            bump_content_version();
+            note_in_place_change();
         }
     }
     else {
         // assume the worst:
         bump_content_version();
+        note_in_place_change();
     }
+    m_changed_since_commit = false;
+    m_changed_in_place_since_commit = false;
+    start_append_run();
 }
 
 
@@ -2159,13 +2282,17 @@ void Table::refresh_index_accessors()
         }
         else {
             auto attr = m_spec.get_column_attr(m_leaf_ndx2spec_ndx[col_ndx]);
-            bool fulltext = attr.test(col_attr_FullText_Indexed);
             auto col_key = m_leaf_ndx2colkey[col_ndx];
-            ClusterColumn virtual_col(&m_clusters, col_key, fulltext ? IndexType::Fulltext : IndexType::General);
+            auto index_type = index_type_from_attr(attr);
+            ClusterColumn virtual_col(&m_clusters, col_key, index_type);
 
             if (m_index_accessors[col_ndx]) { // still there, refresh:
                 m_index_accessors[col_ndx]->refresh_accessor_tree(virtual_col);
             }
+            else if (index_type == IndexType::Vector) {
+                m_index_accessors[col_ndx] =
+                    std::make_unique<VectorIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
+            }
             else { // new index!
                 m_index_accessors[col_ndx] =
                     std::make_unique<StringIndex>(ref, &m_index_refs, col_ndx, virtual_col, get_alloc());
@@ -2200,6 +2327,50 @@ void Table::verify() const
 #endif
 }
 
+namespace {
+
+// Visit the nodes of a subtree in the order in which they are written on commit
+template <class F>
+void for_each_node_in_write_order(Allocator& alloc, ref_type ref, F&& fn)
+{
+    Array node(alloc);
+    node.init_from_ref(ref);
+    if (node.has_refs()) {
+        for (size_t i = 0, sz = node.size(); i < sz; ++i) {
+            auto val = node.get(i);
+            if (val && !(val & 1))
+                for_each_node_in_write_order(alloc, to_ref(val), fn);
+        }
+    }
+    fn(node);
+}
+
+} // anonymous namespace
+
+auto Table::get_layout_info() const -> LayoutInfo
+{
+    LayoutInfo info;
+    size_t begin = std::numeric_limits<size_t>::max();
+    size_t end = 0;
+    size_t prev_end = 0;
+    for_each_node_in_write_order(m_alloc, m_top.get_ref(), [&](const Array& node) {
+        ref_type ref = node.get_ref();
+        if (!m_alloc.is_read_only(ref))
+            return;
+        size_t byte_size = node.get_byte_size();
+        ++info.node_count;
+        info.byte_size += byte_size;
+        if (ref != prev_end)
+            ++info.extent_count;
+        prev_end = ref + byte_size;
+        begin = std::min(begin, ref);
+        end = std::max(end, prev_end);
+    });
+    if (info.node_count)
+        info.span = end - begin;
+    return info;
+}
+
 #ifdef REALM_DEBUG
 MemStats Table::stats() const
 {
@@ -2355,6 +2526,16 @@ ObjKey Table::get_objkey_from_primary_key(const Mixed& primary_key)
     return get_or_create_tombstone(ObjKey{}, m_primary_key_col, primary_key).get_key();
 }
 
+void Table::get_objects(const ObjKey* keys, size_t num_keys, std::vector<Obj>& objects) const
+{
+    objects.clear();
+    objects.resize(num_keys);
+    TableRef table = m_own_ref;
+    m_clusters.resolve(keys, num_keys, [&](size_t i, const Cluster* cluster, size_t ndx) {
+        objects[i] = Obj(table, cluster->get_mem(), keys[i], ndx);
+    });
+}
+
 Obj Table::get_object_with_primary_key(Mixed primary_key) const
 {
     auto primary_key_col = get_primary_key_column();
@@ -2655,6 +2836,9 @@ void Table::do_set_primary_key_column(ColKey col_key)
         if (attr.test(col_attr_FullText_Indexed)) {
             throw InvalidColumnKey("primary key cannot have a full text index");
         }
+        if (attr.test(col_attr_Trigram_Indexed)) {
+            throw InvalidColumnKey("primary key cannot have a trigram index");
+        }
     }
 
     if (m_primary_key_col) {
@@ -2952,6 +3136,7 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
     check_column(col_key);
 
     auto index_type = search_index_type(col_key);
+    auto vector_metric = index_type == IndexType::Vector ? get_vector_index(col_key)->get_metric() : VectorMetric::L2;
     std::string column_name(get_column_name(col_key));
     auto type = col_key.get_type();
     auto attr = col_key.get_attrs();
@@ -2985,8 +3170,19 @@ ColKey Table::set_nullability(ColKey col_key, bool nullable, bool throw_on_null)
     erase_root_column(col_key);
     m_spec.rename_column(colkey2spec_ndx(new_col), column_name);
 
-    if (index_type != IndexType::None)
-        do_add_search_index(new_col, index_type);
+    if (index_type != IndexType::None) {
+        do_add_search_index(new_col, index_type, vector_metric);
+        // The column key only holds the lower attribute bits
+        auto spec_ndx = colkey2spec_ndx(new_col);
+        auto new_attr = m_spec.get_column_attr(spec_ndx);
+        if (index_type == IndexType::Fulltext)
+            new_attr.set(col_attr_FullText_Indexed);
+        if (index_type == IndexType::Trigram)
+            new_attr.set(col_attr_Trigram_Indexed);
+        if (index_type == IndexType::Vector)
+            new_attr.set(col_attr_Vector_Indexed);
+        m_spec.set_column_attr(spec_ndx, new_attr); // Throws
+    }
 
     return new_col;
 }
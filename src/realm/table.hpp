@@ -60,6 +60,7 @@ class Subexpr;
 template <class>
 class SubQuery;
 class TableView;
+class VectorIndex;
 
 struct Link {};
 typedef Link BackLink;
@@ -232,6 +233,15 @@ public:
     /// index. The search index cannot be removed from the primary key of a
     /// table.
     ///
+    /// A trigram index (IndexType::Trigram) on a string column lets contains
+    /// and like conditions look up the objects holding every sequence of
+    /// three bytes of the pattern instead of scanning all strings.
+    ///
+    /// A vector index (IndexType::Vector) on a binary column holding vectors
+    /// of floats is used by Query::nearest() to find the vectors closest to a
+    /// given one without computing the distance to all of them. The index is
+    /// built for one metric, which add_vector_index() lets you choose.
+    ///
     /// \param col_key The key of a column of the table.
 
     IndexType search_index_type(ColKey col_key) const noexcept;
@@ -244,6 +254,11 @@ public:
     {
         add_search_index(col_key, IndexType::Fulltext);
     }
+    void add_trigram_index(ColKey col_key)
+    {
+        add_search_index(col_key, IndexType::Trigram);
+    }
+    void add_vector_index(ColKey col_key, VectorMetric metric = VectorMetric::L2);
     void remove_search_index(ColKey col_key);
 
     void enumerate_string_column(ColKey col_key);
@@ -328,6 +343,16 @@ public:
     {
         return m_clusters.get(ndx);
     }
+    // Get the objects with the given keys, in the order of the keys. The keys are looked up in batches, see
+    // ClusterTree::resolve(). Keys which do not refer to an object give a null Obj.
+    void get_objects(const ObjKey* keys, size_t num_keys, std::vector<Obj>& objects) const;
+    // Look up the leaf and index of a batch of objects, see ClusterTree::resolve()
+    void resolve_objects(const ObjKey* keys, size_t num_keys, ClusterTree::ResolveFunction func) const
+    {
+        m_clusters.resolve(keys, num_keys, func);
+    }
+    // Number of keys looked up together by get_objects() when iterating over views
+    static constexpr size_t object_batch_size = 1024;
     // Get object based on primary key
     Obj get_object_with_primary_key(Mixed pk) const;
     // Get primary key based on ObjKey
@@ -344,6 +369,11 @@ public:
     {
         return m_clusters.traverse(func);
     }
+    // Only visit the clusters which may hold objects with keys not below 'first'
+    bool traverse_clusters(ClusterTree::TraverseFunction func, ObjKey first) const
+    {
+        return m_clusters.traverse(func, first);
+    }
 
     /// remove_object() removes the specified object from the table.
     /// Any links from the specified object into objects residing in an embedded
@@ -425,6 +455,7 @@ public:
     // Will return pointer to search index accessor. Will return nullptr if no index
     SearchIndex* get_search_index(ColKey col) const noexcept;
     StringIndex* get_string_index(ColKey col) const noexcept;
+    VectorIndex* get_vector_index(ColKey col) const noexcept;
 
     template <class T>
     ObjKey find_first(ColKey col_key, T value) const;
@@ -480,6 +511,17 @@ public:
     void bump_storage_version() const noexcept;
     void bump_content_version() const noexcept;
 
+    // Objects created with a key above all existing keys after the last call
+    // to start_append_run() are appended. Any other change to the objects of
+    // the table, committed by this or another transaction, is an in-place
+    // change. As long as the in-place change count is unchanged, the objects
+    // which existed at the start of the append run are unchanged too.
+    uint64_t get_in_place_change_count() const noexcept;
+    void start_append_run() const noexcept;
+    void note_object_created(ObjKey key, bool at_end) noexcept;
+    void note_object_changed(ObjKey key) noexcept;
+    void note_in_place_change() noexcept;
+
     // Change the nullability of the column identified by col_key.
     // This might result in the creation of a new column and deletion of the old.
     // The column key to use going forward is returned.
@@ -644,6 +686,29 @@ public:
     /// See operator==().
     bool operator!=(const Table& t) const;
 
+    /// \brief How the nodes of this table are laid out in the file.
+    ///
+    /// Nodes are visited in the order in which a commit writes them, i.e.
+    /// depth first with the children of a node before the node itself. Only
+    /// nodes which are already in the file are included.
+    struct LayoutInfo {
+        size_t node_count = 0;
+        size_t byte_size = 0;
+        /// Number of runs of nodes which directly follow each other in the file
+        size_t extent_count = 0;
+        /// Distance from the first to the last byte used by the nodes
+        size_t span = 0;
+
+        /// The fraction of the span used by the table. 1 means that the
+        /// table is stored contiguously.
+        double density() const noexcept
+        {
+            return span ? double(byte_size) / double(span) : 1.0;
+        }
+    };
+    /// See also Transaction::recluster_table().
+    LayoutInfo get_layout_info() const;
+
     // Debug
     void verify() const;
 
@@ -767,7 +832,8 @@ private:
     void erase_root_column(ColKey col_key);
     ColKey do_insert_root_column(ColKey col_key, ColumnType, StringData name, DataType key_type = DataType(0));
     void do_erase_root_column(ColKey col_key);
-    void do_add_search_index(ColKey col_key, IndexType type);
+    void add_index(ColKey col_key, IndexType type, VectorMetric metric);
+    void do_add_search_index(ColKey col_key, IndexType type, VectorMetric metric = VectorMetric::L2);
 
     bool has_any_embedded_objects();
     void set_opposite_column(ColKey col_key, TableKey opposite_table, ColKey opposite_column);
@@ -825,6 +891,10 @@ private:
     std::vector<size_t> m_leaf_ndx2spec_ndx;
     Type m_table_type = Type::TopLevel;
     uint64_t m_in_file_version_at_transaction_boundary = 0;
+    uint64_t m_in_place_change_count = 0;
+    mutable int64_t m_first_appended_key = std::numeric_limits<int64_t>::max();
+    bool m_changed_since_commit = false;
+    bool m_changed_in_place_since_commit = false;
     AtomicLifeCycleCookie m_cookie;
 
     static constexpr int top_position_for_spec = 0;
@@ -843,6 +913,8 @@ private:
     // flags contents: bit 0-1 - table type
     static constexpr int top_position_for_tombstones = 13;
     static constexpr int top_array_size = 14;
+    // Optional: The value of slot 6 at the last commit with in-place changes
+    static constexpr int top_position_for_in_place_version = 14;
 
     enum { s_collision_map_lo = 0, s_collision_map_hi = 1, s_collision_map_local_id = 2, s_collision_map_num_slots };
 
@@ -1141,6 +1213,41 @@ inline void Table::bump_content_version() const noexcept
     m_alloc.bump_content_version();
 }
 
+inline uint64_t Table::get_in_place_change_count() const noexcept
+{
+    return m_in_place_change_count;
+}
+
+inline void Table::start_append_run() const noexcept
+{
+    m_first_appended_key = std::numeric_limits<int64_t>::max();
+}
+
+inline void Table::note_object_created(ObjKey key, bool at_end) noexcept
+{
+    m_changed_since_commit = true;
+    if (!at_end) {
+        note_in_place_change();
+    }
+    else if (key.value < m_first_appended_key) {
+        m_first_appended_key = key.value;
+    }
+}
+
+inline void Table::note_object_changed(ObjKey key) noexcept
+{
+    m_changed_since_commit = true;
+    if (key.value < m_first_appended_key)
+        note_in_place_change();
+}
+
+inline void Table::note_in_place_change() noexcept
+{
+    m_changed_since_commit = true;
+    m_changed_in_place_since_commit = true;
+    ++m_in_place_change_count;
+}
+
 
 inline size_t Table::get_column_count() const noexcept
 {
@@ -1376,6 +1483,11 @@ public:
         return table.get_parent_group();
     }
 
+    static ref_type get_ref(const Table& table) noexcept
+    {
+        return table.m_top.get_ref();
+    }
+
     static void remove_recursive(Table& table, CascadeState& rows)
     {
         table.remove_recursive(rows); // Throws
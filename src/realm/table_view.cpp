@@ -19,6 +19,7 @@
 #include <realm/table_view.hpp>
 #include <realm/column_integer.hpp>
 #include <realm/index_string.hpp>
+#include <realm/query_cache.hpp>
 #include <realm/transaction.hpp>
 
 #include <unordered_set>
@@ -62,11 +63,58 @@ TableView::TableView(TableView& src, Transaction* tr, PayloadPolicy policy_mode)
     }
     if (policy_mode == PayloadPolicy::Move) {
         src.m_last_seen_versions.clear();
+        src.m_append_sync.reset();
     }
     m_descriptor_ordering = src.m_descriptor_ordering;
     m_limit = src.m_limit;
 }
 
+void TableView::for_each_obj(util::FunctionRef<IteratorControl(const Obj&)> func) const
+{
+    std::vector<Obj> objects;
+    const size_t sz = m_key_values.size();
+    for (size_t begin = 0; begin < sz; begin += Table::object_batch_size) {
+        size_t n = std::min(Table::object_batch_size, sz - begin);
+        m_table->get_objects(m_key_values.data() + begin, n, objects);
+        for (auto& obj : objects) {
+            if (obj && func(obj) == IteratorControl::Stop)
+                return;
+        }
+    }
+}
+
+template <typename T, class F>
+void TableView::for_each_value(ColKey column_key, F&& func) const
+{
+    // The values of a batch are read leaf by leaf in key order, and then delivered in view order
+    typename ColumnTypeTraits<T>::cluster_leaf_type leaf(m_table->get_alloc());
+    ref_type leaf_ref = 0;
+    std::vector<T> values;
+    std::vector<bool> found;
+    const size_t sz = m_key_values.size();
+    for (size_t begin = 0; begin < sz; begin += Table::object_batch_size) {
+        size_t n = std::min(Table::object_batch_size, sz - begin);
+        values.resize(n);
+        found.assign(n, false);
+        m_table->resolve_objects(m_key_values.data() + begin, n, [&](size_t i, const Cluster* cluster, size_t ndx) {
+            if (cluster->get_ref() != leaf_ref) {
+                cluster->init_leaf(column_key, &leaf);
+                leaf_ref = cluster->get_ref();
+            }
+            values[i] = leaf.get(ndx);
+            if constexpr (std::is_same_v<T, Mixed>) {
+                if (values[i].is_unresolved_link())
+                    values[i] = Mixed();
+            }
+            found[i] = true;
+        });
+        for (size_t i = 0; i < n; i++) {
+            if (found[i])
+                func(m_key_values[begin + i], values[i]);
+        }
+    }
+}
+
 // Aggregates ----------------------------------------------------
 
 template <typename T, Action AggregateOpType>
@@ -101,29 +149,15 @@ Mixed TableView::aggregate(ColKey column_key, size_t* result_count, ObjKey* retu
     size_t non_nulls = 0;
     typename Aggregator<T, action>::AggType agg;
     ObjKey last_accumulated_key = null_key;
-    for (size_t tv_index = 0; tv_index < m_key_values.size(); ++tv_index) {
-        ObjKey key(get_key(tv_index));
-
-        // skip detached references:
-        if (key == realm::null_key)
-            continue;
-
-        const Obj obj = m_table->try_get_object(key);
-        // aggregation must be robust in the face of stale keys:
-        if (!obj.is_valid())
-            continue;
-
-        if (obj.is_null(column_key))
-            continue;
-
-        auto v = obj.get<T>(column_key);
+    // Detached references and stale keys are skipped, and null values are ignored by the accumulator
+    for_each_value<T>(column_key, [&](ObjKey key, const T& v) {
         if (agg.accumulate(v)) {
             ++non_nulls;
             if constexpr (action == act_Min || action == act_Max) {
                 last_accumulated_key = key;
             }
         }
-    }
+    });
 
     if (result_count)
         *result_count = non_nulls;
@@ -160,22 +194,11 @@ size_t TableView::aggregate_count(ColKey column_key, T count_target) const
     }
 
     size_t cnt = 0;
-    for (size_t tv_index = 0; tv_index < m_key_values.size(); ++tv_index) {
-        ObjKey key(get_key(tv_index));
-
-        // skip detached references:
-        if (key == realm::null_key)
-            continue;
-
-        const Obj obj = m_table->try_get_object(key);
-        if (!obj.is_valid())
-            continue;
-
-        auto v = obj.get<T>(column_key);
+    for_each_value<T>(column_key, [&](ObjKey, const T& v) {
         if (v == count_target) {
             cnt++;
         }
-    }
+    });
 
     return cnt;
 }
@@ -331,7 +354,9 @@ void TableView::sync_if_needed() const
 {
     if (!is_in_sync()) {
         // FIXME: Is this a reasonable handling of constness?
-        const_cast<TableView*>(this)->do_sync();
+        auto self = const_cast<TableView*>(this);
+        if (!self->sync_appended_objects())
+            self->do_sync();
     }
 }
 
@@ -478,13 +503,60 @@ void TableView::do_sync()
                     limit = l;
             }
         }
-        QueryStateFindAll<std::vector<ObjKey>> st(m_key_values, limit);
-        m_query->do_find_all(st);
+        QueryResultCache::Operation cached(*m_query, util::format("find_all %1", limit));
+        QueryResultCache::Result result;
+        if (cached.find(result)) {
+            m_key_values.insert(m_key_values.end(), result.keys.begin(), result.keys.end());
+        }
+        else {
+            QueryStateFindAll<std::vector<ObjKey>> st(m_key_values, limit);
+            m_query->do_find_all(st);
+            if (m_key_values.size() <= QueryResultCache::max_cached_keys) {
+                result.keys.assign(m_key_values.begin(), m_key_values.end());
+                cached.store(std::move(result));
+            }
+        }
     }
 
     apply_descriptors(m_descriptor_ordering);
 
     get_dependencies(m_last_seen_versions);
+
+    // Results of an unsorted query without a limit can be extended with the
+    // objects appended to the table later on
+    if (m_query && m_query->m_table && m_query->produces_results_in_table_order() &&
+        m_descriptor_ordering.is_empty() && m_limit == size_t(-1) && m_last_seen_versions.size() == 1) {
+        auto table = m_query->m_table.unchecked_ptr();
+        table->start_append_run();
+        m_append_sync = AppendSyncState{table->get_in_place_change_count(), table->m_clusters.get_last_key_value()};
+    }
+    else {
+        m_append_sync.reset();
+    }
+}
+
+bool TableView::sync_appended_objects()
+{
+    if (!m_append_sync || !m_query || !m_query->m_table || !m_descriptor_ordering.is_empty())
+        return false;
+    auto table = m_query->m_table.unchecked_ptr();
+    if (m_append_sync->in_place_change_count != table->get_in_place_change_count())
+        return false;
+
+    // The query must not depend on other tables, as their changes are not tracked
+    TableVersions versions;
+    get_dependencies(versions);
+    if (versions.size() != 1)
+        return false;
+
+    util::CriticalSection cs(m_race_detector);
+    QueryStateFindAll<std::vector<ObjKey>> st(m_key_values);
+    m_query->do_find_all(st, ObjKey(m_append_sync->last_key + 1));
+
+    m_last_seen_versions = std::move(versions);
+    table->start_append_run();
+    m_append_sync->last_key = table->m_clusters.get_last_key_value();
+    return true;
 }
 
 void TableView::apply_descriptors(const DescriptorOrdering& ordering)
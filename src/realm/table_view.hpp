@@ -244,6 +244,9 @@ public:
         return m_table->try_get_object(key);
     }
 
+    // The objects are looked up in batches, see Table::get_objects()
+    void for_each_obj(util::FunctionRef<IteratorControl(const Obj&)> func) const final;
+
     // Get the query used to create this TableView
     // The query will have a null source table if this tv was not created from
     // a query
@@ -400,6 +403,7 @@ protected:
     void get_dependencies(TableVersions&) const final;
 
     void do_sync();
+    bool sync_appended_objects();
     void apply_descriptors(const DescriptorOrdering&);
 
     mutable ConstTableRef m_table;
@@ -422,8 +426,19 @@ protected:
     mutable TableVersions m_last_seen_versions;
     KeyValues m_key_values;
 
+    // When the table has only been appended to since the last sync, only the
+    // objects with keys above 'last_key' need to be evaluated by the query.
+    struct AppendSyncState {
+        uint64_t in_place_change_count;
+        int64_t last_key;
+    };
+    std::optional<AppendSyncState> m_append_sync;
+
 private:
     ObjKey find_first_integer(ColKey column_key, int64_t value) const;
+    // Call 'func' with the value of the column for every valid object in the view, in view order
+    template <typename T, class F>
+    void for_each_value(ColKey column_key, F&& func) const;
     template <Action action>
     std::optional<Mixed> aggregate(ColKey column_key, size_t* count, ObjKey* return_key) const;
 
@@ -492,6 +507,7 @@ inline TableView::TableView(const TableView& tv)
     , m_limit(tv.m_limit)
     , m_last_seen_versions(tv.m_last_seen_versions)
     , m_key_values(tv.m_key_values)
+    , m_append_sync(tv.m_append_sync)
 {
 }
 
@@ -507,6 +523,7 @@ inline TableView::TableView(TableView&& tv) noexcept
     // version number so that we can later trigger a sync if needed.
     , m_last_seen_versions(std::move(tv.m_last_seen_versions))
     , m_key_values(std::move(tv.m_key_values))
+    , m_append_sync(tv.m_append_sync)
 {
 }
 
@@ -522,6 +539,7 @@ inline TableView& TableView::operator=(TableView&& tv) noexcept
     m_linked_obj = tv.m_linked_obj;
     m_collection_source = std::move(tv.m_collection_source);
     m_descriptor_ordering = std::move(tv.m_descriptor_ordering);
+    m_append_sync = tv.m_append_sync;
 
     return *this;
 }
@@ -540,6 +558,7 @@ inline TableView& TableView::operator=(const TableView& tv)
     m_linked_obj = tv.m_linked_obj;
     m_collection_source = tv.m_collection_source ? tv.m_collection_source->clone_obj_list() : LinkCollectionPtr{};
     m_descriptor_ordering = tv.m_descriptor_ordering;
+    m_append_sync = tv.m_append_sync;
 
     return *this;
 }
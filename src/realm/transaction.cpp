@@ -533,7 +533,7 @@ void Transaction::upgrade_file_format(int target_file_format_version)
     // Be sure to revisit the following upgrade logic when a new file format
     // version is introduced. The following assert attempt to help you not
     // forget it.
-    REALM_ASSERT_EX(target_file_format_version == 24, target_file_format_version);
+    REALM_ASSERT_EX(target_file_format_version == 25, target_file_format_version);
 
     // DB::do_open() must ensure that only supported version are allowed.
     // It does that by asking backup if the current file format version is
@@ -585,6 +585,9 @@ void Transaction::upgrade_file_format(int target_file_format_version)
             t->free_collision_table();
         }
     }
+    // Version 25 only adds the compact Timestamp leaf layout. Existing leaves
+    // remain valid, so no conversion is needed.
+
     // NOTE: Additional future upgrade steps go here.
 }
 
@@ -968,4 +971,17 @@ void Transaction::cow_outliers(std::vector<size_t>& progress, size_t evac_limit,
     progress.clear();
 }
 
+void Transaction::recluster_table(TableKey key)
+{
+    if (m_transact_stage != DB::transact_Writing)
+        throw WrongTransactionState("Not a write transaction");
+
+    auto table = get_table(key); // Throws
+    // With an evacuation limit of 0 every node in the file is moved
+    NodeTree node_tree(0, size_t(std::numeric_limits<int64_t>::max()));
+    std::vector<size_t> progress = {0};
+    node_tree.trv(table->m_top, 1, progress); // Throws
+    table->refresh_accessor_tree();
+}
+
 } // namespace realm
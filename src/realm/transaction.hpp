@@ -122,6 +122,16 @@ public:
 
     void upgrade_file_format(int target_file_format_version);
 
+    /// Rewrite a table sequentially on the next commit.
+    ///
+    /// Updates leave the nodes of a table scattered across the file, which
+    /// makes full scans of a cold file slow. This copies all nodes of the
+    /// table into memory, so that the next commit writes the whole table in
+    /// one go, preferably into a single contiguous extent. The copy is held
+    /// until the commit. See Table::get_layout_info() for how to measure the
+    /// effect.
+    void recluster_table(TableKey key);
+
     /// Task oriented/async interface for continuous transactions.
     // true if this transaction already holds the write mutex
     bool holds_write_mutex() const noexcept REQUIRES(!m_async_mutex)
@@ -169,6 +179,11 @@ public:
         return db->m_logger;
     }
 
+    QueryResultCache* get_query_cache() const noexcept
+    {
+        return db->get_query_cache();
+    }
+
 private:
     enum class AsyncState { Idle, Requesting, HasLock, HasCommits, Syncing };
 
@@ -0,0 +1,776 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include <realm/vector_index.hpp>
+
+#include <realm/array_binary.hpp>
+#include <realm/bplustree.hpp>
+#include <realm/column_integer.hpp>
+#include <realm/exceptions.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <queue>
+#include <unordered_set>
+
+#ifdef REALM_DEBUG
+#include <iostream>
+#endif
+
+using namespace realm;
+
+namespace {
+
+enum TopPosition : size_t {
+    s_dimensions_ndx,
+    s_metric_ndx,
+    s_entry_point_ndx,
+    s_top_level_ndx,
+    s_erased_ndx,
+    s_keys_ndx,
+    s_vectors_ndx,
+    s_links_ndx,
+    s_sorted_keys_ndx,
+    s_sorted_nodes_ndx,
+    s_top_size
+};
+
+// Maximum number of links of a node on levels above 0, and on level 0
+constexpr size_t s_max_links = 16;
+constexpr size_t s_max_links_level0 = 2 * s_max_links;
+// Number of candidates considered when linking a new node
+constexpr size_t s_ef_construction = 100;
+constexpr int s_max_level = 16;
+
+// Number of partial sums in the distance kernels. Independent sums let the compiler keep the loops in vector
+// registers without reassociating floating point additions.
+constexpr size_t s_lanes = 8;
+
+float l2_distance(const float* a, const float* b, size_t size) noexcept
+{
+    float sums[s_lanes] = {};
+    size_t i = 0;
+    for (; i + s_lanes <= size; i += s_lanes) {
+        for (size_t j = 0; j < s_lanes; ++j) {
+            float d = a[i + j] - b[i + j];
+            sums[j] += d * d;
+        }
+    }
+    float total = 0;
+    for (; i < size; ++i) {
+        float d = a[i] - b[i];
+        total += d * d;
+    }
+    for (auto s : sums)
+        total += s;
+    return total;
+}
+
+float inner_product(const float* a, const float* b, size_t size) noexcept
+{
+    float sums[s_lanes] = {};
+    size_t i = 0;
+    for (; i + s_lanes <= size; i += s_lanes) {
+        for (size_t j = 0; j < s_lanes; ++j)
+            sums[j] += a[i + j] * b[i + j];
+    }
+    float total = 0;
+    for (; i < size; ++i)
+        total += a[i] * b[i];
+    for (auto s : sums)
+        total += s;
+    return total;
+}
+
+float cosine_distance(const float* a, const float* b, size_t size) noexcept
+{
+    float dots[s_lanes] = {};
+    float norms_a[s_lanes] = {};
+    float norms_b[s_lanes] = {};
+    size_t i = 0;
+    for (; i + s_lanes <= size; i += s_lanes) {
+        for (size_t j = 0; j < s_lanes; ++j) {
+            dots[j] += a[i + j] * b[i + j];
+            norms_a[j] += a[i + j] * a[i + j];
+            norms_b[j] += b[i + j] * b[i + j];
+        }
+    }
+    float dot = 0, norm_a = 0, norm_b = 0;
+    for (; i < size; ++i) {
+        dot += a[i] * b[i];
+        norm_a += a[i] * a[i];
+        norm_b += b[i] * b[i];
+    }
+    for (size_t j = 0; j < s_lanes; ++j) {
+        dot += dots[j];
+        norm_a += norms_a[j];
+        norm_b += norms_b[j];
+    }
+    if (norm_a == 0 || norm_b == 0)
+        return 1;
+    return 1 - dot / std::sqrt(norm_a * norm_b);
+}
+
+// The level of a new node. It is derived from the object key, so the graph built from the same objects is the
+// same on every device.
+int random_level(ObjKey key) noexcept
+{
+    uint64_t h = uint64_t(key.value) + 0x9e3779b97f4a7c15ULL;
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    double uniform = double((h >> 11) + 1) / double(uint64_t(1) << 53);
+    double level = -std::log(uniform) / std::log(double(s_max_links));
+    return std::min(int(level), s_max_level);
+}
+
+} // anonymous namespace
+
+float realm::vector_distance(VectorMetric metric, const float* a, const float* b, size_t size) noexcept
+{
+    switch (metric) {
+        case VectorMetric::L2:
+            return l2_distance(a, b, size);
+        case VectorMetric::Cosine:
+            return cosine_distance(a, b, size);
+        case VectorMetric::Dot:
+            return -inner_product(a, b, size);
+    }
+    return 0;
+}
+
+// Accessors for the arrays of the graph. They are created for each operation, so they never have to be refreshed
+// when the index is.
+class VectorIndex::Graph {
+public:
+    using Candidate = std::pair<float, uint32_t>;
+
+    Graph(const VectorIndex& index)
+        : m_top(const_cast<Array&>(index.m_top))
+        , m_dimensions(size_t(m_top.get_as_ref_or_tagged(s_dimensions_ndx).get_as_int()))
+        , m_metric(VectorMetric(m_top.get_as_ref_or_tagged(s_metric_ndx).get_as_int()))
+        , m_keys(m_top.get_alloc())
+        , m_vectors(m_top.get_alloc())
+        , m_links(m_top.get_alloc())
+        , m_sorted_keys(m_top.get_alloc())
+        , m_sorted_nodes(m_top.get_alloc())
+        , m_buffer(m_dimensions)
+    {
+        attach(m_keys, s_keys_ndx);
+        attach(m_vectors, s_vectors_ndx);
+        attach(m_links, s_links_ndx);
+        attach(m_sorted_keys, s_sorted_keys_ndx);
+        attach(m_sorted_nodes, s_sorted_nodes_ndx);
+    }
+
+    size_t dimensions() const
+    {
+        return m_dimensions;
+    }
+    size_t num_nodes() const
+    {
+        return m_keys.size();
+    }
+    size_t num_vectors() const
+    {
+        return m_sorted_keys.size();
+    }
+    // The object key of a node, or null if it is erased
+    ObjKey get_key(uint32_t node) const
+    {
+        int64_t value = m_keys.get(node);
+        return value < 0 ? ObjKey() : ObjKey(value);
+    }
+    size_t get_erased() const
+    {
+        return size_t(m_top.get_as_ref_or_tagged(s_erased_ndx).get_as_int());
+    }
+    void load_vector(uint32_t node, float* vector) const;
+
+    void insert(ObjKey key, const std::vector<float>& vector);
+    // Returns false if the object has no vector in the index
+    bool erase(ObjKey key);
+    void search(const float* vector, size_t k, size_t ef, util::FunctionRef<bool(ObjKey)> filter,
+                std::vector<std::pair<ObjKey, float>>& result);
+    void verify() const;
+#ifdef REALM_DEBUG
+    void print() const;
+#endif
+
+private:
+    Array& m_top;
+    size_t m_dimensions;
+    VectorMetric m_metric;
+    IntegerColumn m_keys;
+    BPlusTree<BinaryData> m_vectors;
+    BPlusTree<BinaryData> m_links;
+    IntegerColumn m_sorted_keys;
+    IntegerColumn m_sorted_nodes;
+    std::vector<float> m_buffer;
+    std::vector<uint32_t> m_link_buffer;
+    std::unordered_set<uint32_t> m_visited;
+
+    template <class T>
+    void attach(T& tree, size_t ndx)
+    {
+        tree.set_parent(&m_top, ndx);
+        tree.init_from_parent();
+    }
+    size_t get_tagged(size_t ndx) const
+    {
+        return size_t(m_top.get_as_ref_or_tagged(ndx).get_as_int());
+    }
+    void set_tagged(size_t ndx, size_t value)
+    {
+        m_top.set(ndx, RefOrTagged::make_tagged(value));
+    }
+
+    float distance(const float* vector, uint32_t node)
+    {
+        load_vector(node, m_buffer.data());
+        return vector_distance(m_metric, vector, m_buffer.data(), m_dimensions);
+    }
+    void load_links(uint32_t node, std::vector<uint32_t>& links) const;
+    void store_links(uint32_t node, const std::vector<uint32_t>& links);
+    // Position of the number of links on 'level' in the links of a node
+    static size_t level_offset(const std::vector<uint32_t>& links, int level);
+    size_t find_key(ObjKey key) const;
+
+    std::vector<Candidate> search_level(const float* vector, const std::vector<Candidate>& entry_points, size_t ef,
+                                        int level, util::FunctionRef<bool(uint32_t)> accept);
+    std::vector<Candidate> descend(const float* vector, int to_level);
+    std::vector<uint32_t> select_neighbours(const std::vector<Candidate>& candidates, size_t max_links);
+    void add_link(uint32_t from, uint32_t to, int level);
+};
+
+void VectorIndex::Graph::load_vector(uint32_t node, float* vector) const
+{
+    // The values of a binary column are not aligned, so the vector is copied
+    BinaryData data = m_vectors.get(node);
+    REALM_ASSERT_DEBUG(data.size() == m_dimensions * sizeof(float));
+    std::memcpy(vector, data.data(), m_dimensions * sizeof(float));
+}
+
+void VectorIndex::Graph::load_links(uint32_t node, std::vector<uint32_t>& links) const
+{
+    BinaryData data = m_links.get(node);
+    links.resize(data.size() / sizeof(uint32_t));
+    std::memcpy(links.data(), data.data(), data.size());
+}
+
+void VectorIndex::Graph::store_links(uint32_t node, const std::vector<uint32_t>& links)
+{
+    m_links.set(node, BinaryData(reinterpret_cast<const char*>(links.data()), links.size() * sizeof(uint32_t)));
+}
+
+size_t VectorIndex::Graph::level_offset(const std::vector<uint32_t>& links, int level)
+{
+    REALM_ASSERT_DEBUG(level < int(links[0]));
+    size_t pos = 1;
+    for (int l = 0; l < level; ++l)
+        pos += 1 + links[pos];
+    return pos;
+}
+
+size_t VectorIndex::Graph::find_key(ObjKey key) const
+{
+    return std::lower_bound(m_sorted_keys.cbegin(), m_sorted_keys.cend(), key.value) - m_sorted_keys.cbegin();
+}
+
+auto VectorIndex::Graph::search_level(const float* vector, const std::vector<Candidate>& entry_points, size_t ef,
+                                      int level, util::FunctionRef<bool(uint32_t)> accept) -> std::vector<Candidate>
+{
+    // Nodes to expand, closest first
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> candidates;
+    // The 'ef' closest accepted nodes found, farthest first
+    std::priority_queue<Candidate> found;
+
+    m_visited.clear();
+    for (auto& entry : entry_points) {
+        if (!m_visited.insert(entry.second).second)
+            continue;
+        candidates.push(entry);
+        if (accept(entry.second)) {
+            found.push(entry);
+            if (found.size() > ef)
+                found.pop();
+        }
+    }
+
+    while (!candidates.empty()) {
+        Candidate current = candidates.top();
+        if (found.size() >= ef && current.first > found.top().first)
+            break;
+        candidates.pop();
+
+        load_links(current.second, m_link_buffer);
+        size_t pos = level_offset(m_link_buffer, level);
+        size_t end = pos + 1 + m_link_buffer[pos];
+        for (++pos; pos < end; ++pos) {
+            uint32_t neighbour = m_link_buffer[pos];
+            if (!m_visited.insert(neighbour).second)
+                continue;
+            float d = distance(vector, neighbour);
+            if (found.size() < ef || d < found.top().first) {
+                candidates.emplace(d, neighbour);
+                if (accept(neighbour)) {
+                    found.emplace(d, neighbour);
+                    if (found.size() > ef)
+                        found.pop();
+                }
+            }
+        }
+    }
+
+    std::vector<Candidate> result(found.size());
+    for (size_t i = result.size(); i > 0; --i) {
+        result[i - 1] = found.top();
+        found.pop();
+    }
+    return result;
+}
+
+// Walk greedily from the entry point down to 'to_level' and return the closest node found
+auto VectorIndex::Graph::descend(const float* vector, int to_level) -> std::vector<Candidate>
+{
+    uint32_t entry_point = uint32_t(get_tagged(s_entry_point_ndx) - 1);
+    std::vector<Candidate> entry_points{{distance(vector, entry_point), entry_point}};
+    for (int level = int(get_tagged(s_top_level_ndx)); level > to_level; --level) {
+        entry_points = search_level(vector, entry_points, 1, level, [](uint32_t) {
+            return true;
+        });
+    }
+    return entry_points;
+}
+
+// Choose the neighbours of a node among the candidates, closest first. A candidate is skipped if it is closer to
+// a neighbour already chosen than to the node, which keeps links to all directions around the node.
+std::vector<uint32_t> VectorIndex::Graph::select_neighbours(const std::vector<Candidate>& candidates,
+                                                            size_t max_links)
+{
+    std::vector<uint32_t> selected;
+    if (candidates.size() <= max_links) {
+        for (auto& c : candidates)
+            selected.push_back(c.second);
+        return selected;
+    }
+
+    std::vector<float> selected_vectors;
+    std::vector<float> vector(m_dimensions);
+    for (auto& c : candidates) {
+        if (selected.size() == max_links)
+            break;
+        load_vector(c.second, vector.data());
+        bool keep = true;
+        for (size_t i = 0; i < selected.size() && keep; ++i) {
+            keep = vector_distance(m_metric, vector.data(), selected_vectors.data() + i * m_dimensions,
+                                   m_dimensions) >= c.first;
+        }
+        if (keep) {
+            selected.push_back(c.second);
+            selected_vectors.insert(selected_vectors.end(), vector.begin(), vector.end());
+        }
+    }
+    return selected;
+}
+
+void VectorIndex::Graph::add_link(uint32_t from, uint32_t to, int level)
+{
+    std::vector<uint32_t> links;
+    load_links(from, links);
+    size_t pos = level_offset(links, level);
+    size_t num_links = links[pos];
+    size_t max_links = level == 0 ? s_max_links_level0 : s_max_links;
+    if (num_links < max_links) {
+        links.insert(links.begin() + pos + 1 + num_links, to);
+        ++links[pos];
+        store_links(from, links);
+        return;
+    }
+
+    // Too many links, so choose among the existing neighbours and the new one
+    std::vector<float> vector(m_dimensions);
+    load_vector(from, vector.data());
+    std::vector<Candidate> candidates;
+    for (size_t i = 0; i < num_links; ++i) {
+        uint32_t neighbour = links[pos + 1 + i];
+        candidates.emplace_back(distance(vector.data(), neighbour), neighbour);
+    }
+    candidates.emplace_back(distance(vector.data(), to), to);
+    std::sort(candidates.begin(), candidates.end());
+    auto selected = select_neighbours(candidates, max_links);
+
+    links.erase(links.begin() + pos + 1, links.begin() + pos + 1 + num_links);
+    links.insert(links.begin() + pos + 1, selected.begin(), selected.end());
+    links[pos] = uint32_t(selected.size());
+    store_links(from, links);
+}
+
+void VectorIndex::Graph::insert(ObjKey key, const std::vector<float>& vector)
+{
+    REALM_ASSERT(vector.size() == m_dimensions);
+    uint32_t node = uint32_t(num_nodes());
+    int level = random_level(key);
+
+    m_keys.add(key.value);
+    m_vectors.add(BinaryData(reinterpret_cast<const char*>(vector.data()), vector.size() * sizeof(float)));
+    std::vector<uint32_t> links(level + 2, 0);
+    links[0] = uint32_t(level + 1);
+    m_links.add(BinaryData(reinterpret_cast<const char*>(links.data()), links.size() * sizeof(uint32_t)));
+    size_t pos = find_key(key);
+    REALM_ASSERT(pos == m_sorted_keys.size() || m_sorted_keys.get(pos) != key.value);
+    m_sorted_keys.insert(pos, key.value);
+    m_sorted_nodes.insert(pos, node);
+
+    if (get_tagged(s_entry_point_ndx) == 0) {
+        set_tagged(s_entry_point_ndx, node + 1);
+        set_tagged(s_top_level_ndx, size_t(level));
+        return;
+    }
+
+    int top_level = int(get_tagged(s_top_level_ndx));
+    auto entry_points = descend(vector.data(), level);
+    for (int l = std::min(level, top_level); l >= 0; --l) {
+        // The new node is reachable once it has been linked to on the levels above
+        auto found = search_level(vector.data(), entry_points, s_ef_construction, l, [node](uint32_t n) {
+            return n != node;
+        });
+        auto neighbours = select_neighbours(found, s_max_links);
+        size_t offset = level_offset(links, l);
+        links[offset] = uint32_t(neighbours.size());
+        links.insert(links.begin() + offset + 1, neighbours.begin(), neighbours.end());
+        for (auto neighbour : neighbours)
+            add_link(neighbour, node, l);
+        entry_points = std::move(found);
+    }
+    store_links(node, links);
+
+    if (level > top_level) {
+        set_tagged(s_entry_point_ndx, node + 1);
+        set_tagged(s_top_level_ndx, size_t(level));
+    }
+}
+
+bool VectorIndex::Graph::erase(ObjKey key)
+{
+    size_t pos = find_key(key);
+    if (pos == m_sorted_keys.size() || m_sorted_keys.get(pos) != key.value)
+        return false;
+
+    // The node stays in the graph to keep its neighbours connected
+    auto node = size_t(m_sorted_nodes.get(pos));
+    m_sorted_keys.erase(pos);
+    m_sorted_nodes.erase(pos);
+    m_keys.set(node, -1);
+    set_tagged(s_erased_ndx, get_erased() + 1);
+    return true;
+}
+
+void VectorIndex::Graph::search(const float* vector, size_t k, size_t ef, util::FunctionRef<bool(ObjKey)> filter,
+                                std::vector<std::pair<ObjKey, float>>& result)
+{
+    if (get_tagged(s_entry_point_ndx) == 0)
+        return;
+
+    auto entry_points = descend(vector, 0);
+    auto found = search_level(vector, entry_points, std::max(k, ef), 0, [&](uint32_t node) {
+        ObjKey key = get_key(node);
+        return key && filter(key);
+    });
+    for (size_t i = 0; i < found.size() && i < k; ++i)
+        result.emplace_back(get_key(found[i].second), found[i].first);
+}
+
+void VectorIndex::Graph::verify() const
+{
+#ifdef REALM_DEBUG
+    size_t n = num_nodes();
+    REALM_ASSERT(m_vectors.size() == n);
+    REALM_ASSERT(m_links.size() == n);
+    REALM_ASSERT(m_sorted_keys.size() == m_sorted_nodes.size());
+    REALM_ASSERT(m_sorted_keys.size() + get_erased() == n);
+    REALM_ASSERT((n == 0) == (get_tagged(s_entry_point_ndx) == 0));
+
+    for (size_t i = 0; i < m_sorted_keys.size(); ++i) {
+        REALM_ASSERT(i == 0 || m_sorted_keys.get(i - 1) < m_sorted_keys.get(i));
+        REALM_ASSERT(m_keys.get(size_t(m_sorted_nodes.get(i))) == m_sorted_keys.get(i));
+    }
+    std::vector<uint32_t> links;
+    for (size_t node = 0; node < n; ++node) {
+        REALM_ASSERT(m_vectors.get(node).size() == m_dimensions * sizeof(float));
+        load_links(uint32_t(node), links);
+        REALM_ASSERT(links.size() > 1);
+        REALM_ASSERT(links[0] <= size_t(s_max_level) + 1);
+        REALM_ASSERT(int(links[0]) <= int(get_tagged(s_top_level_ndx)) + 1);
+        size_t pos = 1;
+        for (uint32_t level = 0; level < links[0]; ++level) {
+            REALM_ASSERT(pos < links.size());
+            size_t num_links = links[pos];
+            REALM_ASSERT(num_links <= (level == 0 ? s_max_links_level0 : s_max_links));
+            REALM_ASSERT(pos + 1 + num_links <= links.size());
+            for (size_t i = 0; i < num_links; ++i) {
+                REALM_ASSERT(links[pos + 1 + i] < n);
+                REALM_ASSERT(links[pos + 1 + i] != node);
+            }
+            pos += 1 + num_links;
+        }
+        REALM_ASSERT(pos == links.size());
+    }
+#endif
+}
+
+#ifdef REALM_DEBUG
+void VectorIndex::Graph::print() const
+{
+    std::cout << "Vector index: " << num_vectors() << " vectors of dimension " << m_dimensions << ", "
+              << get_erased() << " erased, top level " << get_tagged(s_top_level_ndx) << std::endl;
+    std::vector<uint32_t> links;
+    for (size_t node = 0; node < num_nodes(); ++node) {
+        std::cout << "  " << node << " (" << m_keys.get(node) << "):";
+        load_links(uint32_t(node), links);
+        size_t pos = 1;
+        for (uint32_t level = 0; level < links[0]; ++level) {
+            std::cout << " [";
+            for (size_t i = 0; i < links[pos]; ++i)
+                std::cout << (i ? " " : "") << links[pos + 1 + i];
+            std::cout << "]";
+            pos += 1 + links[pos];
+        }
+        std::cout << std::endl;
+    }
+}
+#endif
+
+VectorIndex::VectorIndex(const ClusterColumn& target_column, Allocator& alloc, VectorMetric metric)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.create(Array::type_HasRefs); // Throws
+    create_graph(0, metric);
+}
+
+VectorIndex::VectorIndex(ref_type ref, ArrayParent* parent, size_t ndx_in_parent, const ClusterColumn& target_column,
+                         Allocator& alloc)
+    : SearchIndex(target_column, &m_top)
+    , m_top(alloc)
+{
+    m_top.init_from_ref(ref);
+    set_parent(parent, ndx_in_parent);
+}
+
+VectorIndex::~VectorIndex() noexcept {}
+
+void VectorIndex::create_graph(size_t dimensions, VectorMetric metric)
+{
+    m_top.truncate_and_destroy_children(0);
+    m_top.add(RefOrTagged::make_tagged(dimensions));
+    m_top.add(RefOrTagged::make_tagged(size_t(metric)));
+    m_top.add(RefOrTagged::make_tagged(0));
+    m_top.add(RefOrTagged::make_tagged(0));
+    m_top.add(RefOrTagged::make_tagged(0));
+
+    Allocator& alloc = m_top.get_alloc();
+    IntegerColumn keys(alloc);
+    keys.create();
+    m_top.add(RefOrTagged::make_ref(keys.get_ref()));
+    BPlusTree<BinaryData> vectors(alloc);
+    vectors.create();
+    m_top.add(RefOrTagged::make_ref(vectors.get_ref()));
+    BPlusTree<BinaryData> links(alloc);
+    links.create();
+    m_top.add(RefOrTagged::make_ref(links.get_ref()));
+    IntegerColumn sorted_keys(alloc);
+    sorted_keys.create();
+    m_top.add(RefOrTagged::make_ref(sorted_keys.get_ref()));
+    IntegerColumn sorted_nodes(alloc);
+    sorted_nodes.create();
+    m_top.add(RefOrTagged::make_ref(sorted_nodes.get_ref()));
+    REALM_ASSERT(m_top.size() == s_top_size);
+}
+
+VectorMetric VectorIndex::get_metric() const noexcept
+{
+    return VectorMetric(m_top.get_as_ref_or_tagged(s_metric_ndx).get_as_int());
+}
+
+size_t VectorIndex::get_dimensions() const noexcept
+{
+    return size_t(m_top.get_as_ref_or_tagged(s_dimensions_ndx).get_as_int());
+}
+
+size_t VectorIndex::num_vectors() const
+{
+    IntegerColumn sorted_keys(m_top.get_alloc(), m_top.get_as_ref(s_sorted_keys_ndx));
+    return sorted_keys.size();
+}
+
+bool VectorIndex::is_empty() const
+{
+    return num_vectors() == 0;
+}
+
+bool VectorIndex::get_vector(const Mixed& value, std::vector<float>& vector) const
+{
+    if (value.is_null())
+        return false;
+    BinaryData data = value.get_binary();
+    if (data.size() == 0)
+        return false;
+    size_t dimensions = get_dimensions();
+    if (data.size() % sizeof(float) != 0) {
+        throw InvalidArgument(util::format("Binary value of %1 bytes is not a vector of floats", data.size()));
+    }
+    if (dimensions && data.size() != dimensions * sizeof(float)) {
+        throw InvalidArgument(util::format("Vector of %1 floats stored in a column indexed for vectors of %2 floats",
+                                           data.size() / sizeof(float), dimensions));
+    }
+    vector.resize(data.size() / sizeof(float));
+    std::memcpy(vector.data(), data.data(), data.size());
+    return true;
+}
+
+void VectorIndex::insert(ObjKey key, const Mixed& value)
+{
+    std::vector<float> vector;
+    if (!get_vector(value, vector))
+        return;
+    if (get_dimensions() == 0)
+        m_top.set(s_dimensions_ndx, RefOrTagged::make_tagged(vector.size()));
+    Graph(*this).insert(key, vector);
+}
+
+void VectorIndex::set(ObjKey key, const Mixed& value)
+{
+    // Check the new value before the old one is removed
+    std::vector<float> vector;
+    bool has_vector = get_vector(value, vector);
+    erase(key);
+    if (has_vector) {
+        if (get_dimensions() == 0)
+            m_top.set(s_dimensions_ndx, RefOrTagged::make_tagged(vector.size()));
+        Graph(*this).insert(key, vector);
+    }
+}
+
+void VectorIndex::erase(ObjKey key)
+{
+    Graph graph(*this);
+    if (!graph.erase(key))
+        return;
+    if (graph.num_vectors() == 0) {
+        create_graph(get_dimensions(), get_metric());
+    }
+    else if (graph.get_erased() > graph.num_vectors()) {
+        rebuild();
+    }
+}
+
+void VectorIndex::rebuild()
+{
+    std::vector<ObjKey> keys;
+    std::vector<float> vectors;
+    size_t dimensions = get_dimensions();
+    {
+        Graph graph(*this);
+        for (uint32_t node = 0; node < graph.num_nodes(); ++node) {
+            if (ObjKey key = graph.get_key(node)) {
+                keys.push_back(key);
+                vectors.resize(keys.size() * dimensions);
+                graph.load_vector(node, vectors.data() + (keys.size() - 1) * dimensions);
+            }
+        }
+    }
+    create_graph(dimensions, get_metric());
+    Graph graph(*this);
+    std::vector<float> vector(dimensions);
+    for (size_t i = 0; i < keys.size(); ++i) {
+        std::copy_n(vectors.begin() + i * dimensions, dimensions, vector.begin());
+        graph.insert(keys[i], vector);
+    }
+}
+
+void VectorIndex::clear()
+{
+    create_graph(get_dimensions(), get_metric());
+}
+
+void VectorIndex::insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                              ArrayPayload& values)
+{
+    for (size_t i = 0; i < num_values; ++i) {
+        ObjKey key(keys ? keys->get(i) + key_offset : i + key_offset);
+        insert(key, values.get_any(i));
+    }
+}
+
+void VectorIndex::search(const std::vector<float>& vector, size_t k, size_t ef,
+                         util::FunctionRef<bool(ObjKey)> filter, std::vector<std::pair<ObjKey, float>>& result) const
+{
+    result.clear();
+    Graph graph(*this);
+    if (k == 0 || graph.num_vectors() == 0)
+        return;
+    if (vector.size() != graph.dimensions()) {
+        throw InvalidArgument(util::format("Query vector has %1 floats, but the indexed vectors have %2",
+                                           vector.size(), graph.dimensions()));
+    }
+    graph.search(vector.data(), k, ef, filter, result);
+}
+
+void VectorIndex::verify() const
+{
+    Graph(*this).verify();
+}
+
+#ifdef REALM_DEBUG
+void VectorIndex::print() const
+{
+    Graph(*this).print();
+}
+#endif
+
+ObjKey VectorIndex::find_first(const Mixed&) const
+{
+    REALM_UNREACHABLE();
+}
+
+void VectorIndex::find_all(std::vector<ObjKey>&, Mixed, bool) const
+{
+    REALM_UNREACHABLE();
+}
+
+FindRes VectorIndex::find_all_no_copy(Mixed, InternalFindResult&) const
+{
+    REALM_UNREACHABLE();
+}
+
+size_t VectorIndex::count(const Mixed&) const
+{
+    REALM_UNREACHABLE();
+}
+
+bool VectorIndex::has_duplicate_values() const noexcept
+{
+    REALM_UNREACHABLE();
+}
+
+void VectorIndex::insert_bulk_list(const ArrayUnsigned*, uint64_t, size_t, ArrayInteger&)
+{
+    REALM_UNREACHABLE();
+}
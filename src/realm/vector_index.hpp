@@ -0,0 +1,117 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#ifndef REALM_VECTOR_INDEX_HPP
+#define REALM_VECTOR_INDEX_HPP
+
+#include <realm/array.hpp>
+#include <realm/search_index.hpp>
+#include <realm/util/function_ref.hpp>
+
+#include <utility>
+#include <vector>
+
+/*
+The VectorIndex class indexes a binary column holding vectors of 32-bit floats in native byte order for
+approximate nearest neighbour searches. All vectors of the column must have the same number of floats, which is
+fixed by the first vector inserted. Null and empty values are not indexed.
+
+The index is a hierarchical navigable small world graph (HNSW). Every vector is a node of the graph and is assigned
+a random level, with exponentially fewer nodes on each higher level. On every level up to its own, a node is linked
+to a few of its nearest nodes on that level. A search starts at the entry point on the top level, walks greedily
+towards the query vector on each level, and does a best-first search with a list of candidates at level 0.
+
+The graph is stored in Realm arrays, so it is persisted and copy-on-write like the rest of the file, and searches
+in a read transaction don't modify anything. The top array holds:
+
+    0: dimensions (tagged), 0 when no vector has been inserted yet
+    1: metric (tagged)
+    2: entry point node + 1 (tagged), 0 when the graph is empty
+    3: top level (tagged)
+    4: number of erased nodes (tagged)
+    5: the object key of each node, -1 for erased nodes
+    6: the vector of each node, as a binary value
+    7: the links of each node, as a binary value holding 32-bit integers: the number of levels, then for each level
+       the number of links followed by the linked nodes
+    8: the object keys of the nodes which are not erased, in ascending order
+    9: the node of each key in 8
+
+Erasing an object only marks its node as erased, as the node still connects the graph. When the erased nodes
+outnumber the others, the graph is rebuilt from the remaining vectors.
+*/
+
+namespace realm {
+
+// Distance between the vectors 'a' and 'b' of 'size' floats, see VectorMetric
+float vector_distance(VectorMetric metric, const float* a, const float* b, size_t size) noexcept;
+
+class VectorIndex : public SearchIndex {
+public:
+    // Length of the candidate list at level 0 used by searches if not given
+    static constexpr size_t default_ef = 64;
+
+    VectorIndex(const ClusterColumn& target_column, Allocator&, VectorMetric metric);
+    VectorIndex(ref_type, ArrayParent*, size_t ndx_in_parent, const ClusterColumn& target_column, Allocator&);
+    ~VectorIndex() noexcept;
+
+    VectorMetric get_metric() const noexcept;
+    // Number of floats in each vector, 0 until the first vector is inserted
+    size_t get_dimensions() const noexcept;
+    // Number of objects with an indexed vector
+    size_t num_vectors() const;
+
+    // Find up to 'k' of the objects accepted by 'filter' whose vectors are closest to 'vector', nearest first.
+    // 'ef' is the number of candidates kept at level 0; a larger value gives better recall at the cost of speed.
+    void search(const std::vector<float>& vector, size_t k, size_t ef, util::FunctionRef<bool(ObjKey)> filter,
+                std::vector<std::pair<ObjKey, float>>& result) const;
+
+    // Search Index API:
+    void insert(ObjKey key, const Mixed& value) final;
+    void set(ObjKey key, const Mixed& value) final;
+    void erase(ObjKey key) final;
+    void clear() final;
+    bool is_empty() const final;
+    void insert_bulk(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values, ArrayPayload& values) final;
+    void verify() const final;
+
+    // Vector indexes are not used for lookups by value
+    ObjKey find_first(const Mixed&) const final;
+    void find_all(std::vector<ObjKey>& result, Mixed value, bool case_insensitive = false) const final;
+    FindRes find_all_no_copy(Mixed value, InternalFindResult& result) const final;
+    size_t count(const Mixed&) const final;
+    bool has_duplicate_values() const noexcept final;
+    void insert_bulk_list(const ArrayUnsigned* keys, uint64_t key_offset, size_t num_values,
+                          ArrayInteger& ref_array) final;
+
+#ifdef REALM_DEBUG
+    void print() const final;
+#endif // REALM_DEBUG
+
+private:
+    class Graph;
+
+    Array m_top;
+
+    void create_graph(size_t dimensions, VectorMetric metric);
+    void rebuild();
+    bool get_vector(const Mixed& value, std::vector<float>& vector) const;
+};
+
+} // namespace realm
+
+#endif // REALM_VECTOR_INDEX_HPP
@@ -22,6 +22,7 @@
 #include <set>
 #include <sstream>
 #include <set>
+#include <thread>
 
 #include <realm.hpp>
 #if REALM_ENABLE_GEOSPATIAL
@@ -40,6 +41,12 @@
 #include "../util/crypt_key.hpp"
 #endif
 
+#ifndef _WIN32
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
 using namespace realm;
 using namespace realm::util;
 using namespace realm::test_util;
@@ -106,6 +113,7 @@ struct Benchmark {
     virtual void operator()(DBRef) = 0;
     DBOptions::Durability m_durability = DBOptions::Durability::Full;
     const char* m_encryption_key = nullptr;
+    DBOptions::CommitWriteMode m_commit_write_mode = DBOptions::CommitWriteMode::MemoryMap;
     std::vector<ObjKey> m_keys;
     ColKey m_col;
     std::unique_ptr<WriteTransaction> m_tr;
@@ -1647,6 +1655,120 @@ struct BenchmarkEmptyCommit : Benchmark {
     }
 };
 
+// Commit of N new objects, written to the file as selected by the write mode
+template <DBOptions::CommitWriteMode Mode, size_t N>
+struct BenchmarkCommitObjects : Benchmark {
+    BenchmarkCommitObjects()
+    {
+        m_commit_write_mode = Mode;
+        m_name = util::format("Commit%1Objects%2", N,
+                              Mode == DBOptions::CommitWriteMode::MemoryMap ? "MemoryMap" : "BatchedWrite");
+    }
+    const char* name() const
+    {
+        return m_name.c_str();
+    }
+    void before_all(DBRef group)
+    {
+        WriteTransaction tr(group);
+        TableRef t = tr.add_table(name());
+        m_col = t->add_column(type_Int, "i");
+        m_col_str = t->add_column(type_String, "s");
+        tr.commit();
+    }
+    void before_each(DBRef) {}
+    void after_each(DBRef) {}
+    void operator()(DBRef group)
+    {
+        WriteTransaction tr(group);
+        TableRef t = tr.get_table(name());
+        for (size_t i = 0; i < N; ++i) {
+            t->create_object().set(m_col, int64_t(i)).set(m_col_str, "some string value");
+        }
+        tr.commit();
+    }
+    std::string m_name;
+    ColKey m_col_str;
+};
+using BenchmarkSmallCommitMemoryMap = BenchmarkCommitObjects<DBOptions::CommitWriteMode::MemoryMap, 10>;
+using BenchmarkSmallCommitBatchedWrite = BenchmarkCommitObjects<DBOptions::CommitWriteMode::BatchedWrite, 10>;
+using BenchmarkLargeCommitMemoryMap = BenchmarkCommitObjects<DBOptions::CommitWriteMode::MemoryMap, 100000>;
+using BenchmarkLargeCommitBatchedWrite = BenchmarkCommitObjects<DBOptions::CommitWriteMode::BatchedWrite, 100000>;
+
+#ifndef _WIN32
+// Latency from the start of a commit until all of N other processes waiting in
+// DB::wait_for_change() have woken up
+template <int N>
+struct BenchmarkCommitNotification : Benchmark {
+    struct Shared {
+        std::atomic<uint64_t> num_ready;
+        std::atomic<uint64_t> num_woken;
+        std::atomic<bool> stop;
+    };
+
+    std::string m_name = "CommitNotification" + std::to_string(N) + "Processes";
+    Shared* m_shared = nullptr;
+    std::vector<pid_t> m_children;
+
+    const char* name() const
+    {
+        return m_name.c_str();
+    }
+
+    void before_all(DBRef db)
+    {
+        void* addr = ::mmap(nullptr, sizeof(Shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        REALM_ASSERT_RELEASE(addr != MAP_FAILED);
+        m_shared = new (addr) Shared{0, 0, false};
+
+        for (int i = 0; i < N; ++i) {
+            pid_t pid = fork();
+            REALM_ASSERT_RELEASE(pid != -1);
+            if (pid == 0) {
+                {
+                    DBRef child_db = DB::create(db->get_path(), DBOptions(m_durability, m_encryption_key));
+                    auto tr = child_db->start_read();
+                    ++m_shared->num_ready;
+                    while (!m_shared->stop) {
+                        if (child_db->wait_for_change(tr)) {
+                            tr = child_db->start_read();
+                            ++m_shared->num_woken;
+                        }
+                    }
+                }
+                _exit(0);
+            }
+            m_children.push_back(pid);
+        }
+        while (m_shared->num_ready < N)
+            std::this_thread::yield();
+    }
+    void after_all(DBRef db)
+    {
+        m_shared->stop = true;
+        WriteTransaction tr(db);
+        tr.commit();
+        for (pid_t pid : m_children)
+            waitpid(pid, nullptr, 0);
+        m_children.clear();
+        ::munmap(m_shared, sizeof(Shared));
+        m_shared = nullptr;
+    }
+    void before_each(DBRef) {}
+    void after_each(DBRef) {}
+    void operator()(DBRef db)
+    {
+        uint64_t expected = m_shared->num_woken + N;
+        {
+            WriteTransaction tr(db);
+            tr.commit();
+        }
+        while (m_shared->num_woken < expected)
+            std::this_thread::yield();
+    }
+};
+#endif
+
 struct BenchmarkSortInt : BenchmarkWithInts {
     const char* name() const
     {
@@ -2600,7 +2722,9 @@ void run_benchmark(BenchmarkResults& results, bool force_full = false)
         realm::test_util::DBTestPathGuard realm_path(
             test_util::get_test_path("benchmark_common_tasks_" + ident, ".realm"));
         DBRef group;
-        group = DB::create(realm_path, DBOptions(level, key));
+        DBOptions options(level, key);
+        options.commit_write_mode = benchmark.m_commit_write_mode;
+        group = DB::create(realm_path, options);
         benchmark.before_all(group);
 
         // Warm-up and initial measuring:
@@ -2652,6 +2776,15 @@ int benchmark_common_tasks_main()
 #define BENCH2(B, mode) run_benchmark<B>(results, mode)
     BENCH2(BenchmarkEmptyCommit, true);
     BENCH2(BenchmarkEmptyCommit, false);
+    BENCH2(BenchmarkSmallCommitMemoryMap, true);
+    BENCH2(BenchmarkSmallCommitBatchedWrite, true);
+    BENCH2(BenchmarkLargeCommitMemoryMap, true);
+    BENCH2(BenchmarkLargeCommitBatchedWrite, true);
+#ifndef _WIN32
+    BENCH(BenchmarkCommitNotification<1>);
+    BENCH(BenchmarkCommitNotification<10>);
+    BENCH(BenchmarkCommitNotification<100>);
+#endif
     BENCH2(BenchmarkNonInitiatorOpen, true);
     BENCH2(BenchmarkInitiatorOpen, true);
     BENCH2(AddTable, true);
@@ -0,0 +1,655 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+// Mixed workload benchmark modelled on the YCSB core workloads A-F. A number
+// of reader and writer threads run a mix of point reads, range queries,
+// updates, inserts and read-modify-writes against a "usertable" for a fixed
+// duration, while a notifier thread waits for changes like the object store
+// notifier does. Throughput, latency percentiles and file growth are written
+// as JSON, and the percentiles are submitted to BenchmarkResults so that they
+// are compared against the baseline of an earlier run.
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <realm.hpp>
+#include <realm/disable_sync_to_disk.hpp>
+#include <realm/utilities.hpp>
+#include <realm/util/file.hpp>
+#include <external/json/json.hpp>
+
+#include "../util/benchmark_results.hpp"
+#include "../util/test_path.hpp"
+
+using namespace realm;
+using namespace realm::util;
+using namespace realm::test_util;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+    std::string workloads = "ABCDEF";
+    double duration = 10;
+    size_t readers = 2;
+    size_t writers = 1;
+    size_t records = 100000;
+    size_t fields = 10;
+    size_t field_length = 100;
+    size_t max_scan_length = 100;
+    bool notifier = true;
+};
+
+enum class Distribution { Uniform, Zipfian, Latest };
+
+struct Workload {
+    char name;
+    const char* description;
+    // Proportions of the operations, summing to 1
+    double read;
+    double update;
+    double insert;
+    double scan;
+    double read_modify_write;
+    Distribution distribution;
+};
+
+const std::array<Workload, 6> g_workloads = {{
+    {'A', "Update heavy", 0.5, 0.5, 0, 0, 0, Distribution::Zipfian},
+    {'B', "Read mostly", 0.95, 0.05, 0, 0, 0, Distribution::Zipfian},
+    {'C', "Read only", 1, 0, 0, 0, 0, Distribution::Zipfian},
+    {'D', "Read latest", 0.95, 0, 0.05, 0, 0, Distribution::Latest},
+    {'E', "Short ranges", 0, 0, 0.05, 0.95, 0, Distribution::Zipfian},
+    {'F', "Read-modify-write", 0.5, 0, 0, 0, 0.5, Distribution::Zipfian},
+}};
+
+enum Operation { op_Read, op_Update, op_Insert, op_Scan, op_ReadModifyWrite, op_Notify, num_operations };
+const char* const g_operation_names[num_operations] = {"read", "update", "insert", "scan", "rmw", "notify"};
+
+// Histogram of latencies in nanoseconds. Each power of two is divided into
+// 64 buckets, so percentiles are accurate to within 1/64 of the value.
+class LatencyHistogram {
+public:
+    void record(uint64_t ns) noexcept
+    {
+        ++m_counts[bucket_of(ns)];
+        ++m_count;
+        m_max = std::max(m_max, ns);
+    }
+
+    void merge(const LatencyHistogram& other) noexcept
+    {
+        for (size_t i = 0; i < m_counts.size(); ++i)
+            m_counts[i] += other.m_counts[i];
+        m_count += other.m_count;
+        m_max = std::max(m_max, other.m_max);
+    }
+
+    uint64_t count() const noexcept
+    {
+        return m_count;
+    }
+
+    uint64_t max() const noexcept
+    {
+        return m_max;
+    }
+
+    uint64_t percentile(double p) const noexcept
+    {
+        if (m_count == 0)
+            return 0;
+        uint64_t rank = uint64_t(std::ceil(p / 100 * double(m_count)));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < m_counts.size(); ++i) {
+            seen += m_counts[i];
+            if (seen >= rank)
+                return std::min(upper_bound_of(i), m_max);
+        }
+        return m_max;
+    }
+
+private:
+    static constexpr int sub_bucket_bits = 6;
+    static constexpr uint64_t sub_buckets = uint64_t(1) << sub_bucket_bits;
+
+    std::array<uint64_t, 64 * sub_buckets> m_counts = {};
+    uint64_t m_count = 0;
+    uint64_t m_max = 0;
+
+    static size_t bucket_of(uint64_t value) noexcept
+    {
+        if (value < sub_buckets)
+            return size_t(value);
+        int shift = log2(size_t(value)) - sub_bucket_bits;
+        return size_t((shift + 1) * sub_buckets + ((value >> shift) - sub_buckets));
+    }
+
+    static uint64_t upper_bound_of(size_t bucket) noexcept
+    {
+        if (bucket < sub_buckets)
+            return bucket;
+        int shift = int(bucket / sub_buckets) - 1;
+        uint64_t sub = bucket % sub_buckets;
+        return ((sub_buckets + sub + 1) << shift) - 1;
+    }
+};
+
+// The zipfian generator from YCSB (Gray et al, "Quickly Generating
+// Billion-Record Synthetic Databases"). Item 0 is the most popular one.
+class ZipfianGenerator {
+public:
+    explicit ZipfianGenerator(uint64_t items, double theta = 0.99)
+        : m_items(items)
+        , m_theta(theta)
+    {
+        double zeta2 = zeta(2);
+        m_zetan = zeta(items);
+        m_alpha = 1 / (1 - theta);
+        m_eta = (1 - std::pow(2.0 / double(items), 1 - theta)) / (1 - zeta2 / m_zetan);
+    }
+
+    uint64_t next(std::mt19937_64& random)
+    {
+        double u = std::uniform_real_distribution<double>(0, 1)(random);
+        double uz = u * m_zetan;
+        if (uz < 1)
+            return 0;
+        if (uz < 1 + std::pow(0.5, m_theta))
+            return 1;
+        return std::min(m_items - 1, uint64_t(double(m_items) * std::pow(m_eta * u - m_eta + 1, m_alpha)));
+    }
+
+private:
+    uint64_t m_items;
+    double m_theta;
+    double m_zetan;
+    double m_alpha;
+    double m_eta;
+
+    double zeta(uint64_t n) const
+    {
+        double sum = 0;
+        for (uint64_t i = 1; i <= n; ++i)
+            sum += 1 / std::pow(double(i), m_theta);
+        return sum;
+    }
+};
+
+// Spread the popular items over the key space, like YCSB's ScrambledZipfianGenerator
+uint64_t scramble(uint64_t value, uint64_t items)
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (i * 8)) & 0xff;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash % items;
+}
+
+struct Shared {
+    const Config& config;
+    const Workload& workload;
+    DBRef db;
+    TableKey table_key;
+    ColKey col_id;
+    std::vector<ColKey> col_fields;
+    ZipfianGenerator zipfian;
+    // Number of keys inserted and committed, all keys below are present
+    std::atomic<int64_t> committed_keys;
+    std::atomic<int64_t> next_key;
+    std::atomic<int64_t> last_commit_ns{0};
+    std::atomic<bool> stop{false};
+
+    Shared(const Config& c, const Workload& w, DBRef d)
+        : config(c)
+        , workload(w)
+        , db(std::move(d))
+        , zipfian(c.records)
+        , committed_keys(int64_t(c.records))
+        , next_key(int64_t(c.records))
+    {
+    }
+};
+
+struct ThreadResult {
+    std::array<LatencyHistogram, num_operations> latencies;
+};
+
+int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+std::string random_string(std::mt19937_64& random, size_t length)
+{
+    std::string str(length, ' ');
+    for (auto& c : str)
+        c = char('a' + random() % 26);
+    return str;
+}
+
+class Client {
+public:
+    Client(Shared& shared, bool writer, uint64_t seed)
+        : m_shared(shared)
+        , m_writer(writer)
+        , m_random(seed)
+    {
+        const Workload& w = m_shared.workload;
+        // Readers run the read-only part of the mix
+        std::array<double, op_Notify> weights = {w.read, w.update, w.insert, w.scan, w.read_modify_write};
+        if (!writer)
+            weights[op_Update] = weights[op_Insert] = weights[op_ReadModifyWrite] = 0;
+        m_operations = std::discrete_distribution<int>(weights.begin(), weights.end());
+        m_tr = m_shared.db->start_read();
+    }
+
+    void run(ThreadResult& result)
+    {
+        while (!m_shared.stop.load(std::memory_order_relaxed)) {
+            auto op = Operation(m_operations(m_random));
+            auto begin = Clock::now();
+            switch (op) {
+                case op_Read:
+                    read();
+                    break;
+                case op_Update:
+                    update();
+                    break;
+                case op_Insert:
+                    insert();
+                    break;
+                case op_Scan:
+                    scan();
+                    break;
+                case op_ReadModifyWrite:
+                    read_modify_write();
+                    break;
+                default:
+                    REALM_UNREACHABLE();
+            }
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - begin);
+            result.latencies[op].record(uint64_t(elapsed.count()));
+        }
+    }
+
+private:
+    Shared& m_shared;
+    bool m_writer;
+    std::mt19937_64 m_random;
+    std::discrete_distribution<int> m_operations;
+    TransactionRef m_tr;
+    volatile size_t m_sink = 0;
+
+    int64_t choose_key()
+    {
+        int64_t committed = m_shared.committed_keys.load(std::memory_order_acquire);
+        switch (m_shared.workload.distribution) {
+            case Distribution::Uniform:
+                return int64_t(m_random() % uint64_t(committed));
+            case Distribution::Zipfian:
+                return int64_t(scramble(m_shared.zipfian.next(m_random), uint64_t(committed)));
+            case Distribution::Latest:
+                return std::max<int64_t>(0, committed - 1 - int64_t(m_shared.zipfian.next(m_random)));
+        }
+        REALM_UNREACHABLE();
+    }
+
+    Obj find(Transaction& tr, int64_t key)
+    {
+        auto table = tr.get_table(m_shared.table_key);
+        if (ObjKey obj_key = table->find_primary_key(key))
+            return table->get_object(obj_key);
+        return {};
+    }
+
+    void read_fields(const Obj& obj)
+    {
+        for (auto col : m_shared.col_fields)
+            m_sink = m_sink + obj.get<StringData>(col).size();
+    }
+
+    void read()
+    {
+        int64_t key = choose_key();
+        m_tr->advance_read();
+        if (Obj obj = find(*m_tr, key))
+            read_fields(obj);
+    }
+
+    void scan()
+    {
+        int64_t start = choose_key();
+        auto length = int64_t(1 + m_random() % m_shared.config.max_scan_length);
+        m_tr->advance_read();
+        auto table = m_tr->get_table(m_shared.table_key);
+        auto tv = table->where().between(m_shared.col_id, start, start + length - 1).find_all();
+        for (size_t i = 0; i < tv.size(); ++i)
+            m_sink = m_sink + tv[i].get<StringData>(m_shared.col_fields[0]).size();
+    }
+
+    void commit(Transaction& tr)
+    {
+        tr.commit_and_continue_as_read();
+        m_shared.last_commit_ns.store(now_ns(), std::memory_order_release);
+    }
+
+    void update()
+    {
+        int64_t key = choose_key();
+        m_tr->promote_to_write();
+        if (Obj obj = find(*m_tr, key)) {
+            auto col = m_shared.col_fields[m_random() % m_shared.col_fields.size()];
+            obj.set(col, random_string(m_random, m_shared.config.field_length));
+        }
+        commit(*m_tr);
+    }
+
+    void insert()
+    {
+        m_tr->promote_to_write();
+        int64_t key = m_shared.next_key.fetch_add(1);
+        auto table = m_tr->get_table(m_shared.table_key);
+        Obj obj = table->create_object_with_primary_key(key);
+        for (auto col : m_shared.col_fields)
+            obj.set(col, random_string(m_random, m_shared.config.field_length));
+        commit(*m_tr);
+        // Keys are handed out inside the write transaction, so they are
+        // committed in order and all keys below the count are present
+        m_shared.committed_keys.store(key + 1, std::memory_order_release);
+    }
+
+    void read_modify_write()
+    {
+        int64_t key = choose_key();
+        m_tr->promote_to_write();
+        if (Obj obj = find(*m_tr, key)) {
+            read_fields(obj);
+            auto col = m_shared.col_fields[m_random() % m_shared.col_fields.size()];
+            obj.set(col, random_string(m_random, m_shared.config.field_length));
+        }
+        commit(*m_tr);
+    }
+};
+
+// Waits for commits the way the object store notifier thread does, and
+// measures the time from the end of the commit until the change is seen.
+void run_notifier(Shared& shared, ThreadResult& result)
+{
+    TransactionRef tr = shared.db->start_read();
+    while (!shared.stop.load(std::memory_order_relaxed)) {
+        if (!shared.db->wait_for_change(tr))
+            continue;
+        tr->advance_read();
+        int64_t committed_at = shared.last_commit_ns.load(std::memory_order_acquire);
+        if (committed_at != 0)
+            result.latencies[op_Notify].record(uint64_t(std::max<int64_t>(0, now_ns() - committed_at)));
+    }
+}
+
+void load(Shared& shared)
+{
+    const size_t batch_size = 10000;
+    std::mt19937_64 random(0);
+    for (size_t key = 0; key < shared.config.records;) {
+        WriteTransaction wt(shared.db);
+        auto table = wt.get_table(shared.table_key);
+        for (size_t end = std::min(key + batch_size, shared.config.records); key < end; ++key) {
+            Obj obj = table->create_object_with_primary_key(int64_t(key));
+            for (auto col : shared.col_fields)
+                obj.set(col, random_string(random, shared.config.field_length));
+        }
+        wt.commit();
+    }
+}
+
+nlohmann::json run_workload(const Config& config, const Workload& workload, BenchmarkResults& results)
+{
+    TestPathGuard guard(get_test_path_prefix() + "benchmark-workloads.realm");
+    std::string path = guard;
+    auto history = make_in_realm_history();
+    Shared shared(config, workload, DB::create(*history, path));
+    {
+        auto wt = shared.db->start_write();
+        auto table = wt->add_table_with_primary_key("usertable", type_Int, "_id");
+        shared.table_key = table->get_key();
+        shared.col_id = table->get_primary_key_column();
+        for (size_t i = 0; i < config.fields; ++i)
+            shared.col_fields.push_back(table->add_column(type_String, util::format("field%1", i)));
+        wt->commit();
+    }
+
+    auto load_begin = Clock::now();
+    load(shared);
+    std::chrono::duration<double> load_time = Clock::now() - load_begin;
+    auto size_after_load = File::get_size_static(path);
+
+    size_t num_threads = config.readers + config.writers;
+    std::vector<ThreadResult> thread_results(num_threads + 1);
+    std::vector<std::thread> threads;
+    std::random_device rd;
+    for (size_t i = 0; i < num_threads; ++i) {
+        bool writer = i < config.writers;
+        uint64_t seed = (uint64_t(rd()) << 32) + i;
+        threads.emplace_back([&, writer, seed, i] {
+            Client(shared, writer, seed).run(thread_results[i]);
+        });
+    }
+    if (config.notifier) {
+        threads.emplace_back([&] {
+            run_notifier(shared, thread_results[num_threads]);
+        });
+    }
+
+    auto begin = Clock::now();
+    std::this_thread::sleep_for(std::chrono::duration<double>(config.duration));
+    shared.stop = true;
+    shared.db->wait_for_change_release();
+    for (auto& thread : threads)
+        thread.join();
+    std::chrono::duration<double> elapsed = Clock::now() - begin;
+    auto size_after_run = File::get_size_static(path);
+
+    ThreadResult total;
+    for (auto& result : thread_results) {
+        for (int op = 0; op < num_operations; ++op)
+            total.latencies[op].merge(result.latencies[op]);
+    }
+
+    uint64_t num_ops = 0;
+    for (int op = 0; op < op_Notify; ++op)
+        num_ops += total.latencies[op].count();
+    double throughput = double(num_ops) / elapsed.count();
+
+    std::string name(1, workload.name);
+    std::string prefix = "workload_" + name;
+    std::string lead_prefix = util::format("%1 (%2)", name, workload.description);
+    results.submit_single((prefix + "_time_per_op").c_str(), (lead_prefix + " time per op").c_str(),
+                          "runtime_secs", 1 / throughput);
+
+    nlohmann::json latency;
+    for (int op = 0; op < num_operations; ++op) {
+        auto& histogram = total.latencies[op];
+        if (histogram.count() == 0)
+            continue;
+        auto micros = [](uint64_t ns) {
+            return double(ns) / 1000;
+        };
+        latency[g_operation_names[op]] = {
+            {"count", histogram.count()},
+            {"p50", micros(histogram.percentile(50))},
+            {"p99", micros(histogram.percentile(99))},
+            {"p999", micros(histogram.percentile(99.9))},
+            {"max", micros(histogram.max())},
+        };
+        const std::pair<double, const char*> percentiles[] = {{50, "p50"}, {99, "p99"}, {99.9, "p999"}};
+        for (auto [p, name] : percentiles) {
+            auto ident = util::format("%1_%2_%3", prefix, g_operation_names[op], name);
+            auto lead_text = util::format("%1 %2 %3", lead_prefix, g_operation_names[op], name);
+            results.submit_single(ident.c_str(), lead_text.c_str(), "latency_secs",
+                                  double(histogram.percentile(p)) / 1e9);
+        }
+    }
+
+    return {
+        {"workload", name},
+        {"description", workload.description},
+        {"records", config.records},
+        {"readers", config.readers},
+        {"writers", config.writers},
+        {"duration_secs", elapsed.count()},
+        {"load_secs", load_time.count()},
+        {"operations", num_ops},
+        {"throughput_ops_per_sec", throughput},
+        {"latency_us", latency},
+        {"file_size", {{"after_load", size_after_load}, {"after_run", size_after_run}}},
+        {"file_growth", size_after_run - size_after_load},
+    };
+}
+
+int benchmark_workloads_main(const Config& config)
+{
+    std::string results_file_stem = get_test_path_prefix();
+    std::cout << "Results path: " << results_file_stem << std::endl;
+    results_file_stem += "results";
+    BenchmarkResults results(48, "benchmark-workloads", results_file_stem.c_str());
+
+    nlohmann::json report = nlohmann::json::array();
+    for (auto& workload : g_workloads) {
+        if (config.workloads.find(workload.name) != std::string::npos)
+            report.push_back(run_workload(config, workload, results));
+    }
+
+    std::string report_path = get_test_path_prefix() + "workloads.latest.json";
+    std::ofstream(report_path) << report.dump(2) << std::endl;
+    std::cout << "Workload report: " << report_path << std::endl;
+    return 0;
+}
+
+bool parse_option(Config& config, const std::string& arg)
+{
+    auto eq = arg.find('=');
+    if (arg.compare(0, 2, "--") != 0 || eq == std::string::npos) {
+        if (arg == "--no-notifier") {
+            config.notifier = false;
+            return true;
+        }
+        if (arg == "--no-sync") {
+            disable_sync_to_disk();
+            return true;
+        }
+        return false;
+    }
+    std::string name = arg.substr(2, eq - 2);
+    std::string value = arg.substr(eq + 1);
+    if (name == "workloads") {
+        config.workloads = value;
+    }
+    else if (name == "duration") {
+        config.duration = std::stod(value);
+    }
+    else {
+        static const std::map<std::string, size_t Config::*> numbers = {
+            {"readers", &Config::readers},
+            {"writers", &Config::writers},
+            {"records", &Config::records},
+            {"fields", &Config::fields},
+            {"field-length", &Config::field_length},
+            {"max-scan-length", &Config::max_scan_length},
+        };
+        auto it = numbers.find(name);
+        if (it == numbers.end())
+            return false;
+        config.*(it->second) = size_t(std::stoull(value));
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+int main(int argc, const char** argv)
+{
+    Config config;
+    std::vector<const char*> args = {argv[0]};
+    bool help = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            help = true;
+        }
+        else if (arg.compare(0, 2, "--") == 0) {
+            try {
+                help |= !parse_option(config, arg);
+            }
+            catch (const std::exception&) {
+                help = true;
+            }
+        }
+        else {
+            args.push_back(argv[i]);
+        }
+    }
+    if (help || args.size() > 2 || config.records == 0 || config.fields == 0 || config.max_scan_length == 0 ||
+        config.readers + config.writers == 0) {
+        std::cout << "Usage: " << argv[0] << " [OPTIONS] [PATH]" << std::endl
+                  << "Run YCSB style mixed workloads against a Realm file." << std::endl
+                  << "Results are placed in the executable directory by default. A JSON report is written to"
+                  << std::endl
+                  << "workloads.latest.json, and percentiles are compared with results.baseline if it exists."
+                  << std::endl
+                  << std::endl
+                  << "Arguments:" << std::endl
+                  << "  -h, --help             display this help" << std::endl
+                  << "  PATH                   alternate path to store the Realm and results files;" << std::endl
+                  << "                         this path should end with a slash." << std::endl
+                  << "  --workloads=LETTERS    workloads to run, default ABCDEF" << std::endl
+                  << "                           A: 50% read, 50% update" << std::endl
+                  << "                           B: 95% read, 5% update" << std::endl
+                  << "                           C: 100% read" << std::endl
+                  << "                           D: 95% read of recent inserts, 5% insert" << std::endl
+                  << "                           E: 95% range query, 5% insert" << std::endl
+                  << "                           F: 50% read, 50% read-modify-write" << std::endl
+                  << "  --duration=SECONDS     duration of each workload, default 10" << std::endl
+                  << "  --readers=N            threads running only the read operations, default 2" << std::endl
+                  << "  --writers=N            threads running the full mix, default 1" << std::endl
+                  << "  --records=N            objects loaded before the run, default 100000" << std::endl
+                  << "  --fields=N             string properties per object, default 10" << std::endl
+                  << "  --field-length=N       length of each string, default 100" << std::endl
+                  << "  --max-scan-length=N    maximum number of keys in a range query, default 100" << std::endl
+                  << "  --no-notifier          don't measure the latency of change notifications" << std::endl
+                  << "  --no-sync              don't sync commits to disk" << std::endl
+                  << std::endl;
+        return 1;
+    }
+
+    if (!initialize_test_path(int(args.size()), args.data()))
+        return 1;
+    return benchmark_workloads_main(config);
+}
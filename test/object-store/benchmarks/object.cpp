@@ -35,6 +35,7 @@
 #include <realm/object-store/util/scheduler.hpp>
 
 #include <memory>
+#include <numeric>
 #include <random>
 #include <vector>
 
@@ -139,6 +140,53 @@ TEST_CASE("Benchmark index change calculations", "[benchmark][index]") {
         REQUIRE_INDICES(c.insertions, 0, 1);
         REQUIRE_INDICES(c.deletions, 1, 2);
     }
+
+    SECTION("randomized permutations of large results") {
+        constexpr size_t size = 100000;
+        std::mt19937_64 rng(42);
+        std::vector<int64_t> indices(size);
+        std::iota(indices.begin(), indices.end(), 0);
+        ObjKeys old_keys(indices);
+
+        // Move a number of scattered rows to random new positions, as happens
+        // when the sort property of a few objects is modified
+        auto move_rows = [&](size_t count) {
+            std::vector<int64_t> keys = indices;
+            for (size_t i = 0; i < count; ++i) {
+                size_t from = rng() % size;
+                size_t to = rng() % size;
+                int64_t key = keys[from];
+                keys.erase(keys.begin() + from);
+                keys.insert(keys.begin() + to, key);
+            }
+            return ObjKeys(keys);
+        };
+        auto modified_every = [](int64_t n) {
+            return [n](ObjKey key) {
+                return key.value % n == 0;
+            };
+        };
+
+        ObjKeys few_moved = move_rows(10);
+        BENCHMARK("10 rows moved") {
+            c = _impl::CollectionChangeBuilder::calculate(old_keys, few_moved, modified_every(1000), false);
+        };
+        REQUIRE(c.deletions.count() <= 10);
+
+        ObjKeys many_moved = move_rows(1000);
+        BENCHMARK("1000 rows moved") {
+            c = _impl::CollectionChangeBuilder::calculate(old_keys, many_moved, modified_every(100), false);
+        };
+        REQUIRE(c.deletions.count() <= 1000);
+
+        std::vector<int64_t> shuffled = indices;
+        std::shuffle(shuffled.begin(), shuffled.end(), rng);
+        ObjKeys all_moved(shuffled);
+        BENCHMARK("random permutation") {
+            c = _impl::CollectionChangeBuilder::calculate(old_keys, all_moved, modified_every(10), false);
+        };
+        REQUIRE(c.insertions.count() == c.deletions.count());
+    }
 }
 
 TEST_CASE("Benchmark object", "[benchmark][object]") {
@@ -1809,6 +1809,75 @@ TEST_CASE("C API - properties", "[c_api]") {
         }
     }
 
+    SECTION("realm_object_create_many()") {
+        auto get_double = [&](realm_object_t* obj) {
+            realm_value_t value;
+            CHECK(checked(realm_get_value(obj, bar_doubles_key, &value)));
+            return value.dnum;
+        };
+        auto num_bars = [&]() {
+            size_t count;
+            CHECK(checked(realm_get_num_objects(realm, class_bar.key, &count)));
+            return count;
+        };
+        realm_property_key_t properties[2] = {bar_doubles_key, bar_int_key};
+
+        write([&]() {
+            realm_value_t values[6] = {rlm_double_val(3.5), rlm_int_val(3), rlm_double_val(1.5),
+                                       rlm_int_val(1), rlm_double_val(2.5), rlm_int_val(2)};
+            realm_object_t* objects[3];
+            CHECK(checked(realm_object_create_many(realm, class_bar.key, 3, properties, 2, values, false, objects)));
+            auto obj0 = cptr(objects[0]), obj1 = cptr(objects[1]), obj2 = cptr(objects[2]);
+            CHECK(get_double(obj0.get()) == 3.5);
+            CHECK(get_double(obj1.get()) == 1.5);
+            CHECK(get_double(obj2.get()) == 2.5);
+        });
+        CHECK(num_bars() == 3);
+
+        SECTION("existing object without update") {
+            write([&]() {
+                realm_value_t values[4] = {rlm_double_val(4.5), rlm_int_val(4), rlm_double_val(20.0),
+                                           rlm_int_val(2)};
+                CHECK(!realm_object_create_many(realm, class_bar.key, 2, properties, 2, values, false, nullptr));
+                CHECK_ERR(RLM_ERR_OBJECT_ALREADY_EXISTS);
+            });
+            CHECK(num_bars() == 3);
+        }
+
+        SECTION("update") {
+            write([&]() {
+                realm_value_t values[6] = {rlm_double_val(4.5), rlm_int_val(4), rlm_double_val(20.0),
+                                           rlm_int_val(2), rlm_double_val(4.75), rlm_int_val(4)};
+                realm_object_t* objects[3];
+                CHECK(checked(
+                    realm_object_create_many(realm, class_bar.key, 3, properties, 2, values, true, objects)));
+                auto obj0 = cptr(objects[0]), obj1 = cptr(objects[1]), obj2 = cptr(objects[2]);
+                CHECK(realm_equals(obj0.get(), obj2.get()));
+                CHECK(get_double(obj0.get()) == 4.75);
+                CHECK(get_double(obj1.get()) == 20.0);
+            });
+            CHECK(num_bars() == 4);
+        }
+
+        SECTION("errors") {
+            write([&]() {
+                realm_value_t values[1] = {rlm_double_val(4.5)};
+                CHECK(!realm_object_create_many(realm, class_bar.key, 1, properties, 1, values, false, nullptr));
+                CHECK_ERR(RLM_ERR_MISSING_PROPERTY_VALUE);
+
+                realm_value_t wrong_type[2] = {rlm_str_val("4.5"), rlm_int_val(4)};
+                CHECK(!realm_object_create_many(realm, class_bar.key, 1, properties, 2, wrong_type, false, nullptr));
+                CHECK_ERR(RLM_ERR_PROPERTY_TYPE_MISMATCH);
+
+                realm_value_t foo_values[1] = {rlm_int_val(1)};
+                CHECK(!realm_object_create_many(realm, class_foo.key, 1, &foo_int_key, 1, foo_values, false,
+                                                nullptr));
+                CHECK_ERR(RLM_ERR_UNEXPECTED_PRIMARY_KEY);
+            });
+            CHECK(num_bars() == 3);
+        }
+    }
+
 
     SECTION("objects") {
         CPtr<realm_object_t> obj1;
@@ -23,6 +23,8 @@
 #include "util/index_helpers.hpp"
 
 #include <limits>
+#include <numeric>
+#include <random>
 
 using namespace realm;
 
@@ -673,6 +675,64 @@ TEST_CASE("collection_change: calculate() sorted", "[collection change]") {
             }
         }
     }
+
+    SECTION("reports only the displaced rows as moved in large results") {
+        std::mt19937_64 rng(5);
+        std::vector<int64_t> prev(5000);
+        std::iota(prev.begin(), prev.end(), 0);
+
+        // Move 100 distinct rows to random positions
+        std::vector<int64_t> moved = prev;
+        std::shuffle(moved.begin(), moved.end(), rng);
+        moved.resize(100);
+        std::vector<int64_t> next;
+        for (auto key : prev) {
+            if (std::find(moved.begin(), moved.end(), key) == moved.end())
+                next.push_back(key);
+        }
+        for (auto key : moved)
+            next.insert(next.begin() + rng() % (next.size() + 1), key);
+
+        c = _impl::CollectionChangeBuilder::calculate(ObjKeys(prev), ObjKeys(next), all_modified, false);
+        REQUIRE(c.deletions.count() <= 100);
+        REQUIRE(c.insertions.count() == c.deletions.count());
+
+        // Applying the changes to the old rows must produce the new rows
+        std::vector<int64_t> rows;
+        for (size_t i = 0; i < prev.size(); ++i) {
+            if (!c.deletions.contains(i))
+                rows.push_back(prev[i]);
+        }
+        for (auto i : c.insertions.as_indexes())
+            rows.insert(rows.begin() + i, next[i]);
+        REQUIRE(rows == next);
+    }
+
+    SECTION("prefers moving modified rows in large results") {
+        std::vector<int64_t> prev(1000);
+        std::iota(prev.begin(), prev.end(), 0);
+        // Swapping two rows can be reported as moving either of them
+        std::vector<int64_t> next = prev;
+        std::swap(next[100], next[101]);
+
+        c = _impl::CollectionChangeBuilder::calculate(
+            ObjKeys(prev), ObjKeys(next),
+            [](ObjKey key) {
+                return key.value == 100;
+            },
+            false);
+        REQUIRE_INDICES(c.deletions, 100);
+        REQUIRE_INDICES(c.insertions, 101);
+
+        c = _impl::CollectionChangeBuilder::calculate(
+            ObjKeys(prev), ObjKeys(next),
+            [](ObjKey key) {
+                return key.value == 101;
+            },
+            false);
+        REQUIRE_INDICES(c.deletions, 101);
+        REQUIRE_INDICES(c.insertions, 100);
+    }
 }
 
 TEST_CASE("collection_change: merge()", "[collection change]") {
@@ -1710,6 +1710,101 @@ TEST_CASE("object") {
                           "'not implemented'");
     }
 
+    SECTION("create_many") {
+        auto create_many = [&](StringData type, AnyVec values, CreatePolicy policy) {
+            r->begin_transaction();
+            auto objects = Object::create_many(d, r, type, util::Span<std::any>(values), policy);
+            r->commit_transaction();
+            return objects;
+        };
+        auto table = r->read_group().get_table("class_link target");
+        auto col_value = table->get_column_key("value");
+
+        auto objects = create_many("link target",
+                                   AnyVec{AnyDict{{"_id", INT64_C(3)}, {"value", INT64_C(30)}},
+                                          AnyDict{{"_id", INT64_C(1)}, {"value", INT64_C(10)}},
+                                          AnyDict{{"_id", INT64_C(2)}, {"value", INT64_C(20)}}},
+                                   CreatePolicy::ForceCreate);
+        REQUIRE(table->size() == 3);
+        REQUIRE(objects.size() == 3);
+        REQUIRE(objects[0].get_obj().get<Int>(col_value) == 30);
+        REQUIRE(objects[1].get_obj().get<Int>(col_value) == 10);
+        REQUIRE(objects[2].get_obj().get<Int>(col_value) == 20);
+        REQUIRE(objects[1].get_obj().get_key() == table->find_primary_key(1));
+
+        // Nothing is created if any of the objects exists
+        REQUIRE_EXCEPTION(create_many("link target",
+                                      AnyVec{AnyDict{{"_id", INT64_C(4)}, {"value", INT64_C(40)}},
+                                             AnyDict{{"_id", INT64_C(2)}, {"value", INT64_C(21)}}},
+                                      CreatePolicy::ForceCreate),
+                          ObjectAlreadyExists,
+                          "Attempting to create an object of type 'link target' with an existing primary key "
+                          "value '2'");
+        r->cancel_transaction();
+        REQUIRE(table->size() == 3);
+        REQUIRE_EXCEPTION(create_many("link target",
+                                      AnyVec{AnyDict{{"_id", INT64_C(4)}, {"value", INT64_C(40)}},
+                                             AnyDict{{"_id", INT64_C(4)}, {"value", INT64_C(41)}}},
+                                      CreatePolicy::ForceCreate),
+                          ObjectAlreadyExists,
+                          "Attempting to create an object of type 'link target' with an existing primary key "
+                          "value '4'");
+        r->cancel_transaction();
+        REQUIRE(table->size() == 3);
+
+        // Later values for the same object take precedence, and values
+        // which are missing are left untouched
+        objects = create_many("link target",
+                              AnyVec{AnyDict{{"_id", INT64_C(4)}, {"value", INT64_C(40)}},
+                                     AnyDict{{"_id", INT64_C(1)}, {"value", INT64_C(11)}},
+                                     AnyDict{{"_id", INT64_C(2)}},
+                                     AnyDict{{"_id", INT64_C(4)}, {"value", INT64_C(41)}}},
+                              CreatePolicy::UpdateAll);
+        REQUIRE(table->size() == 4);
+        REQUIRE(objects[0].get_obj().get_key() == objects[3].get_obj().get_key());
+        REQUIRE(objects[0].get_obj().get<Int>(col_value) == 41);
+        REQUIRE(objects[1].get_obj().get<Int>(col_value) == 11);
+        REQUIRE(objects[2].get_obj().get<Int>(col_value) == 20);
+    }
+
+    SECTION("create_many with update - only with diffs") {
+        auto create_many = [&](AnyVec values, CreatePolicy policy) {
+            r->begin_transaction();
+            auto objects = Object::create_many(d, r, "person", util::Span<std::any>(values), policy);
+            r->commit_transaction();
+            return objects;
+        };
+        AnyDict adam{{"_id", "pk0"s}, {"age", INT64_C(32)}, {"scores", AnyVec{INT64_C(1), INT64_C(2)}}};
+        AnyDict brian{{"_id", "pk1"s}, {"age", INT64_C(33)}, {"assistant", adam}};
+        AnyDict charley{{"_id", "pk2"s}, {"age", INT64_C(34)}, {"team", AnyVec{adam, brian}}};
+        create_many(AnyVec{adam, brian, charley}, CreatePolicy::UpdateModified);
+
+        auto table = r->read_group().get_table("class_person");
+        REQUIRE(table->size() == 3);
+        Object obj(r, *r->schema().find("person"), table->get_object(table->find_primary_key(StringData("pk2"))));
+        REQUIRE(util::any_cast<List&&>(obj.get_property_value<std::any>(d, "team")).size() == 2);
+
+        CollectionChangeSet change;
+        bool callback_called = false;
+        Results result = Results(r, table).sort({{"_id", true}});
+        auto token = result.add_notification_callback([&](CollectionChangeSet c) {
+            change = c;
+            callback_called = true;
+        });
+        advance_and_notify(*r);
+
+        callback_called = false;
+        create_many(AnyVec{adam, brian, charley}, CreatePolicy::UpdateModified);
+        advance_and_notify(*r);
+        REQUIRE(!callback_called);
+
+        brian["age"] = INT64_C(40);
+        create_many(AnyVec{adam, brian, charley}, CreatePolicy::UpdateModified);
+        advance_and_notify(*r);
+        REQUIRE(callback_called);
+        REQUIRE_INDICES(change.modifications, 1);
+    }
+
     SECTION("create with explicit null pk does not fall back to default") {
         d.defaults["nullable int pk"] = {
             {"_id", INT64_C(10)},
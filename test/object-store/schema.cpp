@@ -964,7 +964,8 @@ TEST_CASE("Schema") {
                                   {"data", PropertyType::Data},
                                   {"object", PropertyType::Object | PropertyType::Nullable, "object"},
                                   {"array", PropertyType::Array | PropertyType::Object, "object"},
-                                  {"set", PropertyType::Set | PropertyType::Int},
+                                  {"set", PropertyType::Set | PropertyType::Double},
+                                  {"dictionary", PropertyType::Dictionary | PropertyType::Int},
                                   {"decimal", PropertyType::Decimal},
                               }}};
             for (auto& prop : schema.begin()->persisted_properties) {
@@ -986,6 +987,10 @@ TEST_CASE("Schema") {
                      {"date", PropertyType::Date, Property::IsPrimary{false}, Property::IsIndexed{true}},
                      {"object id", PropertyType::ObjectId, Property::IsPrimary{false}, Property::IsIndexed{true}},
                      {"uuid", PropertyType::UUID, Property::IsPrimary{false}, Property::IsIndexed{true}},
+                     {"int array", PropertyType::Array | PropertyType::Int, Property::IsPrimary{false},
+                      Property::IsIndexed{true}},
+                     {"string set", PropertyType::Set | PropertyType::String, Property::IsPrimary{false},
+                      Property::IsIndexed{true}},
                  }}};
             REQUIRE_NOTHROW(schema.validate());
         }
@@ -770,7 +770,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         auto o6 = table->create_object().set(name_col, "any");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 11);
+        REQUIRE(algo_run_count == 6);
 
         REQUIRE(changes.sections_to_delete.empty());
         REQUIRE_INDICES(changes.sections_to_insert, 2, 3, 5);
@@ -807,7 +807,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(changes.modifications[5], 1);
         REQUIRE(changes.insertions.empty());
         REQUIRE(changes.deletions.empty());
-        REQUIRE(algo_run_count == 11);
+        REQUIRE(algo_run_count == 1);
 
         algo_run_count = 0;
         // Deletions
@@ -825,7 +825,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(changes.deletions[2], 1);
         REQUIRE(changes.insertions.empty());
         REQUIRE(changes.modifications.empty());
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 0);
 
         // Test moving objects from one section to a new one.
         // delete all objects starting with 'S'
@@ -850,7 +850,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(changes.insertions[2].empty());
         REQUIRE_INDICES(changes.insertions[3], 0, 1);
         REQUIRE_INDICES(changes.insertions[4], 0);
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 3);
 
         // Test moving objects from one section to an existing one.
         // move all objects starting with 'E'
@@ -867,7 +867,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(changes.insertions.size() == 1);
         REQUIRE(changes.modifications.empty());
         REQUIRE_INDICES(changes.insertions[0], 0, 5);
-        REQUIRE(algo_run_count == 9);
+        REQUIRE(algo_run_count == 2);
 
         // Test clearing all from the table
         algo_run_count = 0;
@@ -1232,7 +1232,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         auto o1 = table->create_object().set(name_col, "any");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 6);
+        REQUIRE(algo_run_count == 1);
 
         REQUIRE(section1_notification_calls == 1);
         REQUIRE(section2_notification_calls == 0);
@@ -1253,7 +1253,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.insertions[1], 1);
         REQUIRE(section2_changes.modifications.empty());
         REQUIRE(section2_changes.deletions.empty());
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
 
         // Modifications
@@ -1267,7 +1267,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section1_changes.modifications[0], 0);
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.deletions.empty());
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
         // Modify the column value to now be in a diff section
         r->begin_transaction();
@@ -1279,7 +1279,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1_changes.modifications.empty());
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE_INDICES(section1_changes.deletions[0], 0);
-        REQUIRE(algo_run_count == 7);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
 
         // Deletions
@@ -1294,7 +1294,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.deletions[1], 1);
         REQUIRE(section2_changes.insertions.empty());
         REQUIRE(section2_changes.modifications.empty());
-        REQUIRE(algo_run_count == 6);
+        REQUIRE(algo_run_count == 0);
         algo_run_count = 0;
 
         r->begin_transaction();
@@ -1307,7 +1307,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section1_changes.deletions[0], 1);
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.modifications.empty());
-        REQUIRE(algo_run_count == 5);
+        REQUIRE(algo_run_count == 0);
     }
 
     SECTION("notifications on section where section is deleted") {
@@ -1351,17 +1351,17 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE(section1_changes.insertions.empty());
         REQUIRE(section1_changes.modifications.empty());
         REQUIRE_INDICES(section1_changes.sections_to_delete, 0);
-        REQUIRE(algo_run_count == 2);
+        REQUIRE(algo_run_count == 0);
 
         r->begin_transaction();
-        REQUIRE(algo_run_count == 2);
+        REQUIRE(algo_run_count == 0);
         algo_run_count = 0;
         section1_notification_calls = 0;
         section2_notification_calls = 0;
         table->create_object().set(name_col, "book");
         r->commit_transaction();
         advance_and_notify(*r);
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
 
         REQUIRE(section1_notification_calls == 0);
         REQUIRE(section2_notification_calls == 1);
@@ -1370,12 +1370,12 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         REQUIRE_INDICES(section2_changes.insertions[0], 1);
         REQUIRE(section2_changes.modifications.empty());
         REQUIRE(section2.index() == 0);
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
 
         // Insert values back into section1
         REQUIRE_FALSE(section1.is_valid());
         r->begin_transaction();
-        REQUIRE(algo_run_count == 3);
+        REQUIRE(algo_run_count == 1);
         algo_run_count = 0;
         section1_notification_calls = 0;
         section2_notification_calls = 0;
@@ -1383,7 +1383,7 @@ TEST_CASE("sectioned results", "[sectioned results]") {
         r->commit_transaction();
         advance_and_notify(*r);
 
-        REQUIRE(algo_run_count == 4);
+        REQUIRE(algo_run_count == 1);
         REQUIRE(section1_notification_calls == 1);
         REQUIRE(section2_notification_calls == 0);
         REQUIRE(section1_changes.deletions.empty());
@@ -1583,6 +1583,152 @@ TEST_CASE("sectioned results link notification bug", "[sectioned results]") {
     REQUIRE_INDICES(changes.modifications[0], 0);
 }
 
+TEST_CASE("sectioned results builtin operators", "[sectioned results]") {
+    _impl::RealmCoordinator::assert_no_open_realms();
+
+    InMemoryTestFile config;
+    config.automatic_change_notifications = false;
+
+    auto r = Realm::get_shared_realm(config);
+    r->update_schema({{"person",
+                       {{"name", PropertyType::String},
+                        {"age", PropertyType::Int},
+                        {"born", PropertyType::Date | PropertyType::Nullable},
+                        {"address", PropertyType::Object | PropertyType::Nullable, "address"}}},
+                      {"address", {{"city", PropertyType::String}}}});
+
+    auto coordinator = _impl::RealmCoordinator::get_coordinator(config.path);
+    auto person = r->read_group().get_table("class_person");
+    auto address = r->read_group().get_table("class_address");
+    auto name_col = person->get_column_key("name");
+    auto age_col = person->get_column_key("age");
+    auto born_col = person->get_column_key("born");
+    auto address_col = person->get_column_key("address");
+    auto city_col = address->get_column_key("city");
+
+    constexpr int64_t day = 24 * 60 * 60;
+    r->begin_transaction();
+    auto oslo = address->create_object().set(city_col, "Oslo");
+    auto odense = address->create_object().set(city_col, "Odense");
+    person->create_object().set_all("Ærø", 30, Timestamp(day + 10, 0), oslo.get_key());
+    person->create_object().set_all("Æble", 20, Timestamp(2 * day, 0), odense.get_key());
+    person->create_object().set_all("Anna", 30, Timestamp(-10, -500'000'000), oslo.get_key());
+    auto p4 = person->create_object().set_all("Annika", 40);
+    r->commit_transaction();
+
+    auto sorted = Results(r, person).sort({{"name", true}});
+
+    // The keys of the sections must outlive the ResultsSections
+    std::list<std::string> key_buffers;
+    auto section_keys = [&](SectionedResults& sr) {
+        std::vector<Mixed> keys;
+        for (size_t i = 0; i < sr.size(); ++i) {
+            auto section = sr[i];
+            Mixed key = section.key();
+            if (key.is_type(type_String))
+                key = StringData(key_buffers.emplace_back(key.get_string()));
+            keys.push_back(key);
+        }
+        return keys;
+    };
+    auto section_sizes = [](SectionedResults& sr) {
+        std::vector<size_t> sizes;
+        for (size_t i = 0; i < sr.size(); ++i)
+            sizes.push_back(sr[i].size());
+        return sizes;
+    };
+
+    SECTION("Value") {
+        auto sr = sorted.sectioned_results(Results::SectionedResultsOperator::Value, StringData("age"));
+        REQUIRE(section_keys(sr) == std::vector<Mixed>{30, 40, 20});
+        REQUIRE(section_sizes(sr) == std::vector<size_t>{2, 1, 1});
+    }
+
+    SECTION("Prefix counts code points") {
+        auto sr = sorted.sectioned_results(Results::SectionedResultsOperator::Prefix, StringData("name"), 2);
+        REQUIRE(section_keys(sr) == std::vector<Mixed>{"An", "Æb", "Ær"});
+        REQUIRE(section_sizes(sr) == std::vector<size_t>{2, 1, 1});
+    }
+
+    SECTION("DateBucket") {
+        auto sr = sorted.sectioned_results(Results::SectionedResultsOperator::DateBucket, StringData("born"), day);
+        REQUIRE(section_keys(sr) ==
+                std::vector<Mixed>{Timestamp(-day, 0), Mixed(), Timestamp(2 * day, 0), Timestamp(day, 0)});
+        REQUIRE(section_sizes(sr) == std::vector<size_t>{1, 1, 1, 1});
+    }
+
+    SECTION("key path through a link") {
+        auto sr = sorted.sectioned_results(Results::SectionedResultsOperator::Prefix, StringData("address.city"), 2);
+        REQUIRE(section_keys(sr) == std::vector<Mixed>{"Os", Mixed(), "Od"});
+        REQUIRE(section_sizes(sr) == std::vector<size_t>{2, 1, 1});
+
+        SectionedResultsChangeSet changes;
+        auto token = sr.add_notification_callback([&](SectionedResultsChangeSet c) {
+            changes = c;
+        });
+        advance_and_notify(*r);
+
+        // Changing the linked object moves the rows linking to it
+        r->begin_transaction();
+        oslo.set(city_col, "Odense");
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(section_keys(sr) == std::vector<Mixed>{"Od", Mixed()});
+        REQUIRE(section_sizes(sr) == std::vector<size_t>{3, 1});
+        REQUIRE_INDICES(changes.sections_to_delete, 0);
+        REQUIRE(changes.sections_to_insert.empty());
+
+        r->begin_transaction();
+        p4.set(address_col, oslo.get_key());
+        r->commit_transaction();
+        advance_and_notify(*r);
+        REQUIRE(section_keys(sr) == std::vector<Mixed>{"Od"});
+        REQUIRE(section_sizes(sr) == std::vector<size_t>{4});
+        REQUIRE_INDICES(changes.sections_to_delete, 1);
+        REQUIRE_INDICES(changes.insertions[0], 1);
+    }
+
+    SECTION("incremental updates match a full recalculation") {
+        auto sr = sorted.sectioned_results(Results::SectionedResultsOperator::Prefix, StringData("name"), 1);
+        auto token = sr.add_notification_callback([](SectionedResultsChangeSet) {});
+        advance_and_notify(*r);
+
+        r->begin_transaction();
+        person->create_object().set(name_col, "Bo");
+        p4.set(name_col, "Zed");
+        person->create_object().set(name_col, "Ærlig");
+        r->commit_transaction();
+        advance_and_notify(*r);
+
+        auto expected = sorted.sectioned_results([](Mixed value, const SharedRealm& realm) -> Mixed {
+            auto name = realm->read_group().get_object(value.get_link()).get<String>("name");
+            return name.size() > 0 && static_cast<unsigned char>(name[0]) >= 0x80 ? name.prefix(2) : name.prefix(1);
+        });
+        REQUIRE(section_keys(sr) == section_keys(expected));
+        REQUIRE(section_sizes(sr) == section_sizes(expected));
+        REQUIRE(section_keys(sr) == std::vector<Mixed>{"A", "B", "Z", "Æ"});
+        REQUIRE(section_sizes(sr) == std::vector<size_t>{1, 1, 1, 3});
+    }
+
+    SECTION("invalid arguments") {
+        using Op = Results::SectionedResultsOperator;
+        REQUIRE_THROWS_CONTAINING(sorted.sectioned_results(Op::Value, StringData("missing")),
+                                  "property 'person.missing' does not exist");
+        REQUIRE_THROWS_CONTAINING(sorted.sectioned_results(Op::Value, StringData("address")),
+                                  "cannot be the final property in the key path");
+        REQUIRE_THROWS_CONTAINING(sorted.sectioned_results(Op::Value, StringData("name.city")),
+                                  "may only be the final property in the key path");
+        REQUIRE_THROWS_CONTAINING(sorted.sectioned_results(Op::Prefix, StringData("age"), 1),
+                                  "property must be of type 'string'");
+        REQUIRE_THROWS_CONTAINING(sorted.sectioned_results(Op::Prefix, StringData("name")),
+                                  "prefix length must be positive");
+        REQUIRE_THROWS_CONTAINING(sorted.sectioned_results(Op::DateBucket, StringData("name"), day),
+                                  "property must be of type 'date'");
+        REQUIRE_THROWS_CONTAINING(sorted.sectioned_results(Op::DateBucket, StringData("born"), 0),
+                                  "bucket size must be positive");
+    }
+}
+
 namespace cf = realm::sectioned_results_fixtures;
 
 TEMPLATE_TEST_CASE("sectioned results primitive types", "[sectioned results]", cf::MixedVal, cf::Int, cf::Bool,
@@ -28,6 +28,7 @@
 #include <realm/alloc_slab.hpp>
 #include <realm/array.hpp>
 #include <realm/group.hpp>
+#include <realm/group_writer.hpp>
 #include <realm/impl/simulated_failure.hpp>
 #include <realm/util/file.hpp>
 
@@ -483,4 +484,112 @@ TEST(Alloc_ToAndFromRef)
     }
 }
 
+TEST(Alloc_FreeSpaceBins)
+{
+    FreeSpaceBins bins;
+    auto all_chunks = [&] {
+        std::vector<std::pair<size_t, size_t>> chunks;
+        bins.for_each([&](size_t size, size_t pos) {
+            chunks.emplace_back(size, pos);
+        });
+        std::sort(chunks.begin(), chunks.end());
+        return chunks;
+    };
+    auto first_fit = [&](size_t min_size, size_t max_size) {
+        return bins.find(min_size, max_size, [](FreeSpaceBins::Handle h) {
+            return h;
+        });
+    };
+
+    CHECK(bins.empty());
+    CHECK_EQUAL(bins.largest(), FreeSpaceBins::npos);
+    CHECK_EQUAL(first_fit(8, 8), FreeSpaceBins::npos);
+
+    // Exact classes, the same class for different powers of two, and huge chunks
+    auto h_16 = bins.insert(16, 800);
+    auto h_1024 = bins.insert(1024, 8000);
+    auto h_1272 = bins.insert(1272, 16000);
+    auto h_1536 = bins.insert(1536, 24000);
+    auto h_huge = bins.insert(size_t(1) << 40, 32000);
+    CHECK_EQUAL(bins.count(), 5);
+    CHECK_EQUAL(bins.chunk_size(h_1272), 1272);
+    CHECK_EQUAL(bins.chunk_pos(h_1272), 16000);
+    CHECK_EQUAL(all_chunks().size(), 5);
+
+    CHECK_EQUAL(first_fit(16, 16), h_16);
+    CHECK_EQUAL(first_fit(8, 8), FreeSpaceBins::npos);
+    CHECK_EQUAL(first_fit(24, 1000), FreeSpaceBins::npos);
+    // 1024 and 1272 are in the same class, but only one of them is big enough
+    CHECK_EQUAL(first_fit(1100, size_t(-1)), h_1272);
+    CHECK_EQUAL(first_fit(1024, 1024), h_1024);
+    CHECK_EQUAL(first_fit(1280, 1536), h_1536);
+    CHECK_EQUAL(first_fit(2048, size_t(-1)), h_huge);
+    CHECK_EQUAL(bins.largest(), h_huge);
+
+    // A chunk which is rejected is skipped
+    auto h = bins.find(1000, size_t(-1), [&](FreeSpaceBins::Handle h) {
+        return h == h_1536 ? h : FreeSpaceBins::npos;
+    });
+    CHECK_EQUAL(h, h_1536);
+
+    bins.erase(h_huge);
+    bins.erase(h_1024);
+    CHECK_EQUAL(bins.count(), 3);
+    CHECK_EQUAL(bins.largest(), h_1536);
+    CHECK_EQUAL(first_fit(2048, size_t(-1)), FreeSpaceBins::npos);
+    CHECK_EQUAL(first_fit(1024, 1024), FreeSpaceBins::npos);
+    CHECK_EQUAL(first_fit(1000, 1300), h_1272);
+
+    // Handles of erased chunks are reused, other handles stay valid
+    auto h_40 = bins.insert(40, 400);
+    CHECK(h_40 == h_huge || h_40 == h_1024);
+    CHECK_EQUAL(bins.chunk_pos(h_1272), 16000);
+    CHECK_EQUAL(first_fit(40, 40), h_40);
+    std::vector<std::pair<size_t, size_t>> expected = {{16, 800}, {40, 400}, {1272, 16000}, {1536, 24000}};
+    CHECK(all_chunks() == expected);
+
+    // Compare against a multimap with random operations
+    test_util::Random random(test_util::random_int<unsigned long>()); // Seed from slow global generator
+    std::multimap<size_t, size_t> reference;
+    std::vector<FreeSpaceBins::Handle> handles;
+    bins.clear();
+    CHECK(bins.empty());
+    for (int i = 0; i < 10000; ++i) {
+        if (handles.empty() || random.draw_int_mod(3) != 0) {
+            size_t size = 8 * (1 + (size_t(1) << random.draw_int_mod(20)) / 8 + random.draw_int_mod(100));
+            size_t pos = 8 * size_t(i);
+            handles.push_back(bins.insert(size, pos));
+            reference.emplace(size, pos);
+        }
+        else {
+            size_t ndx = random.draw_int_mod(handles.size());
+            auto h = handles[ndx];
+            auto range = reference.equal_range(bins.chunk_size(h));
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == bins.chunk_pos(h)) {
+                    reference.erase(it);
+                    break;
+                }
+            }
+            bins.erase(h);
+            handles[ndx] = handles.back();
+            handles.pop_back();
+        }
+        if (i % 100 == 0) {
+            size_t request = 8 * (1 + random.draw_int_mod(100000));
+            auto lb = reference.lower_bound(request);
+            auto found = first_fit(request, size_t(-1));
+            CHECK_EQUAL(lb == reference.end(), found == FreeSpaceBins::npos);
+            if (found != FreeSpaceBins::npos)
+                CHECK_GREATER_EQUAL(bins.chunk_size(found), request);
+            auto largest = bins.largest();
+            if (CHECK_EQUAL(reference.empty(), largest == FreeSpaceBins::npos) && largest != FreeSpaceBins::npos)
+                CHECK_EQUAL(bins.chunk_size(largest), reference.rbegin()->first);
+        }
+    }
+    CHECK_EQUAL(bins.count(), reference.size());
+    expected.assign(reference.begin(), reference.end());
+    CHECK(all_chunks() == expected);
+}
+
 #endif // TEST_ALLOC
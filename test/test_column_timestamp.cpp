@@ -293,6 +293,168 @@ TEST(TimestampColumn_FindFirst)
 }
 
 
+namespace {
+
+template <class Cond>
+size_t find_first_brute_force(const std::vector<Timestamp>& values, Timestamp value)
+{
+    Cond c;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (c(values[i], value, values[i].is_null(), value.is_null()))
+            return i;
+    }
+    return realm::not_found;
+}
+
+template <class Cond>
+void check_find_first(test_util::unit_test::TestContext& test_context, const ArrayTimestamp& arr,
+                      const std::vector<Timestamp>& values, Timestamp value)
+{
+    CHECK_EQUAL(arr.find_first<Cond>(value, 0, arr.size()), find_first_brute_force<Cond>(values, value));
+}
+
+void check_leaf(test_util::unit_test::TestContext& test_context, const ArrayTimestamp& arr, const std::vector<Timestamp>& values,
+                const std::vector<Timestamp>& needles)
+{
+    CHECK_EQUAL(arr.size(), values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        CHECK_EQUAL(arr.get(i), values[i]);
+        CHECK_EQUAL(arr.is_null(i), values[i].is_null());
+    }
+    for (auto& needle : needles) {
+        check_find_first<Equal>(test_context, arr, values, needle);
+        check_find_first<NotEqual>(test_context, arr, values, needle);
+        check_find_first<Greater>(test_context, arr, values, needle);
+        check_find_first<GreaterEqual>(test_context, arr, values, needle);
+        check_find_first<Less>(test_context, arr, values, needle);
+        check_find_first<LessEqual>(test_context, arr, values, needle);
+        if (needle.is_null())
+            continue;
+        for (auto& upper : needles) {
+            if (upper.is_null())
+                continue;
+            size_t expected = realm::not_found;
+            for (size_t i = 0; i < values.size(); ++i) {
+                if (!values[i].is_null() && needle <= values[i] && values[i] <= upper) {
+                    expected = i;
+                    break;
+                }
+            }
+            CHECK_EQUAL(arr.find_first_in_range(needle, upper, 0, arr.size()), expected);
+        }
+    }
+}
+
+} // unnamed namespace
+
+TEST(TimestampColumn_CompactLeaf)
+{
+    // Smallest and largest values which fit in 64 bits of nanoseconds
+    const Timestamp compact_min(-9223372036, -854775807);
+    const Timestamp compact_max(9223372036, 854775807);
+
+    std::vector<Timestamp> values = {Timestamp(0, 0),   Timestamp{},       Timestamp(-1, -1),         Timestamp(1, 1),
+                                     Timestamp(0, -5),  Timestamp(1, 0),   Timestamp(1461746402, 17), compact_min,
+                                     Timestamp{},       compact_max,       Timestamp(-1, 0),          Timestamp(0, 1)};
+    std::vector<Timestamp> needles = {Timestamp{},
+                                      Timestamp(0, 0),
+                                      Timestamp(0, 1),
+                                      Timestamp(0, -1),
+                                      Timestamp(-1, 0),
+                                      Timestamp(1, 1),
+                                      Timestamp(1461746402, 17),
+                                      compact_min,
+                                      compact_max,
+                                      Timestamp(-9223372036, -854775808),
+                                      Timestamp(9223372036, 854775808),
+                                      Timestamp(std::numeric_limits<int64_t>::min(), 0),
+                                      Timestamp(std::numeric_limits<int64_t>::max(), 0)};
+
+    ArrayTimestamp arr(Allocator::get_default());
+    arr.create();
+    for (auto& v : values)
+        arr.add(v);
+    CHECK(arr.is_compact());
+    arr.verify();
+    check_leaf(test_context, arr, values, needles);
+
+    // Moving between compact leaves keeps them compact
+    ArrayTimestamp arr2(Allocator::get_default());
+    arr2.create();
+    arr.move(arr2, 6);
+    CHECK(arr2.is_compact());
+    CHECK_EQUAL(arr2.size(), values.size() - 6);
+    CHECK_EQUAL(arr2.get(0), values[6]);
+    arr2.move(arr, 0);
+    check_leaf(test_context, arr, values, needles);
+
+    // A value outside the compact range converts the leaf to the split form
+    arr.set(4, Timestamp(std::numeric_limits<int64_t>::max(), 0));
+    values[4] = Timestamp(std::numeric_limits<int64_t>::max(), 0);
+    arr.insert(2, Timestamp(-9223372036, -854775808));
+    values.insert(values.begin() + 2, Timestamp(-9223372036, -854775808));
+    CHECK_NOT(arr.is_compact());
+    arr.verify();
+    check_leaf(test_context, arr, values, needles);
+
+    // Moving from a split leaf into a compact leaf makes the target split
+    arr.move(arr2, 3);
+    CHECK_NOT(arr2.is_compact());
+    for (size_t i = 3; i < values.size(); ++i)
+        CHECK_EQUAL(arr2.get(i - 3), values[i]);
+
+    // Reattaching detects the layout
+    ArrayTimestamp arr3(Allocator::get_default());
+    arr3.init_from_ref(arr2.get_ref());
+    CHECK_NOT(arr3.is_compact());
+    CHECK_EQUAL(arr3.get(0), values[3]);
+
+    Array::destroy_deep(arr.get_ref(), Allocator::get_default());
+    Array::destroy_deep(arr2.get_ref(), Allocator::get_default());
+}
+
+TEST(TimestampColumn_CompactQueries)
+{
+    Table t;
+    auto col = t.add_column(type_Timestamp, "date", true);
+    for (int64_t i = 0; i < 3000; ++i) {
+        auto obj = t.create_object();
+        if (i % 7)
+            obj.set(col, Timestamp(1700000000 + i / 2, int32_t(i % 2) * 500000000));
+    }
+
+    auto check_counts = [&] {
+        Timestamp pivot(1700000700, 500000000);
+        size_t greater = 0, less = 0, equal = 0, nulls = 0;
+        for (auto& o : t) {
+            auto ts = o.get<Timestamp>(col);
+            if (ts.is_null()) {
+                ++nulls;
+                continue;
+            }
+            greater += pivot < ts;
+            less += ts < pivot;
+            equal += ts == pivot;
+        }
+        CHECK_EQUAL(t.where().greater(col, pivot).count(), greater);
+        CHECK_EQUAL(t.where().greater_equal(col, pivot).count(), greater + equal);
+        CHECK_EQUAL(t.where().less(col, pivot).count(), less);
+        CHECK_EQUAL(t.where().less_equal(col, pivot).count(), less + equal);
+        CHECK_EQUAL(t.where().equal(col, pivot).count(), equal);
+        CHECK_EQUAL(t.where().not_equal(col, pivot).count(), t.size() - equal);
+        CHECK_EQUAL(t.where().equal(col, Timestamp{}).count(), nulls);
+        CHECK_EQUAL(t.where().between(col, Timestamp(1700000100, 0), Timestamp(1700000199, 999999999)).count(),
+                    200 - 200 / 7 - 1);
+        CHECK_EQUAL(*t.max(col), Timestamp(1700001499, 500000000));
+    };
+    check_counts();
+
+    // Force the first leaf into the split form
+    t.begin()->set(col, Timestamp(std::numeric_limits<int64_t>::min() / 2, 0));
+    t.begin()->set(col, Timestamp{});
+    check_counts();
+}
+
 TEST(TimestampColumn_AddColumnAfterRows)
 {
     constexpr bool nullable = true;
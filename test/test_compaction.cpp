@@ -264,3 +264,64 @@ NONCONCURRENT_TEST(Compaction_Performance)
     std::cout << "Normal: " << t0 << " us" << std::endl;
     std::cout << "Compacting: " << t1 << " us" << std::endl;
 }
+
+TEST(Compaction_ReclusterTable)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    DBRef db = DB::create(make_in_realm_history(), path);
+    ColKey col_int, col_str;
+    TableKey key;
+    {
+        auto tr = db->start_write();
+        auto table = tr->add_table("Scanned");
+        col_int = table->add_column(type_Int, "int");
+        col_str = table->add_column(type_String, "str");
+        key = table->get_key();
+        auto other = tr->add_table("Other");
+        auto col_other = other->add_column(type_Int, "int");
+        tr->commit_and_continue_as_read();
+
+        // Interleave small commits to the two tables to scatter the nodes of both
+        for (int i = 0; i < 200; ++i) {
+            tr->promote_to_write();
+            for (int j = 0; j < 20; ++j) {
+                table->create_object().set(col_int, i * 20 + j).set(col_str, std::string(j + 1, 'a' + j));
+                other->create_object().set(col_other, j);
+            }
+            tr->commit_and_continue_as_read();
+        }
+        for (int i = 0; i < 200; ++i) {
+            tr->promote_to_write();
+            table->get_object(i * 19 % 4000).set(col_int, -i);
+            other->get_object(i * 7 % 4000).set(col_other, i);
+            tr->commit_and_continue_as_read();
+        }
+    }
+
+    auto rt = db->start_read();
+    auto before = rt->get_table(key)->get_layout_info();
+    CHECK_GREATER(before.node_count, 10);
+    CHECK_GREATER(before.extent_count, 20);
+    CHECK_LESS(before.density(), 0.9);
+    CHECK_THROW(rt->recluster_table(key), LogicError);
+
+    auto tr = db->start_write();
+    tr->recluster_table(key);
+    // All nodes of the table are now in memory
+    CHECK_EQUAL(tr->get_table(key)->get_layout_info().node_count, 0);
+    CHECK_EQUAL(tr->get_table(key)->get_object(19).get<Int>(col_int), -1);
+    tr->commit();
+
+    rt->advance_read();
+    auto table = rt->get_table(key);
+    auto after = table->get_layout_info();
+    CHECK_EQUAL(after.node_count, before.node_count);
+    CHECK_LESS(after.extent_count * 10, before.extent_count);
+    // How densely the nodes can be placed depends on the free space available
+    CHECK_GREATER(after.density(), before.density());
+
+    CHECK_EQUAL(table->size(), 4000);
+    CHECK_EQUAL(table->get_object(19).get<Int>(col_int), -1);
+    CHECK_EQUAL(table->get_object(3999).get<String>(col_str), std::string(20, 't'));
+    table->verify();
+}
@@ -501,3 +501,58 @@ TEST(Decimal_Aggregates)
         CHECK_EQUAL(table->min(col)->get_decimal(), Decimal128(1));
     }
 }
+
+TEST(Decimal_Accumulator)
+{
+    test_util::Random random(test_util::random_int<unsigned long>());
+
+    auto check_sum = [&](const std::vector<Decimal128>& values) {
+        Decimal128 expected;
+        Decimal128::Accumulator acc;
+        for (auto& v : values) {
+            expected += v;
+            acc.add(v);
+        }
+        // Must be bit identical to repeated addition
+        Decimal128 actual = acc.result();
+        CHECK_EQUAL(actual.raw()->w[0], expected.raw()->w[0]);
+        CHECK_EQUAL(actual.raw()->w[1], expected.raw()->w[1]);
+    };
+
+    check_sum({});
+    check_sum({Decimal128("0E-5")});
+    check_sum({Decimal128("-0"), Decimal128("-0E-2")});
+    check_sum({Decimal128("1.25"), Decimal128("-1.25")});
+    check_sum({Decimal128("1.5"), Decimal128("2.25"), Decimal128("100"), Decimal128("1E+3")});
+    check_sum({Decimal128("-Inf"), Decimal128("1.5")});
+    check_sum({Decimal128("1.5"), Decimal128("+Inf"), Decimal128("1.5")});
+    check_sum({Decimal128("9999999999999999999999999999999999"), Decimal128("1"), Decimal128("0.5")});
+    check_sum({Decimal128("9999999999999999999999999999999999"), Decimal128("-1E-10")});
+    check_sum({Decimal128("1E+6000"), Decimal128("1E-6000")});
+
+    // Currency like values, which stay on the fast path
+    std::vector<Decimal128> values;
+    for (int i = 0; i < 1000; i++) {
+        int64_t cents = random.draw_int<int64_t>(-1000000, 1000000);
+        values.push_back(Decimal128(Decimal128::Bid128{{uint64_t(std::abs(cents)), 0}}, -2, cents < 0));
+    }
+    check_sum(values);
+
+    // Mixed exponents and magnitudes, which will eventually round
+    values.clear();
+    for (int i = 0; i < 1000; i++) {
+        uint64_t coefficient = random.draw_int<uint64_t>();
+        int exponent = random.draw_int<int>(-20, 20);
+        values.push_back(Decimal128(Decimal128::Bid128{{coefficient, 0}}, exponent, random.draw_bool()));
+    }
+    check_sum(values);
+
+    // Merging partial sums
+    Decimal128::Accumulator a;
+    Decimal128::Accumulator b;
+    a.add(Decimal128("1.25"));
+    b.add(Decimal128("2.5"));
+    a.add(b);
+    CHECK_EQUAL(a.result(), Decimal128("3.75"));
+    CHECK_EQUAL(a.result().to_string(), "3.75");
+}
@@ -2072,4 +2072,145 @@ TEST_TYPES(StringIndex_ListOfStrings, std::true_type, std::false_type)
     }
 }
 
+TEST(StringIndex_CollectionsOfPrimitives)
+{
+    Group g;
+    auto t = g.add_table("foo");
+
+    // Every indexed column has an unindexed twin holding the same values. The integer, ObjectId and UUID values
+    // contain the bytes 0 and 'X', which are special to the index.
+    ColKey col_ints = t->add_column_list(type_Int, "ints", true);
+    ColKey col_ints_plain = t->add_column_list(type_Int, "ints_plain", true);
+    ColKey col_dates = t->add_column_list(type_Timestamp, "dates");
+    ColKey col_dates_plain = t->add_column_list(type_Timestamp, "dates_plain");
+    ColKey col_uuids = t->add_column_list(type_UUID, "uuids");
+    ColKey col_uuids_plain = t->add_column_list(type_UUID, "uuids_plain");
+    ColKey col_oids = t->add_column_set(type_ObjectId, "oids");
+    ColKey col_oids_plain = t->add_column_set(type_ObjectId, "oids_plain");
+    ColKey col_strings = t->add_column_set(type_String, "strings");
+    ColKey col_strings_plain = t->add_column_set(type_String, "strings_plain");
+
+    std::vector<Mixed> ints{0, 1, -1, 88, 0x5858, int64_t(0x5800000000000058), int64_t(1) << 40, 7};
+    std::vector<Mixed> dates{Timestamp(0, 0), Timestamp(88, 0), Timestamp(1, 88), Timestamp(-100, 0)};
+    std::vector<Mixed> uuids{UUID("00000000-0000-0000-0000-000000000000"),
+                             UUID("58585858-5858-5858-5858-585858585858"),
+                             UUID("01234567-89ab-cdef-0123-456789abcdef")};
+    std::vector<Mixed> oids{ObjectId("000000000000000000000000"), ObjectId("585858585858585858585858"),
+                            ObjectId("000000000000000000000001"), ObjectId("5858000000000000000000ff")};
+    std::vector<Mixed> strings{"", "a", "X", "abcX", "abcXef", "hello world"};
+
+    struct Column {
+        ColKey indexed;
+        ColKey plain;
+        std::vector<Mixed>* values;
+    };
+    std::vector<Column> columns{{col_ints, col_ints_plain, &ints},
+                                {col_dates, col_dates_plain, &dates},
+                                {col_uuids, col_uuids_plain, &uuids},
+                                {col_oids, col_oids_plain, &oids},
+                                {col_strings, col_strings_plain, &strings}};
+
+    // Some indexes are populated from existing values, the others are maintained from the start
+    t->add_search_index(col_ints);
+    t->add_search_index(col_oids);
+
+    Random random(random_int<unsigned long>());
+    std::vector<ObjKey> keys;
+    auto modify = [&](size_t num_ops) {
+        for (size_t op = 0; op < num_ops; op++) {
+            if (keys.empty() || random.chance(1, 10)) {
+                keys.push_back(t->create_object().get_key());
+                continue;
+            }
+            Obj obj = t->get_object(keys[random.draw_int_mod(keys.size())]);
+            if (random.chance(1, 50)) {
+                keys.erase(std::find(keys.begin(), keys.end(), obj.get_key()));
+                obj.remove();
+                continue;
+            }
+            for (auto& col : columns) {
+                auto indexed = obj.get_collection_ptr(col.indexed);
+                auto plain = obj.get_collection_ptr(col.plain);
+                Mixed value = (*col.values)[random.draw_int_mod(col.values->size())];
+                int action = random.draw_int_mod(10);
+                if (col.indexed.is_set()) {
+                    auto& set = static_cast<SetBase&>(*indexed);
+                    auto& plain_set = static_cast<SetBase&>(*plain);
+                    if (action == 0) {
+                        set.clear();
+                        plain_set.clear();
+                    }
+                    else if (action < 4) {
+                        set.erase_any(value);
+                        plain_set.erase_any(value);
+                    }
+                    else {
+                        set.insert_any(value);
+                        plain_set.insert_any(value);
+                    }
+                    continue;
+                }
+                auto& list = static_cast<LstBase&>(*indexed);
+                auto& plain_list = static_cast<LstBase&>(*plain);
+                size_t sz = list.size();
+                if (action == 0) {
+                    list.clear();
+                    plain_list.clear();
+                }
+                else if (action < 3 && sz > 0) {
+                    size_t ndx = random.draw_int_mod(sz);
+                    list.remove(ndx, ndx + 1);
+                    plain_list.remove(ndx, ndx + 1);
+                }
+                else if (action < 5 && sz > 0) {
+                    size_t ndx = random.draw_int_mod(sz);
+                    list.set_any(ndx, value);
+                    plain_list.set_any(ndx, value);
+                }
+                else {
+                    list.insert_any(sz, value);
+                    plain_list.insert_any(sz, value);
+                }
+            }
+        }
+    };
+    auto check = [&] {
+        for (auto& col : columns) {
+            auto name = t->get_column_name(col.indexed);
+            auto plain_name = t->get_column_name(col.plain);
+            for (auto& value : *col.values) {
+                std::vector<Mixed> args{value};
+                CHECK_EQUAL(t->query(util::format("%1 == $0", name), args).count(),
+                            t->query(util::format("%1 == $0", plain_name), args).count());
+            }
+            std::vector<Mixed> args{(*col.values)[0], (*col.values)[1], col.values->back()};
+            CHECK_EQUAL(t->query(util::format("ANY %1 IN {$0, $1, $2}", name), args).count(),
+                        t->query(util::format("ANY %1 IN {$0, $1, $2}", plain_name), args).count());
+        }
+    };
+
+    modify(500);
+    check();
+    t->add_search_index(col_dates);
+    t->add_search_index(col_uuids);
+    t->add_search_index(col_strings);
+    CHECK_EQUAL(t->search_index_type(col_strings), IndexType::General);
+    check();
+    modify(2000);
+    check();
+    t->verify();
+
+    // Only the values of an indexed list are found through the index, not their positions
+    Obj obj = t->create_object();
+    obj.get_list<util::Optional<Int>>(col_ints).add(12345);
+    CHECK_EQUAL(t->query("ints[0] == 12345").count(), 1);
+    CHECK_EQUAL(t->query("ALL ints == 12345").count(), t->query("ALL ints_plain == 12345").count());
+    CHECK_EQUAL(t->query("NONE ints == 12345").count(), t->size() - 1);
+
+    ColKey col_doubles = t->add_column_list(type_Double, "doubles");
+    CHECK_THROW_ANY(t->add_search_index(col_doubles));
+    ColKey col_dictionary = t->add_column_dictionary(type_Int, "dictionary");
+    CHECK_THROW_ANY(t->add_search_index(col_dictionary));
+}
+
 #endif // TEST_INDEX_STRING
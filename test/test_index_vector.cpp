@@ -0,0 +1,317 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include "testsettings.hpp"
+#ifdef TEST_INDEX_VECTOR
+
+#include <realm.hpp>
+#include <realm/history.hpp>
+#include <realm/vector_index.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+#include "test.hpp"
+
+using namespace realm;
+using namespace realm::test_util;
+
+namespace {
+
+using Neighbours = std::vector<std::pair<ObjKey, float>>;
+
+std::vector<float> random_vector(Random& random, size_t dimensions)
+{
+    std::vector<float> vector(dimensions);
+    for (auto& v : vector)
+        v = random.draw_float<float>(-1, 1);
+    return vector;
+}
+
+BinaryData to_binary(const std::vector<float>& vector)
+{
+    return BinaryData(reinterpret_cast<const char*>(vector.data()), vector.size() * sizeof(float));
+}
+
+// The exact nearest neighbours, found without the index
+Neighbours exact_nearest(const Query& query, ColKey col, const std::vector<float>& vector, size_t k,
+                         VectorMetric metric = VectorMetric::L2)
+{
+    Neighbours result;
+    for (auto key : query.find_all_keys().to_vector()) {
+        BinaryData data = query.get_table()->get_object(key).get<BinaryData>(col);
+        if (data.size() != vector.size() * sizeof(float))
+            continue;
+        std::vector<float> values(vector.size());
+        std::memcpy(values.data(), data.data(), data.size());
+        result.emplace_back(key, vector_distance(metric, vector.data(), values.data(), vector.size()));
+    }
+    std::sort(result.begin(), result.end(), [](auto& a, auto& b) {
+        return a.second < b.second || (a.second == b.second && a.first < b.first);
+    });
+    if (result.size() > k)
+        result.resize(k);
+    return result;
+}
+
+// Fraction of the exact neighbours found
+double recall(const Neighbours& found, const Neighbours& exact)
+{
+    if (exact.empty())
+        return 1;
+    size_t hits = 0;
+    for (auto& e : exact) {
+        hits += std::any_of(found.begin(), found.end(), [&](auto& f) {
+            return f.first == e.first;
+        });
+    }
+    return double(hits) / exact.size();
+}
+
+void check_nearest(unit_test::TestContext& test_context, const Query& query, ColKey col, Random& random,
+                   size_t dimensions, VectorMetric metric = VectorMetric::L2)
+{
+    const size_t k = 10;
+    double total_recall = 0;
+    for (int i = 0; i < 20; ++i) {
+        auto vector = random_vector(random, dimensions);
+        auto found = query.nearest(col, vector, k, metric);
+        auto exact = exact_nearest(query, col, vector, k, metric);
+        CHECK_EQUAL(found.size(), exact.size());
+        CHECK(std::is_sorted(found.begin(), found.end(), [](auto& a, auto& b) {
+            return a.second < b.second;
+        }));
+        for (auto& f : found)
+            CHECK(query.eval_object(query.get_table()->get_object(f.first)));
+        total_recall += recall(found, exact);
+    }
+    CHECK_GREATER(total_recall / 20, 0.9);
+}
+
+} // anonymous namespace
+
+TEST(VectorIndex_Distance)
+{
+    std::vector<float> a{1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+    std::vector<float> b{2, 2, 1, 0, 5, -6, 7, 8, 9, 10, 13};
+    float l2 = 0, dot = 0, norm_a = 0, norm_b = 0;
+    for (size_t i = 0; i < a.size(); ++i) {
+        l2 += (a[i] - b[i]) * (a[i] - b[i]);
+        dot += a[i] * b[i];
+        norm_a += a[i] * a[i];
+        norm_b += b[i] * b[i];
+    }
+    CHECK_APPROXIMATELY_EQUAL(vector_distance(VectorMetric::L2, a.data(), b.data(), a.size()), l2, 1e-5);
+    CHECK_APPROXIMATELY_EQUAL(vector_distance(VectorMetric::Dot, a.data(), b.data(), a.size()), -dot, 1e-5);
+    CHECK_APPROXIMATELY_EQUAL(vector_distance(VectorMetric::Cosine, a.data(), b.data(), a.size()),
+                              1 - dot / std::sqrt(norm_a * norm_b), 1e-5);
+    CHECK_EQUAL(vector_distance(VectorMetric::L2, a.data(), a.data(), a.size()), 0);
+    std::vector<float> zero(a.size(), 0);
+    CHECK_EQUAL(vector_distance(VectorMetric::Cosine, a.data(), zero.data(), a.size()), 1);
+}
+
+TEST(VectorIndex_Nearest)
+{
+    Random random(random_int<unsigned long>());
+    const size_t dimensions = 20;
+    Table table;
+    auto col = table.add_column(type_Binary, "embedding", true);
+    auto col_int = table.add_column(type_Int, "category");
+
+    // Objects created before and after the index is added
+    std::vector<std::vector<float>> vectors;
+    for (int i = 0; i < 3000; ++i) {
+        if (i == 1500)
+            table.add_vector_index(col);
+        vectors.push_back(random_vector(random, dimensions));
+        table.create_object().set(col, to_binary(vectors.back())).set(col_int, i % 10);
+    }
+    // Objects without vectors are not indexed
+    table.create_object();
+    table.create_object().set(col, BinaryData("", 0));
+    CHECK_EQUAL(table.search_index_type(col), IndexType::Vector);
+    CHECK_NOT(table.has_search_index(col));
+    auto index = table.get_vector_index(col);
+    CHECK(index);
+    CHECK_EQUAL(index->get_dimensions(), dimensions);
+    CHECK_EQUAL(index->num_vectors(), 3000);
+    table.verify();
+
+    check_nearest(test_context, table.where(), col, random, dimensions);
+    check_nearest(test_context, table.where().equal(col_int, 3), col, random, dimensions);
+
+    // A stored vector is its own nearest neighbour
+    auto found = table.where().nearest(col, vectors[42], 1);
+    CHECK_EQUAL(found.size(), 1);
+    CHECK_EQUAL(found[0].first, table.get_object(42).get_key());
+    CHECK_EQUAL(found[0].second, 0);
+
+    // Fewer matches than requested
+    auto few = table.where().equal(col_int, 3).less(col_int, 100).nearest(col, vectors[0], 5000);
+    CHECK_EQUAL(few.size(), 300);
+    CHECK_EQUAL(table.where().nearest(col, vectors[0], 5000).size(), 3000);
+    CHECK_EQUAL(table.where().equal(col_int, 42).nearest(col, vectors[0], 10).size(), 0);
+    CHECK_EQUAL(table.where().nearest(col, vectors[0], 0).size(), 0);
+
+    // Vectors of the wrong size
+    auto obj = table.get_object(7);
+    CHECK_THROW(obj.set(col, BinaryData("abcdefg", 7)), InvalidArgument);
+    CHECK_THROW(obj.set(col, to_binary(random_vector(random, dimensions + 1))), InvalidArgument);
+    CHECK_THROW(table.where().nearest(col_int, vectors[0], 1), InvalidArgument);
+    CHECK(obj.get<BinaryData>(col) == to_binary(vectors[7]));
+    CHECK_EQUAL(table.where().nearest(col, random_vector(random, dimensions + 1), 1).size(), 0);
+    CHECK_THROW(table.add_search_index(col_int, IndexType::Vector), IllegalOperation);
+
+    // Another metric uses a new index
+    table.add_vector_index(col, VectorMetric::Cosine);
+    CHECK_EQUAL(table.get_vector_index(col)->get_metric(), VectorMetric::Cosine);
+    CHECK_EQUAL(table.get_vector_index(col)->num_vectors(), 3000);
+    check_nearest(test_context, table.where(), col, random, dimensions, VectorMetric::Cosine);
+    // Searches with other metrics compute all distances
+    check_nearest(test_context, table.where(), col, random, dimensions, VectorMetric::Dot);
+
+    table.remove_search_index(col);
+    CHECK_EQUAL(table.search_index_type(col), IndexType::None);
+    check_nearest(test_context, table.where(), col, random, dimensions);
+}
+
+TEST(VectorIndex_Updates)
+{
+    Random random(random_int<unsigned long>());
+    const size_t dimensions = 8;
+    Table table;
+    auto col = table.add_column(type_Binary, "embedding", true);
+    table.add_vector_index(col, VectorMetric::Dot);
+
+    for (int i = 0; i < 2000; ++i)
+        table.create_object(ObjKey(i)).set(col, to_binary(random_vector(random, dimensions)));
+
+    // Changed and removed vectors
+    for (int i = 0; i < 2000; i += 3)
+        table.get_object(ObjKey(i)).set(col, to_binary(random_vector(random, dimensions)));
+    for (int i = 1; i < 2000; i += 7)
+        table.get_object(ObjKey(i)).set_null(col);
+    for (int i = 2; i < 2000; i += 5)
+        table.remove_object(ObjKey(i));
+    table.verify();
+    check_nearest(test_context, table.where(), col, random, dimensions, VectorMetric::Dot);
+    CHECK_EQUAL(table.get_vector_index(col)->num_vectors(), table.where().not_equal(col, BinaryData()).count());
+
+    // Rebuilt when most nodes are removed
+    for (int i = 0; i < 1800; ++i) {
+        ObjKey key(i);
+        if (table.is_valid(key))
+            table.remove_object(key);
+    }
+    table.verify();
+    check_nearest(test_context, table.where(), col, random, dimensions, VectorMetric::Dot);
+
+    table.clear();
+    CHECK(table.get_vector_index(col)->is_empty());
+    CHECK_EQUAL(table.where().nearest(col, random_vector(random, dimensions), 3, VectorMetric::Dot).size(), 0);
+    table.create_object().set(col, to_binary(random_vector(random, dimensions)));
+    CHECK_EQUAL(table.where().nearest(col, random_vector(random, dimensions), 3, VectorMetric::Dot).size(), 1);
+
+    // The index and its metric are kept when the column changes nullability
+    col = table.set_nullability(col, false, false);
+    CHECK_EQUAL(table.search_index_type(col), IndexType::Vector);
+    CHECK_EQUAL(table.get_vector_index(col)->get_metric(), VectorMetric::Dot);
+    CHECK_EQUAL(table.get_vector_index(col)->num_vectors(), 1);
+    table.create_object();
+    table.verify();
+}
+
+TEST(VectorIndex_List)
+{
+    Random random(random_int<unsigned long>());
+    Table table;
+    auto col = table.add_column_list(type_Float, "embedding");
+    auto col_binary = table.add_column(type_Binary, "binary");
+    for (int i = 0; i < 500; ++i) {
+        auto vector = random_vector(random, 5);
+        auto obj = table.create_object();
+        auto list = obj.get_list<float>(col);
+        for (auto v : vector)
+            list.add(v);
+        obj.set(col_binary, to_binary(vector));
+    }
+    table.create_object().get_list<float>(col).add(1);
+
+    auto vector = random_vector(random, 5);
+    auto found = table.where().nearest(col, vector, 20);
+    auto exact = exact_nearest(table.where(), col_binary, vector, 20);
+    CHECK_EQUAL(found.size(), 20);
+    CHECK(found == exact);
+    CHECK_THROW(table.add_search_index(col, IndexType::Vector), IllegalOperation);
+}
+
+TEST(VectorIndex_Transactions)
+{
+    Random random(random_int<unsigned long>());
+    const size_t dimensions = 16;
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history());
+    DBRef db = DB::create(*hist, path);
+    ColKey col;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("class_Item");
+        col = table->add_column(type_Binary, "embedding", true);
+        table->add_vector_index(col, VectorMetric::Cosine);
+        for (int i = 0; i < 1000; ++i)
+            table->create_object().set(col, to_binary(random_vector(random, dimensions)));
+        wt->commit();
+    }
+    {
+        auto wt = db->start_write();
+        auto table = wt->get_table("class_Item");
+        for (int i = 0; i < 1000; ++i)
+            table->create_object().set(col, to_binary(random_vector(random, dimensions)));
+        table->remove_object(table->begin());
+        wt->rollback();
+    }
+    auto frozen = db->start_frozen();
+    auto table = frozen->get_table("class_Item");
+    CHECK_EQUAL(table->search_index_type(col), IndexType::Vector);
+    CHECK_EQUAL(table->get_vector_index(col)->num_vectors(), 1000);
+    table->verify();
+
+    // Queries run in parallel on the frozen transaction
+    std::vector<std::vector<float>> vectors;
+    std::vector<Neighbours> expected;
+    for (int i = 0; i < 40; ++i) {
+        vectors.push_back(random_vector(random, dimensions));
+        expected.push_back(table->where().nearest(col, vectors.back(), 5, VectorMetric::Cosine));
+    }
+    const int num_threads = 4;
+    std::vector<Neighbours> results[num_threads];
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t] {
+            for (auto& vector : vectors)
+                results[t].push_back(table->where().nearest(col, vector, 5, VectorMetric::Cosine));
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    for (int t = 0; t < num_threads; ++t)
+        CHECK(results[t] == expected);
+}
+
+#endif // TEST_INDEX_VECTOR
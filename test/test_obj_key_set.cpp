@@ -0,0 +1,197 @@
+/*************************************************************************
+ *
+ * Copyright 2024 Realm Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ **************************************************************************/
+
+#include "testsettings.hpp"
+#ifdef TEST_OBJ_KEY_SET
+
+#include <realm.hpp>
+#include <realm/obj_key_set.hpp>
+
+#include <algorithm>
+#include <set>
+
+#include "test.hpp"
+
+using namespace realm;
+using namespace realm::test_util;
+
+namespace {
+
+// Check all operations of 'set' against the keys it should hold
+void check_set(unit_test::TestContext& test_context, const ObjKeySet& set, const std::set<int64_t>& expected)
+{
+    CHECK_EQUAL(set.size(), expected.size());
+    CHECK_EQUAL(set.empty(), expected.empty());
+    std::vector<ObjKey> keys = set.to_vector();
+    CHECK(std::equal(keys.begin(), keys.end(), expected.begin(), expected.end(), [](ObjKey k, int64_t v) {
+        return k.value == v;
+    }));
+    size_t ndx = 0;
+    for (auto v : expected) {
+        if (!CHECK_EQUAL(set.select(ndx).value, v))
+            break;
+        CHECK_EQUAL(set.rank(ObjKey(v)), ndx);
+        CHECK(set.contains(ObjKey(v)));
+        CHECK_EQUAL(set.contains(ObjKey(v + 1)), expected.count(v + 1) == 1);
+        ++ndx;
+    }
+    CHECK_THROW(set.select(expected.size()), OutOfBounds);
+}
+
+// Keys in dense runs, clustered groups and sparse spots, crossing container boundaries
+std::set<int64_t> random_keys(Random& random, size_t runs)
+{
+    std::set<int64_t> keys;
+    for (size_t i = 0; i < runs; ++i) {
+        int64_t start = random.draw_int_mod(int64_t(1) << 20);
+        switch (random.draw_int_mod(3)) {
+            case 0:
+                for (int64_t k = start, end = start + random.draw_int_mod(20000); k < end; ++k)
+                    keys.insert(k);
+                break;
+            case 1:
+                for (int j = 0; j < 3000; ++j)
+                    keys.insert(start + random.draw_int_mod(8000));
+                break;
+            default:
+                keys.insert(start);
+                keys.insert(start + (int64_t(1) << 40));
+                break;
+        }
+    }
+    return keys;
+}
+
+} // anonymous namespace
+
+TEST(ObjKeySet_Basics)
+{
+    ObjKeySet set;
+    check_set(test_context, set, {});
+
+    std::set<int64_t> expected{0, 1, 2, 65535, 65536, 65537, 1000000, int64_t(1) << 40};
+    // Out of order insertion and duplicates
+    for (auto it = expected.rbegin(); it != expected.rend(); ++it) {
+        set.add(ObjKey(*it));
+        set.add(ObjKey(*it));
+    }
+    check_set(test_context, set, expected);
+    CHECK_NOT(set.contains(ObjKey(3)));
+    CHECK_NOT(set.contains(null_key));
+    CHECK_EQUAL(set.rank(ObjKey(3)), 3);
+    CHECK_EQUAL(set.rank(ObjKey(int64_t(1) << 50)), expected.size());
+
+    set.optimize();
+    check_set(test_context, set, expected);
+    set.clear();
+    check_set(test_context, set, {});
+}
+
+TEST(ObjKeySet_Containers)
+{
+    // A range of consecutive keys is stored as runs after optimize()
+    ObjKeySet range;
+    std::set<int64_t> expected;
+    for (int64_t k = 100; k < 300000; ++k) {
+        range.add(ObjKey(k));
+        expected.insert(k);
+    }
+    check_set(test_context, range, expected);
+    size_t bitmap_usage = range.memory_usage();
+    range.optimize();
+    check_set(test_context, range, expected);
+    CHECK_LESS(range.memory_usage(), 1000);
+    CHECK_LESS(range.memory_usage(), bitmap_usage);
+
+    // Adding to a run container
+    range.add(ObjKey(50));
+    range.add(ObjKey(300001));
+    expected.insert(50);
+    expected.insert(300001);
+    check_set(test_context, range, expected);
+
+    // Every other key is a bitmap, one bit per possible key
+    ObjKeySet dense;
+    for (int64_t k = 0; k < 200000; k += 2)
+        dense.add(ObjKey(k));
+    dense.optimize();
+    CHECK_EQUAL(dense.size(), 100000);
+    CHECK_LESS(dense.memory_usage(), 100000 * sizeof(ObjKey) / 16);
+}
+
+TEST(ObjKeySet_SetOperations)
+{
+    Random random(random_int<unsigned long>());
+    for (int iter = 0; iter < 10; ++iter) {
+        auto a_keys = random_keys(random, 20);
+        auto b_keys = random_keys(random, 20);
+        // Give the sets common keys
+        for (auto k : a_keys) {
+            if (random.chance(1, 3))
+                b_keys.insert(k);
+        }
+        ObjKeySet a{std::vector<ObjKey>(a_keys.begin(), a_keys.end())};
+        ObjKeySet b;
+        for (auto k : b_keys)
+            b.add(ObjKey(k));
+        if (iter % 2)
+            a.optimize();
+        if (iter % 3)
+            b.optimize();
+
+        std::set<int64_t> intersection;
+        std::set_intersection(a_keys.begin(), a_keys.end(), b_keys.begin(), b_keys.end(),
+                              std::inserter(intersection, intersection.end()));
+        std::set<int64_t> union_keys(a_keys);
+        union_keys.insert(b_keys.begin(), b_keys.end());
+
+        ObjKeySet c = a;
+        c &= b;
+        check_set(test_context, c, intersection);
+        ObjKeySet d = a;
+        d |= b;
+        check_set(test_context, d, union_keys);
+        d &= a;
+        CHECK(d == a);
+        CHECK(c != d || intersection == a_keys);
+    }
+}
+
+TEST(ObjKeySet_Query)
+{
+    Table table;
+    auto col = table.add_column(type_Int, "int");
+    for (int i = 0; i < 100000; ++i)
+        table.create_object().set(col, i % 10);
+
+    Query q = table.where().less(col, 3);
+    ObjKeySet keys = q.find_all_keys();
+    TableView tv = q.find_all();
+    CHECK_EQUAL(keys.size(), tv.size());
+    for (size_t i = 0; i < tv.size(); ++i)
+        CHECK_EQUAL(keys.select(i), tv.get_key(i));
+    CHECK_EQUAL(q.find_all_keys(100).size(), 100);
+
+    // Intersection and union of query results
+    ObjKeySet odd = table.where().equal(col, 1).find_all_keys();
+    odd |= table.where().equal(col, 3).find_all_keys();
+    odd &= keys;
+    CHECK(odd == table.where().equal(col, 1).find_all_keys());
+}
+
+#endif // TEST_OBJ_KEY_SET
@@ -5638,6 +5638,60 @@ TEST_TYPES(Query_Mixed, std::true_type, std::false_type)
     CHECK_EQUAL(tv.size(), 1);
 }
 
+TEST(Query_MixedTypePartitionedScan)
+{
+    Group g;
+    auto table = g.add_table("Foo");
+    auto col_any = table->add_column(type_Mixed, "value", true);
+
+    std::vector<Mixed> values = {Mixed(),
+                                 Mixed(5),
+                                 Mixed(-7),
+                                 Mixed(int64_t(1) << 40),
+                                 Mixed(-(int64_t(1) << 40)),
+                                 Mixed(5.0),
+                                 Mixed(4.5f),
+                                 Mixed(std::numeric_limits<double>::quiet_NaN()),
+                                 Mixed("5"),
+                                 Mixed("abc"),
+                                 Mixed(true),
+                                 Mixed(Timestamp(5, 0)),
+                                 Mixed(Decimal128("5")),
+                                 Mixed(BinaryData("abc", 3))};
+    for (size_t i = 0; i < 500; i++) {
+        table->create_object().set(col_any, values[(i * 7) % values.size()]);
+    }
+    // Make sure that both narrow and wide type arrays are exercised
+    table->create_object().set(col_any, Mixed(int64_t(1) << 20));
+
+    std::vector<Mixed> targets = {Mixed(),    Mixed(5),  Mixed(-7), Mixed(int64_t(1) << 40), Mixed(4.5), Mixed("5"),
+                                  Mixed(Timestamp(5, 0)), Mixed(true)};
+
+    auto brute_force = [&](auto cond, Mixed target) {
+        size_t count = 0;
+        for (auto& o : *table) {
+            if (cond(QueryValue(o.get<Mixed>(col_any)), QueryValue(target)))
+                count++;
+        }
+        return count;
+    };
+
+    for (auto& target : targets) {
+        CHECK_EQUAL(table->where().equal(col_any, target).count(), brute_force(Equal(), target));
+        CHECK_EQUAL(table->where().not_equal(col_any, target).count(), brute_force(NotEqual(), target));
+        CHECK_EQUAL(table->where().greater(col_any, target).count(), brute_force(Greater(), target));
+        CHECK_EQUAL(table->where().greater_equal(col_any, target).count(), brute_force(GreaterEqual(), target));
+        CHECK_EQUAL(table->where().less(col_any, target).count(), brute_force(Less(), target));
+        CHECK_EQUAL(table->where().less_equal(col_any, target).count(), brute_force(LessEqual(), target));
+    }
+
+    Mixed in_values[] = {Mixed(5), Mixed("abc"), Mixed(int64_t(1) << 40)};
+    size_t expected = brute_force(Equal(), in_values[0]) + brute_force(Equal(), in_values[1]) +
+                      brute_force(Equal(), in_values[2]);
+    CHECK_EQUAL(table->where().in(col_any, std::begin(in_values), std::end(in_values)).count(), expected);
+    CHECK_EQUAL(table->query("value > 4").count(), brute_force(Greater(), Mixed(4)));
+}
+
 TEST(Query_NestedListNull)
 {
     SHARED_GROUP_TEST_PATH(path);
@@ -6375,4 +6429,285 @@ TEST(Query_FullTextPrefix)
     CHECK_EQUAL(q.count(), 1);
 }
 
+TEST(Query_TrigramIndex)
+{
+    Group g;
+    auto table = g.add_table("table");
+    auto col_plain = table->add_column(type_String, "plain", true);
+    auto col_indexed = table->add_column(type_String, "indexed", true);
+    auto col_int = table->add_column(type_Int, "int");
+    CHECK_THROW(table->add_trigram_index(col_int), IllegalOperation);
+
+    Random random(random_int<unsigned long>());
+    auto random_string = [&]() -> util::Optional<std::string> {
+        static const char alphabet[] = "abcABCxX *?\xc3\xa6\xc3\x86";
+        size_t len = random.draw_int_mod(25);
+        if (len == 24)
+            return util::none;
+        std::string str;
+        for (size_t i = 0; i < len; ++i)
+            str += alphabet[random.draw_int_mod(sizeof(alphabet) - 1)];
+        return str;
+    };
+    auto set_string = [&](Obj obj) {
+        auto str = random_string();
+        StringData value = str ? StringData(*str) : StringData();
+        obj.set(col_plain, value).set(col_indexed, value);
+    };
+
+    // Objects existing when the index is created
+    for (int i = 0; i < 1000; ++i)
+        set_string(table->create_object());
+    table->add_trigram_index(col_indexed);
+    CHECK_EQUAL(table->search_index_type(col_indexed), IndexType::Trigram);
+    CHECK_NOT(table->has_search_index(col_indexed));
+
+    // The index follows inserts, updates and removals
+    for (int i = 0; i < 1000; ++i)
+        set_string(table->create_object());
+    for (int i = 0; i < 300; ++i)
+        set_string(table->get_object(random.draw_int_mod(table->size())));
+    for (int i = 0; i < 200; ++i)
+        table->get_object(random.draw_int_mod(table->size())).remove();
+    table->verify();
+
+    auto check_same = [&](const Query& expected, const Query& actual) {
+        auto tv1 = expected.find_all();
+        auto tv2 = actual.find_all();
+        if (!CHECK_EQUAL(tv1.size(), tv2.size()))
+            return;
+        for (size_t i = 0; i < tv1.size(); ++i)
+            CHECK_EQUAL(tv1.get_key(i), tv2.get_key(i));
+        CHECK_EQUAL(expected.count(), actual.count());
+    };
+    StringData patterns[] = {"abc", "ABC", "xxx", "bca", "ab", "c x", "aBcA", "\xc3\xa6" "ab", "\xc3\x86" "ab", ""};
+    StringData like_patterns[] = {"*abc*", "abc*", "*x?a*", "a*bcx*", "?*", "*aaa", "*\xc3\xa6" "b*", "abc"};
+    for (auto pattern : patterns) {
+        for (bool case_sensitive : {true, false}) {
+            check_same(table->where().contains(col_plain, pattern, case_sensitive),
+                       table->where().contains(col_indexed, pattern, case_sensitive));
+            check_same(table->where().contains(col_plain, pattern, case_sensitive).greater(col_int, -1),
+                       table->where().greater(col_int, -1).contains(col_indexed, pattern, case_sensitive));
+        }
+        std::vector<Mixed> args{pattern};
+        check_same(table->query("plain CONTAINS $0", args), table->query("indexed CONTAINS $0", args));
+        check_same(table->query("plain CONTAINS[c] $0", args), table->query("indexed CONTAINS[c] $0", args));
+    }
+    for (auto pattern : like_patterns) {
+        for (bool case_sensitive : {true, false}) {
+            check_same(table->where().like(col_plain, pattern, case_sensitive),
+                       table->where().like(col_indexed, pattern, case_sensitive));
+        }
+        std::vector<Mixed> args{pattern};
+        check_same(table->query("plain LIKE $0", args), table->query("indexed LIKE $0", args));
+        check_same(table->query("plain LIKE[c] $0", args), table->query("indexed LIKE[c] $0", args));
+    }
+    check_same(table->where().contains(col_plain, StringData()), table->where().contains(col_indexed, StringData()));
+
+    // Equality doesn't use the trigram index
+    StringData value = table->get_object(0).get<String>(col_plain);
+    CHECK_EQUAL(table->count_string(col_indexed, value), table->count_string(col_plain, value));
+
+    // Replacing the index
+    table->add_search_index(col_indexed);
+    CHECK_EQUAL(table->search_index_type(col_indexed), IndexType::General);
+    check_same(table->where().contains(col_plain, patterns[0]), table->where().contains(col_indexed, patterns[0]));
+    table->add_trigram_index(col_indexed);
+    table->remove_search_index(col_indexed);
+    CHECK_EQUAL(table->search_index_type(col_indexed), IndexType::None);
+}
+
+TEST(Query_GroupBy)
+{
+    Group g;
+    auto customers = g.add_table("customer");
+    auto col_name = customers->add_column(type_String, "name");
+    auto orders = g.add_table("order");
+    auto col_customer = orders->add_column(*customers, "customer");
+    auto col_status = orders->add_column(type_String, "status", true);
+    auto col_amount = orders->add_column(type_Int, "amount", true);
+    auto col_price = orders->add_column(type_Double, "price");
+    auto col_date = orders->add_column(type_Timestamp, "date");
+
+    auto alice = customers->create_object().set(col_name, "Alice").get_key();
+    auto bob = customers->create_object().set(col_name, "Bob").get_key();
+
+    constexpr int64_t day = 24 * 60 * 60;
+    for (int i = 0; i < 1000; i++) {
+        auto obj = orders->create_object();
+        obj.set(col_customer, i % 3 ? alice : bob);
+        if (i % 10)
+            obj.set(col_status, i % 2 ? "open" : "closed");
+        if (i % 5)
+            obj.set(col_amount, i);
+        obj.set(col_price, i * 0.5);
+        obj.set(col_date, Timestamp(i * day / 10, 0));
+    }
+
+    // Reference results computed by queries
+    auto check_group = [&](const GroupByResult& result, Query q, StringData status) {
+        size_t ndx = result.find({status.is_null() ? Mixed() : Mixed(status)});
+        CHECK_NOT_EQUAL(ndx, npos);
+        if (ndx == npos)
+            return;
+        CHECK_EQUAL(result.get_value(ndx, 0), Mixed(int64_t(q.count())));
+        CHECK_EQUAL(result.get_value(ndx, 1), *q.sum(col_amount));
+        CHECK_EQUAL(result.get_value(ndx, 2), *q.min(col_amount));
+        CHECK_EQUAL(result.get_value(ndx, 3), *q.max(col_price));
+        CHECK_EQUAL(result.get_value(ndx, 4), *q.avg(col_amount));
+    };
+    std::vector<GroupByAggregate> aggregates{GroupByAggregate::count(), GroupByAggregate::sum(col_amount),
+                                             GroupByAggregate::min(col_amount), GroupByAggregate::max(col_price),
+                                             GroupByAggregate::avg(col_amount)};
+
+    // Without conditions
+    auto result = orders->where().group_by({col_status}).aggregate(aggregates);
+    CHECK_EQUAL(result.size(), 3);
+    CHECK_EQUAL(result.num_keys(), 1);
+    CHECK_EQUAL(result.num_aggregates(), 5);
+    check_group(result, orders->where().equal(col_status, "open"), "open");
+    check_group(result, orders->where().equal(col_status, "closed"), "closed");
+    check_group(result, orders->where().equal(col_status, null()), StringData());
+
+    // With conditions
+    result = orders->where().greater(col_price, 100.).group_by({col_status}).aggregate(aggregates);
+    CHECK_EQUAL(result.size(), 3);
+    check_group(result, orders->where().greater(col_price, 100.).equal(col_status, "open"), "open");
+    check_group(result, orders->where().greater(col_price, 100.).equal(col_status, null()), StringData());
+
+    // Restricted by a view
+    auto tv = orders->where().less(col_price, 50.).find_all();
+    result = orders->where(&tv).group_by({col_status}).aggregate(aggregates);
+    check_group(result, orders->where().less(col_price, 50.).equal(col_status, "closed"), "closed");
+
+    // Multiple keys including a link
+    result = orders->where().group_by({col_customer, col_status}).aggregate({GroupByAggregate::count()});
+    CHECK_EQUAL(result.size(), 6);
+    size_t ndx = result.find({Mixed(alice), Mixed("open")});
+    CHECK_NOT_EQUAL(ndx, npos);
+    CHECK_EQUAL(result.get_value(ndx).get_int(),
+                orders->where().links_to(col_customer, alice).equal(col_status, "open").count());
+    CHECK_EQUAL(result.find({Mixed(bob), Mixed("pending")}), npos);
+
+    // Timestamps bucketed by day
+    result =
+        orders->where().group_by({GroupByKey::bucketed(col_date, day)}).aggregate({GroupByAggregate::count()});
+    CHECK_EQUAL(result.size(), 100);
+    for (size_t i = 0; i < result.size(); i++) {
+        CHECK_EQUAL(result.get_key(i), Mixed(Timestamp(int64_t(i) * day, 0)));
+        CHECK_EQUAL(result.get_value(i), Mixed(10));
+    }
+    CHECK_THROW(
+        orders->where().group_by({GroupByKey::bucketed(col_price, day)}).aggregate({GroupByAggregate::count()}),
+        IllegalOperation);
+    CHECK_THROW(orders->where().group_by({col_status}).aggregate({GroupByAggregate::sum(col_status)}),
+                IllegalOperation);
+
+    // Partial states computed separately can be merged
+    auto q1 = orders->where().less(col_price, 250.);
+    auto q2 = orders->where().greater_equal(col_price, 250.);
+    auto partial = q1.group_by({col_status}).aggregate_partial(aggregates);
+    partial.merge(q2.group_by({col_status}).aggregate_partial(aggregates));
+    result = partial.finalize();
+    CHECK_EQUAL(result.size(), 3);
+    check_group(result, orders->where().equal(col_status, "open"), "open");
+    check_group(result, orders->where().equal(col_status, null()), StringData());
+}
+
+TEST(Query_ResultCache)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    auto hist = make_in_realm_history();
+    DBOptions options;
+    options.query_cache_size = 64 * 1024;
+    DBRef db = DB::create(*hist, path, options);
+    auto cache = db->get_query_cache();
+    CHECK(cache);
+
+    ColKey col_value, col_other;
+    {
+        auto wt = db->start_write();
+        auto table = wt->add_table("table");
+        col_value = table->add_column(type_Int, "value");
+        auto other = wt->add_table("other");
+        col_other = other->add_column(type_Int, "value");
+        for (int i = 0; i < 100; i++)
+            table->create_object().set(col_value, i);
+        // Queries in write transactions bypass the cache
+        CHECK_EQUAL(table->where().greater(col_value, 50).count(), 49);
+        wt->commit();
+    }
+    CHECK_EQUAL(cache->get_stats().entries, 0);
+
+    auto rt = db->start_read();
+    auto query = rt->get_table("table")->where().greater(col_value, 50);
+    CHECK_EQUAL(query.count(), 49);
+    CHECK_EQUAL(query.count(), 49);
+    CHECK_EQUAL(cache->get_stats().hits, 1);
+
+    ObjKey min_key;
+    CHECK_EQUAL(*query.sum(col_value), Mixed(3675));
+    CHECK_EQUAL(*query.min(col_value), Mixed(51));
+    CHECK_EQUAL(*query.min(col_value, &min_key), Mixed(51));
+    CHECK_EQUAL(rt->get_table("table")->get_object(min_key).get<Int>(col_value), 51);
+    size_t value_count = 0;
+    CHECK_EQUAL(*query.avg(col_value, &value_count), Mixed(75.0));
+    CHECK_EQUAL(*query.avg(col_value, &value_count), Mixed(75.0));
+    CHECK_EQUAL(value_count, 49);
+    auto tv = query.find_all();
+    CHECK_EQUAL(query.find_all().size(), 49);
+    CHECK_EQUAL(cache->get_stats().hits, 4);
+
+    // A different argument is a different query
+    CHECK_EQUAL(rt->get_table("table")->where().greater(col_value, 60).count(), 39);
+    CHECK_EQUAL(cache->get_stats().hits, 4);
+
+    // Results survive commits to other tables, also from other transactions
+    {
+        auto wt = db->start_write();
+        wt->get_table("other")->create_object().set(col_other, 1);
+        wt->commit();
+    }
+    auto rt2 = db->start_read();
+    auto query2 = rt2->get_table("table")->where().greater(col_value, 50);
+    CHECK_EQUAL(query2.count(), 49);
+    CHECK_EQUAL(cache->get_stats().hits, 5);
+    auto tv2 = query2.find_all();
+    CHECK_EQUAL(tv2.size(), 49);
+    for (size_t i = 0; i < tv.size(); i++)
+        CHECK_EQUAL(tv2.get_key(i), tv.get_key(i));
+
+    // Changing the table invalidates the results
+    {
+        auto wt = db->start_write();
+        wt->get_table("table")->create_object().set(col_value, 1000);
+        wt->commit();
+    }
+    auto rt3 = db->start_read();
+    auto query3 = rt3->get_table("table")->where().greater(col_value, 50);
+    auto hits = cache->get_stats().hits;
+    CHECK_EQUAL(query3.count(), 50);
+    CHECK_EQUAL(*rt3->get_table("table")->where().max(col_value), Mixed(1000));
+    CHECK_EQUAL(cache->get_stats().hits, hits);
+    CHECK_EQUAL(query3.count(), 50);
+    CHECK_EQUAL(cache->get_stats().hits, hits + 1);
+
+    // Earlier snapshots still see their own results
+    CHECK_EQUAL(query.count(), 49);
+    CHECK_EQUAL(rt->freeze()->get_table("table")->where().greater(col_value, 50).count(), 49);
+
+    // Memory use is bounded by the budget
+    for (int64_t i = 0; i < 1000; i++)
+        CHECK_EQUAL(rt3->get_table("table")->where().equal(col_value, i).count(), i < 100 ? 1 : 0);
+    CHECK_LESS_EQUAL(cache->get_stats().memory_used, options.query_cache_size);
+    CHECK_LESS(cache->get_stats().entries, 1000);
+
+    // The read lock held by the cache does not prevent closing
+    rt.reset();
+    rt2.reset();
+    rt3.reset();
+    db->close();
+    CHECK_EQUAL(cache->get_stats().entries, 0);
+}
+
 #endif // TEST_QUERY
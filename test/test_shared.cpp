@@ -539,6 +539,51 @@ TEST(Shared_ReadAfterCompact)
     }
 }
 
+TEST(Shared_BatchedCommitWrites)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::string blob(3000, 'x');
+    {
+        DBOptions options(crypt_key());
+        options.commit_write_mode = DBOptions::CommitWriteMode::BatchedWrite;
+        DBRef sg = DB::create(make_in_realm_history(), path, options);
+        // Another DB instance writing through memory mappings
+        DBRef sg2 = DB::create(make_in_realm_history(), path, DBOptions(crypt_key()));
+        {
+            WriteTransaction wt(sg);
+            auto table = wt.add_table("table");
+            table->add_column(type_Int, "int");
+            table->add_column(type_String, "str");
+            wt.commit();
+        }
+        auto rt = sg2->start_read();
+        for (int i = 0; i < 20; ++i) {
+            // Alternate between small and large commits, and between the two writers
+            WriteTransaction wt(i % 2 ? sg2 : sg);
+            auto table = wt.get_table("table");
+            int n = i % 5 ? 1 : 5000;
+            for (int j = 0; j < n; ++j)
+                table->create_object().set_all(i, StringData(blob.data(), j % 100));
+            if (i % 3 == 0)
+                table->remove_object(table->begin());
+            wt.commit();
+        }
+        rt->advance_read();
+        auto table = rt->get_table("table");
+        CHECK_EQUAL(table->size(), 4 * 5000 + 16 - 7);
+        CHECK_EQUAL(table->where().equal(table->get_column_key("int"), 5).count(), 5000);
+        rt->verify();
+    }
+    {
+        DBRef sg = DB::create(make_in_realm_history(), path, DBOptions(crypt_key()));
+        auto rt = sg->start_read();
+        auto table = rt->get_table("table");
+        CHECK_EQUAL(table->size(), 4 * 5000 + 16 - 7);
+        CHECK_EQUAL(table->where().equal(table->get_column_key("int"), 19).count(), 1);
+        rt->verify();
+    }
+}
+
 TEST(Shared_ReadOverRead)
 {
     SHARED_GROUP_TEST_PATH(path);
@@ -2174,6 +2219,76 @@ TEST(Shared_WaitForChange)
 }
 #endif
 
+TEST(Shared_ChangeNotifier)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    DBRef db = DB::create(path);
+    auto notifier = db->make_change_notifier();
+#if REALM_LINUX || REALM_ANDROID
+    CHECK(notifier);
+#endif
+    if (!notifier)
+        return;
+
+    std::atomic<int> num_wakeups = 0;
+    std::thread thread([&] {
+        while (notifier->wait())
+            ++num_wakeups;
+    });
+    auto wait_for_wakeups = [&](int n) {
+        while (num_wakeups < n)
+            millisleep(1);
+    };
+
+    // A commit through another DB instance wakes up the waiter
+    {
+        DBRef db_2 = DB::create(path);
+        auto tr = db_2->start_write();
+        tr->add_table("table");
+        tr->commit();
+    }
+    wait_for_wakeups(1);
+
+    notifier->notify();
+    wait_for_wakeups(2);
+
+    // wait_for_change() is woken up by commits and by wait_for_change_release()
+    {
+        auto tr = db->start_read();
+        std::thread waiter([&] {
+            CHECK(db->wait_for_change(tr));
+            tr = db->start_read();
+            CHECK_NOT(db->wait_for_change(tr));
+        });
+        {
+            auto wt = db->start_write();
+            wt->get_table("table")->create_object();
+            wt->commit();
+        }
+        wait_for_wakeups(3);
+        db->wait_for_change_release();
+        waiter.join();
+        db->enable_wait_for_change();
+    }
+    wait_for_wakeups(4);
+
+    // The notifier stays usable after the DB which created it is closed
+    db->close();
+    {
+        DBRef db_2 = DB::create(path);
+        auto tr = db_2->start_write();
+        tr->get_table("table")->create_object();
+        tr->commit();
+    }
+    wait_for_wakeups(5);
+
+    notifier->release();
+    thread.join();
+    CHECK_EQUAL(num_wakeups.load(), 5);
+    // Wait returns immediately once released
+    CHECK_NOT(notifier->wait());
+}
+
 TEST(Shared_MultipleSharersOfStreamingFormat)
 {
     SHARED_GROUP_TEST_PATH(path);
@@ -3973,6 +4088,74 @@ TEST(Shared_WriteCopy)
     CHECK_EQUAL(db->start_read()->get_table("foo")->size(), 1);
 }
 
+TEST(Shared_IncrementalBackup)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    SHARED_GROUP_TEST_PATH(backup_path);
+    SHARED_GROUP_TEST_PATH(parallel_backup_path);
+    SHARED_GROUP_TEST_PATH(delta_path);
+    SHARED_GROUP_TEST_PATH(delta2_path);
+
+    DBRef db = DB::create(make_in_realm_history(), path);
+    ColKey col_int, col_str;
+    {
+        auto tr = db->start_write();
+        auto t = tr->add_table("foo");
+        col_int = t->add_column(type_Int, "int");
+        col_str = t->add_column(type_String, "str");
+        for (int i = 0; i < 10000; ++i)
+            t->create_object().set(col_int, i).set(col_str, util::format("value %1", i));
+        tr->commit();
+    }
+
+    auto v1 = db->start_frozen();
+    db->write_backup(*v1, backup_path);
+    db->write_backup(*v1, parallel_backup_path, 4);
+
+    {
+        auto tr = db->start_write();
+        auto t = tr->get_table("foo");
+        for (int i = 0; i < 10000; i += 100)
+            t->get_object(i).set(col_int, -i);
+        t->get_object(5).remove();
+        t->create_object().set(col_int, 12345).set(col_str, "new");
+        tr->add_table("bar")->add_column(type_Int, "x");
+        tr->commit();
+    }
+    auto v2 = db->start_frozen();
+    CHECK_THROW(db->write_backup_delta(*v2, *v1, delta_path), InvalidArgument);
+    db->write_backup_delta(*v1, *v2, delta_path);
+    // The delta must be much smaller than a full backup
+    CHECK_LESS(File::get_size_static(delta_path), File::get_size_static(backup_path) / 2);
+
+    {
+        auto tr = db->start_write();
+        tr->get_table("foo")->clear();
+        tr->commit();
+    }
+    auto v3 = db->start_frozen();
+    db->write_backup_delta(*v2, *v3, delta2_path);
+
+    // Deltas can only be applied in order
+    CHECK_THROW(DB::apply_backup_delta(backup_path, delta2_path), InvalidArgument);
+    CHECK_THROW(DB::apply_backup_delta(backup_path, backup_path), InvalidDatabase);
+
+    auto check_backup = [&](const std::string& backup, const Transaction& expected) {
+        auto backup_db = DB::create(make_in_realm_history(), backup);
+        auto tr = backup_db->start_read();
+        tr->verify();
+        CHECK(*tr == expected);
+    };
+
+    check_backup(parallel_backup_path, *v1);
+    DB::apply_backup_delta(parallel_backup_path, delta_path);
+    check_backup(parallel_backup_path, *v2);
+
+    DB::apply_backup_delta(backup_path, delta_path);
+    DB::apply_backup_delta(backup_path, delta2_path);
+    check_backup(backup_path, *v3);
+}
+
 TEST(Shared_CompareGroups)
 {
     SHARED_GROUP_TEST_PATH(path1);
@@ -5372,4 +5372,73 @@ TEST(Table_LoggingMutations)
     CHECK(str.find("Set 'any' to list") != std::string::npos);
 }
 
+TEST(Table_BinaryBlobHandle)
+{
+    Table table;
+    auto col_bin = table.add_column(type_Binary, "bin", true);
+    auto col_int = table.add_column(type_Int, "int");
+    Obj obj = table.create_object();
+
+    CHECK_THROW(obj.open_blob(col_int), InvalidArgument);
+
+    Blob blob = obj.open_blob(col_bin);
+    CHECK(blob.is_null());
+    CHECK_EQUAL(blob.size(), 0);
+    CHECK_EQUAL(blob.read(0, 10).size(), 0);
+
+    std::string model;
+    auto check_model = [&] {
+        BinaryData value = obj.get<BinaryData>(col_bin);
+        CHECK_EQUAL(value.size(), model.size());
+        CHECK(std::string(value.data(), value.size()) == model);
+        CHECK_EQUAL(blob.size(), model.size());
+    };
+
+    blob.append(BinaryData("hello", 5));
+    model = "hello";
+    CHECK_NOT(blob.is_null());
+    check_model();
+
+    blob.write(1, BinaryData("ELL", 3));
+    model = "hELLo";
+    check_model();
+    BinaryData part = blob.read(1, 3);
+    CHECK_EQUAL(std::string(part.data(), part.size()), "ELL");
+    // Reads are clamped to the size of the value
+    CHECK_EQUAL(blob.read(3, 100).size(), 2);
+
+    // Grow past the small blob limit
+    std::string chunk(100, 'x');
+    blob.write(3, BinaryData(chunk.data(), chunk.size()));
+    model = model.substr(0, 3) + chunk;
+    check_model();
+
+    blob.truncate(50);
+    model.resize(50);
+    check_model();
+
+    // Large value with partial writes
+    std::string large(1000000, '\0');
+    for (size_t i = 0; i < large.size(); ++i)
+        large[i] = char(i % 251);
+    blob.append(BinaryData(large.data(), large.size()));
+    model += large;
+    check_model();
+    blob.write(500000, BinaryData("abcdef", 6));
+    model.replace(500000, 6, "abcdef");
+    check_model();
+    blob.truncate(10);
+    model.resize(10);
+    check_model();
+
+    CHECK_THROW(blob.read(11, 1), OutOfBounds);
+    CHECK_THROW(blob.write(11, BinaryData("a", 1)), OutOfBounds);
+    CHECK_THROW(blob.truncate(11), OutOfBounds);
+
+    // The empty value is not null
+    blob.truncate(0);
+    CHECK_NOT(blob.is_null());
+    CHECK_NOT(obj.get<BinaryData>(col_bin).is_null());
+}
+
 #endif // TEST_TABLE
@@ -1385,6 +1385,55 @@ TEST(TableView_DistinctOverNullLink)
     CHECK_EQUAL(tv.get_object(1).get_linked_object(col_link).get<Int>(col_int), 1);
 }
 
+TEST(TableView_DistinctKeepsOrder)
+{
+    Table t;
+    auto col_str = t.add_column(type_String, "str", true);
+    auto col_double = t.add_column(type_Double, "double");
+    auto col_mixed = t.add_column(type_Mixed, "mixed", true);
+
+    std::vector<ObjKey> keys;
+    auto add = [&](StringData str, double d, Mixed mixed) {
+        keys.push_back(t.create_object().set(col_str, str).set(col_double, d).set(col_mixed, mixed).get_key());
+    };
+    add("b", 0.0, 1);
+    add("a", -0.0, 1.0);
+    add(StringData(), std::nan(""), Decimal128(1));
+    add("b", 0.0, Decimal128("1.00"));
+    add("a", 1.5, "1");
+    add(StringData(), -std::nan(""), Mixed());
+    add("", 1.5, Mixed());
+
+    auto distinct = [&](ColKey col) {
+        auto tv = t.where().find_all();
+        tv.distinct(DistinctDescriptor({{col}}));
+        std::vector<ObjKey> result;
+        for (size_t i = 0; i < tv.size(); ++i)
+            result.push_back(tv.get_key(i));
+        return result;
+    };
+
+    // The first object with each value is kept, in the order of the view
+    CHECK(distinct(col_str) == std::vector<ObjKey>({keys[0], keys[1], keys[2], keys[6]}));
+    CHECK(distinct(col_double) == std::vector<ObjKey>({keys[0], keys[2], keys[4], keys[5]}));
+    CHECK(distinct(col_mixed) == std::vector<ObjKey>({keys[0], keys[4], keys[5]}));
+
+    auto tv = t.where().find_all();
+    tv.distinct(DistinctDescriptor({{col_str}, {col_double}}));
+    CHECK_EQUAL(tv.size(), 6);
+    CHECK_EQUAL(tv.get_key(3), keys[4]);
+
+    // Distinct after sorting keeps the first object in sorted order
+    tv = t.where().find_all();
+    tv.sort(SortDescriptor({{col_double}}, {false}));
+    tv.distinct(DistinctDescriptor({{col_str}}));
+    CHECK_EQUAL(tv.size(), 4);
+    CHECK_EQUAL(tv.get_key(0), keys[4]);
+    CHECK_EQUAL(tv.get_key(1), keys[6]);
+    CHECK_EQUAL(tv.get_key(2), keys[0]);
+    CHECK_EQUAL(tv.get_key(3), keys[5]);
+}
+
 TEST(TableView_IsRowAttachedAfterClear)
 {
     Table t;
@@ -2408,4 +2457,180 @@ TEST(TableView_Filter)
     }
 }
 
+TEST(TableView_SyncAppendedObjects)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    auto repl = make_in_realm_history();
+    DBRef db = DB::create(*repl, path);
+
+    auto wt = db->start_write();
+    auto table = wt->add_table("table");
+    auto col = table->add_column(type_Int, "int");
+    for (int i = 0; i < 1000; ++i)
+        table->create_object().set(col, i % 10);
+    wt->commit_and_continue_as_read();
+
+    auto check_view = [&](TableView& tv, Query q) {
+        tv.sync_if_needed();
+        auto expected = q.find_all();
+        CHECK_EQUAL(tv.size(), expected.size());
+        for (size_t i = 0; i < std::min(tv.size(), expected.size()); ++i)
+            CHECK_EQUAL(tv.get_key(i), expected.get_key(i));
+    };
+
+    Query q = table->where().equal(col, 3);
+    TableView tv = q.find_all();
+    CHECK_EQUAL(tv.size(), 100);
+
+    // Objects appended by another transaction
+    {
+        auto wt2 = db->start_write();
+        auto t = wt2->get_table("table");
+        for (int i = 0; i < 500; ++i)
+            t->create_object().set(col, i % 5);
+        wt2->commit();
+    }
+    wt->advance_read();
+    auto count = table->get_in_place_change_count();
+    CHECK_NOT(tv.is_in_sync());
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 200);
+    CHECK_EQUAL(table->get_in_place_change_count(), count);
+
+    // Appended objects modified in the same transaction
+    wt->promote_to_write();
+    for (int i = 0; i < 10; ++i) {
+        auto obj = table->create_object();
+        obj.set(col, 3);
+        obj.set(col, i == 0 ? 4 : 3);
+    }
+    CHECK_EQUAL(table->get_in_place_change_count(), count);
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 209);
+
+    // Modifying an object already covered by the view forces a full rerun
+    table->get_object(tv.get_key(208)).set(col, 2);
+    CHECK_NOT_EQUAL(table->get_in_place_change_count(), count);
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 208);
+    table->get_object(tv.get_key(0)).set(col, 1);
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 207);
+    table->remove_object(tv.get_key(0));
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 206);
+
+    // Rolled back appends
+    wt->commit_and_continue_as_read();
+    wt->promote_to_write();
+    for (int i = 0; i < 20; ++i)
+        table->create_object().set(col, 3);
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 226);
+    wt->rollback_and_continue_as_read();
+    CHECK_NOT(tv.is_in_sync());
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 206);
+
+    // Modification of old objects by another transaction
+    {
+        auto wt2 = db->start_write();
+        auto t = wt2->get_table("table");
+        t->get_object(tv.get_key(5)).set(col, 0);
+        t->create_object().set(col, 3);
+        wt2->commit();
+    }
+    wt->advance_read();
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 206);
+
+    // Sorted views are always rerun
+    TableView sorted = q.find_all();
+    sorted.sort(col, false);
+    wt->promote_to_write();
+    table->create_object().set(col, 3);
+    sorted.sync_if_needed();
+    CHECK_EQUAL(sorted.size(), 207);
+    check_view(tv, q);
+    CHECK_EQUAL(tv.size(), 207);
+}
+
+TEST(TableView_BatchedKeyResolution)
+{
+    Table table;
+    auto col_int = table.add_column(type_Int, "int", true);
+    auto col_double = table.add_column(type_Double, "double");
+    auto col_order = table.add_column(type_Int, "order");
+
+    // Enough objects for many clusters and several batches, with gaps in the keys
+    Random random(random_int<unsigned long>());
+    for (int i = 0; i < 5000; ++i) {
+        Obj obj = table.create_object(ObjKey(i * 3));
+        if (i % 7)
+            obj.set(col_int, i % 100);
+        obj.set(col_double, i * 0.5);
+        obj.set(col_order, random.draw_int_mod(1000));
+    }
+
+    TableView tv = table.where().find_all();
+    tv.sort(col_order);
+    // Stale keys are skipped
+    for (int i = 0; i < 100; ++i)
+        table.remove_object(tv.get_key(i * 40));
+
+    std::vector<Obj> expected;
+    for (size_t i = 0; i < tv.size(); ++i) {
+        if (Obj obj = tv.get_object(i))
+            expected.push_back(obj);
+    }
+    CHECK_EQUAL(expected.size(), 4900);
+    size_t pos = 0;
+    tv.for_each([&](const Obj& obj) {
+        CHECK(pos < expected.size() && obj.get_key() == expected[pos].get_key());
+        CHECK_EQUAL(obj.get<double>(col_double), expected[pos].get<double>(col_double));
+        ++pos;
+        return IteratorControl::AdvanceToNext;
+    });
+    CHECK_EQUAL(pos, expected.size());
+
+    int64_t sum = 0;
+    size_t non_nulls = 0;
+    size_t count_42 = 0;
+    std::optional<int64_t> max;
+    ObjKey max_key;
+    for (auto& obj : expected) {
+        if (auto v = obj.get<util::Optional<int64_t>>(col_int)) {
+            sum += *v;
+            ++non_nulls;
+            if (*v == 42)
+                ++count_42;
+            if (!max || *v > *max) {
+                max = *v;
+                max_key = obj.get_key();
+            }
+        }
+    }
+    size_t count = 0;
+    CHECK_EQUAL(tv.sum(col_int)->get_int(), sum);
+    CHECK_EQUAL(tv.avg(col_int, &count)->get_double(), double(sum) / non_nulls);
+    CHECK_EQUAL(count, non_nulls);
+    ObjKey return_key;
+    CHECK_EQUAL(tv.max(col_int, &return_key)->get_int(), *max);
+    CHECK_EQUAL(return_key, max_key);
+    CHECK_EQUAL(tv.count_int(col_int, 42), count_42);
+    CHECK_EQUAL(table.where(&tv).greater(col_double, 1000.0).count(),
+                table.where().greater(col_double, 1000.0).count());
+
+    // Null, unresolved and unknown keys give null objects
+    std::vector<ObjKey> keys{ObjKey(9), null_key, ObjKey(3), ObjKey(4), ObjKey(-5), ObjKey(3), ObjKey(1000000)};
+    std::vector<Obj> objects;
+    table.get_objects(keys.data(), keys.size(), objects);
+    CHECK_EQUAL(objects.size(), keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        CHECK_EQUAL(bool(objects[i]), table.is_valid(keys[i]));
+        if (objects[i])
+            CHECK_EQUAL(objects[i].get_key(), keys[i]);
+    }
+}
+
 #endif // TEST_TABLE_VIEW
@@ -544,6 +544,71 @@ TEST(Transactions_Continuous_SerialWrites)
     }
 }
 
+TEST(Transactions_AdvanceReadUnchangedTables)
+{
+    SHARED_GROUP_TEST_PATH(path);
+    std::unique_ptr<Replication> hist(make_in_realm_history());
+    DBRef sg = DB::create(*hist, path);
+
+    const size_t num_tables = 50;
+    std::vector<TableKey> table_keys;
+    {
+        TransactionRef wt = sg->start_write();
+        for (size_t i = 0; i < num_tables; ++i) {
+            auto table = wt->add_table(util::format("class_%1", i));
+            auto col_int = table->add_column(type_Int, "int");
+            auto col_str = table->add_column(type_String, "str");
+            table->add_search_index(col_str);
+            for (int j = 0; j < 10; ++j)
+                table->create_object().set(col_int, j).set(col_str, util::format("str %1", j));
+            table_keys.push_back(table->get_key());
+        }
+        wt->commit();
+    }
+
+    TransactionRef rt = sg->start_read();
+    std::vector<Obj> objs;
+    std::vector<TableView> views;
+    for (auto key : table_keys) {
+        auto table = rt->get_table(key);
+        auto col_int = table->get_column_key("int");
+        objs.push_back(table->get_object(5));
+        views.push_back(table->where().greater(col_int, 2).find_all());
+    }
+
+    {
+        TransactionRef wt = sg->start_write();
+        auto table = wt->get_table(table_keys[3]);
+        table->get_object(5).set("int", 100).set("str", "changed");
+        wt->commit();
+    }
+
+    rt->advance_read();
+    for (size_t i = 0; i < num_tables; ++i) {
+        auto table = rt->get_table(table_keys[i]);
+        auto col_int = table->get_column_key("int");
+        auto col_str = table->get_column_key("str");
+        bool changed = i == 3;
+        CHECK_EQUAL(objs[i].get<Int>(col_int), changed ? 100 : 5);
+        CHECK_EQUAL(table->find_first(col_str, StringData("changed")), changed ? objs[i].get_key() : ObjKey());
+        CHECK_EQUAL(table->find_first(col_str, StringData("str 5")), changed ? ObjKey() : objs[i].get_key());
+        CHECK_EQUAL(views[i].is_in_sync(), !changed);
+    }
+
+    // Rolling back must restore tables modified in the write transaction
+    rt->promote_to_write();
+    auto table = rt->get_table(table_keys[7]);
+    auto col_int = table->get_column_key("int");
+    auto col_str = table->get_column_key("str");
+    table->get_object(5).set(col_int, 200);
+    table->add_column(type_Double, "double");
+    rt->rollback_and_continue_as_read();
+    CHECK_EQUAL(objs[7].get<Int>(col_int), 5);
+    CHECK_EQUAL(table->get_column_count(), 2);
+    CHECK_EQUAL(table->find_first(col_str, StringData("str 5")), objs[7].get_key());
+    CHECK_EQUAL(objs[3].get<Int>("int"), 100);
+}
+
 
 // Check that enumeration is gone after
 // rolling back the insertion of a string enum column
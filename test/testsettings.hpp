@@ -58,6 +58,7 @@
 #define TEST_GROUP
 #define TEST_UPGRADE
 #define TEST_INDEX_STRING
+#define TEST_INDEX_VECTOR
 #define TEST_LANG_BIND_HELPER
 #define TEST_PARSER
 #define TEST_QUERY
@@ -75,6 +76,7 @@
 #define TEST_COLUMN_LARGE
 #define TEST_JSON
 #define TEST_LINKS
+#define TEST_OBJ_KEY_SET
 #define TEST_ENCRYPTED_FILE_MAPPING
 #define TEST_DESTRUCTOR_THREAD_SAFETY
 